@@ -24,7 +24,15 @@
 
 #include "AppDelegate.h"
 #include "controllers/GameController.h"
+#include "controllers/GameServices.h"
+#include "managers/AsyncFileWriter.h"
+#include "managers/JobSystem.h"
+#include "managers/TelemetryManager.h"
+#include "managers/TextureBudgetManager.h"
+#include "views/GameView.h"
 #include "views/LevelSelectView.h" 
+#include "utils/CoreLog.h"
+#include "utils/Profiler.h"
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
 
@@ -42,17 +50,114 @@ using namespace CocosDenshion;
 
 USING_NS_CC;
 
-static cocos2d::Size designResolutionSize = cocos2d::Size(480, 320);
-static cocos2d::Size smallResolutionSize = cocos2d::Size(480, 320);
-static cocos2d::Size mediumResolutionSize = cocos2d::Size(1024, 768);
-static cocos2d::Size largeResolutionSize = cocos2d::Size(2048, 1536);
+// 设计分辨率：竖屏 1080x2080，原始美术资源按此尺寸制作
+static cocos2d::Size designResolutionSize = cocos2d::Size(1080, 2080);
+
+// 资源档位：帧宽度不超过该档位宽度时使用对应的缩小版贴图
+// small/medium 贴图由 tools/gen_resolution_tiers.py 在构建时生成到 Resources/tiers/ 下
+static cocos2d::Size smallResolutionSize = cocos2d::Size(540, 1040);
+static cocos2d::Size mediumResolutionSize = cocos2d::Size(810, 1560);
+static cocos2d::Size largeResolutionSize = cocos2d::Size(1080, 2080);
+
+// 贴图显存预算：超出后在关卡切换时淘汰未被引用的贴图
+static const size_t kTextureBudgetBytes = 48 * 1024 * 1024;
+
+// 任务系统的主线程回调每帧可用的时间预算（毫秒），超出的回调留到下一帧
+static const double kJobContinuationBudgetMs = 2.0;
+
+// 执行主线程回调的调度 key
+static const std::string kJobContinuationKey = "job_continuations";
+
+// 文件写入器的合并窗口与追加文件的 fsync 间隔（毫秒）
+static const uint32_t kFileWriteWindowMs = 50;
+static const int32_t kFileSyncIntervalMs = 1000;
+
+// 遥测文件目录（可写目录下）与后台写入间隔（毫秒）
+static const std::string kTelemetryDirectory = "telemetry/";
+static const uint32_t kTelemetryFlushIntervalMs = 1000;
+
+#if CARDGAME_PROFILER
+// 导出 trace 时包含的最近时长（秒）
+static const double kProfileDumpSeconds = 5.0;
+
+/**
+ * @brief 把最近几秒的计时记录导出到可写目录（trace_<帧号>.json）
+ * @param jobSystem 不为空时在工作线程生成和写入，为空时在当前线程完成（切到后台时进程可能随时被挂起）
+ */
+static void dumpProfileTrace(const std::shared_ptr<JobSystem>& jobSystem) {
+    std::string path = cocos2d::FileUtils::getInstance()->getWritablePath() +
+        cocos2d::StringUtils::format("trace_%u.json", cocos2d::Director::getInstance()->getTotalFrames());
+    if (jobSystem) {
+        jobSystem->submit(JobPriority::LOW, [path]() { Profiler::writeChromeTrace(path, kProfileDumpSeconds); });
+    }
+    else {
+        Profiler::writeChromeTrace(path, kProfileDumpSeconds);
+    }
+}
+#endif
+
+/**
+ * @brief 根据实际帧尺寸选择资源档位
+ * @param frameSize 设备帧尺寸（像素）
+ *
+ * @details
+ * - FIXED_WIDTH 策略下缩放只取决于宽度，因此按帧宽度选择档位
+ * - 选中的档位目录放在搜索路径最前面，根目录作为兜底（字体、关卡 JSON 等非贴图资源）
+ * - ContentScaleFactor = 档位宽度 / 设计宽度，保证缩小的贴图仍按设计尺寸显示
+ *
+ * @note 如果档位贴图没有生成（例如开发机未安装 Pillow），回退到原始资源，避免贴图被放大显示
+ */
+static void selectResolutionTier(const cocos2d::Size& frameSize) {
+    auto director = cocos2d::Director::getInstance();
+    auto fileUtils = cocos2d::FileUtils::getInstance();
+
+    std::string tierDir;
+    cocos2d::Size tierSize = largeResolutionSize;
+    if (frameSize.width <= smallResolutionSize.width) {
+        tierDir = "tiers/small";
+        tierSize = smallResolutionSize;
+    }
+    else if (frameSize.width <= mediumResolutionSize.width) {
+        tierDir = "tiers/medium";
+        tierSize = mediumResolutionSize;
+    }
+
+    // 以底板贴图作为档位是否存在的标记
+    if (!tierDir.empty() && !fileUtils->isFileExist(tierDir + "/card_general.png")) {
+        CCLOG("AppDelegate: resolution tier %s not generated, fallback to full size assets", tierDir.c_str());
+        tierDir.clear();
+        tierSize = largeResolutionSize;
+    }
+
+    std::vector<std::string> searchPaths;
+    if (!tierDir.empty()) {
+        searchPaths.push_back(tierDir);
+    }
+    searchPaths.push_back("");
+    fileUtils->setSearchPaths(searchPaths);
+
+    director->setContentScaleFactor(tierSize.width / designResolutionSize.width);
+    CCLOG("AppDelegate: frame %.0fx%.0f, using %s assets", frameSize.width, frameSize.height,
+        tierDir.empty() ? "full size" : tierDir.c_str());
+}
 
 AppDelegate::AppDelegate()
+    : _services(std::make_shared<GameServices>())
 {
 }
 
 AppDelegate::~AppDelegate() 
 {
+    // 先从服务集合中取下（之后析构的控制器不再使用），
+    // 再等待已排队的任务完成（例如退出前最后一次存档的编码），再让文件写入器把数据全部落盘
+    auto jobSystem = std::move(_services->jobSystem);
+    auto fileWriter = std::move(_services->fileWriter);
+    auto telemetryManager = std::move(_services->telemetryManager);
+    _services->saveChannel = AsyncFileWriter::INVALID_CHANNEL;
+    if (jobSystem) jobSystem->shutdown();
+    if (fileWriter) fileWriter->shutdown();
+    if (telemetryManager) telemetryManager->shutdown();
+
 #if USE_AUDIO_ENGINE
     AudioEngine::end();
 #elif USE_SIMPLE_AUDIO_ENGINE
@@ -85,18 +190,60 @@ bool AppDelegate::applicationDidFinishLaunching() {
     // 创建一个名为 "CardGame" 的窗口
     // 内部逻辑分辨率设为 1080x2080 (竖屏设计)
     // 0.5f 表示在电脑上运行时，窗口缩放为 50% 显示（防止窗口太大超出屏幕）
-        glview = GLViewImpl::createWithRect("CardGame", Rect(0, 0, 1080, 2080), 0.5f);
+        glview = GLViewImpl::createWithRect("CardGame", Rect(0, 0, designResolutionSize.width, designResolutionSize.height), 0.5f);
         director->setOpenGLView(glview);
     }
 
     // 设定设计分辨率为 1080x2080
     // FIXED_WIDTH 策略：保持宽度固定为 1080，高度根据屏幕比例自动缩放
-    glview->setDesignResolutionSize(1080, 2080, ResolutionPolicy::FIXED_WIDTH);
+    glview->setDesignResolutionSize(designResolutionSize.width, designResolutionSize.height, ResolutionPolicy::FIXED_WIDTH);
+
+    // 按实际帧尺寸选择资源档位，低端设备加载缩小版贴图以降低显存占用和上传开销
+    selectResolutionTier(glview->getFrameSize());
+
+    // 核心库（不依赖引擎）的日志转发到 cocos2d::log
+    CoreLog::setHook([](const char* message) { cocos2d::log("%s", message); });
+
+    // 贴图显存预算管理器，所有关卡共享
+    _services->textureBudgetManager = std::make_shared<TextureBudgetManager>(kTextureBudgetBytes);
+
+    // 后台任务系统：固定数量的工作线程，主线程回调每帧由 Scheduler 在时间预算内执行
+    auto jobSystem = std::make_shared<JobSystem>(0);
+    _services->jobSystem = jobSystem;
+    director->getScheduler()->schedule([jobSystem](float) {
+        jobSystem->drainContinuations(kJobContinuationBudgetMs);
+        }, this, 0.0f, false, kJobContinuationKey);
+    CCLOG("AppDelegate: job system with %d workers", (int)jobSystem->workerCount());
+
+    // 磁盘写入集中到一个 IO 线程，主线程和工作线程只把数据交给内存中的通道
+    AsyncFileWriter::Config writerConfig;
+    writerConfig.coalesceWindowMs = kFileWriteWindowMs;
+    writerConfig.syncIntervalMs = kFileSyncIntervalMs;
+    _services->fileWriter = std::make_shared<AsyncFileWriter>(writerConfig);
+    GameController::openSaveChannel(*_services);
+
+    // 分析事件写入环形缓冲，由遥测线程批量写入可写目录下的 telemetry/telemetry_<n>.bin（轮转）
+    TelemetryManager::Config telemetryConfig;
+    telemetryConfig.directory = FileUtils::getInstance()->getWritablePath() + kTelemetryDirectory;
+    telemetryConfig.flushIntervalMs = kTelemetryFlushIntervalMs;
+    FileUtils::getInstance()->createDirectory(telemetryConfig.directory);
+    _services->telemetryManager = std::make_shared<TelemetryManager>(telemetryConfig);
+
+#if CARDGAME_PROFILER
+    // 计时记录：桌面端按 F9 导出最近几秒的 trace（chrome://tracing 或 ui.perfetto.dev 打开）
+    PROFILE_THREAD_NAME("main");
+    auto keyListener = EventListenerKeyboard::create();
+    keyListener->onKeyReleased = [jobSystem](EventKeyboard::KeyCode code, Event*) {
+        if (code == EventKeyboard::KeyCode::KEY_F9) dumpProfileTrace(jobSystem);
+        };
+    director->getEventDispatcher()->addEventListenerWithFixedPriority(keyListener, 1);
+#endif
+
     director->setDisplayStats(false);
     director->setAnimationInterval(1.0f / 60);
 
     // 创建关卡选择场景 (LevelSelectView)
-    auto scene = LevelSelectView::create();
+    auto scene = LevelSelectView::create(_services);
     director->runWithScene(scene);
 
     return true;
@@ -106,6 +253,15 @@ bool AppDelegate::applicationDidFinishLaunching() {
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
 
+    // 切到后台后进程随时可能被系统回收，先保存正在进行的一局（文件在 IO 线程写入）
+    GameController::saveRunningGame(*_services);
+    if (_services->telemetryManager) _services->telemetryManager->requestFlush();
+
+#if CARDGAME_PROFILER
+    // 移动端没有键盘，切到后台时导出一次
+    dumpProfileTrace(nullptr);
+#endif
+
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
 #elif USE_SIMPLE_AUDIO_ENGINE
@@ -125,3 +281,16 @@ void AppDelegate::applicationWillEnterForeground() {
     SimpleAudioEngine::getInstance()->resumeAllEffects();
 #endif
 }
+
+// 移动端屏幕尺寸变化（例如旋转屏幕）时调用；桌面端窗口缩放由 GLViewImpl 直接派发同名事件
+void AppDelegate::applicationScreenSizeChanged(int newWidth, int newHeight) {
+    auto director = Director::getInstance();
+    auto glview = director->getOpenGLView();
+    if (!glview) return;
+
+    glview->setFrameSize(newWidth, newHeight);
+    glview->setDesignResolutionSize(designResolutionSize.width, designResolutionSize.height, ResolutionPolicy::FIXED_WIDTH);
+
+    // GameView 收到后通知 GameController 重新布局
+    director->getEventDispatcher()->dispatchCustomEvent(GameView::EVENT_SCREEN_RESIZED);
+}
@@ -26,6 +26,9 @@
 #define  _APP_DELEGATE_H_
 
 #include "cocos2d.h"
+#include <memory>
+
+struct GameServices;
 
 /**
 @brief    The cocos2d Application.
@@ -58,6 +61,23 @@ public:
     @param  the pointer of the application
     */
     virtual void applicationWillEnterForeground();
+
+    /**
+    @brief  Called when the screen size changes on mobile (e.g. orientation change)
+    @param  newWidth   new frame width in pixels
+    @param  newHeight  new frame height in pixels
+    */
+    virtual void applicationScreenSizeChanged(int newWidth, int newHeight);
+
+    /**
+    @brief  Services shared by every level (the headless entry enables the loopback server through it)
+    */
+    const std::shared_ptr<GameServices>& getServices() const { return _services; }
+
+private:
+    // 跨关卡共享的服务：贴图预算、任务系统、文件写入器（IO 线程）、遥测；
+    // 退出时依次关闭任务系统、文件写入器和遥测，先于引擎关闭
+    std::shared_ptr<GameServices> _services;
 };
 
 #endif // _APP_DELEGATE_H_
@@ -1,45 +1,46 @@
 /**
  * @file LevelConfigLoader.cpp
- * @brief ؿüʵ - Config ĺģ
+ * @brief 关卡配置加载器实现 - Config 层的核心模块
  * 
- * @details ְ
- * 1.  JSON ļȡؿ
- * 2.  JSON ṹתΪ LevelConfig 
- * 3. ṩͳһüؽӿڸ Controller 
+ * @details 职责：
+ * 1. 从 JSON 文件读取关卡配置数据
+ * 2. 解析 JSON 结构并转换为 LevelConfig 对象
+ * 3. 提供统一的配置加载接口给 Controller 层
  * 
- * @note ܹλ
- * -  Config 㣬ֻ"ȡͽ"̬
- * - 漰ҵ߼ʱ
- * - ṩΪ̬״̬
+ * @note 架构定位：
+ * - 属于 Config 层，只负责"读取和解析"静态配置
+ * - 不涉及业务逻辑，不持有运行时数据
+ * - 可以提供为静态方法（无状态服务）
  * 
- * @warning 
- * - ʹ RapidJSON  JSON Cocos2d-x ã
- * - ļ· Resources Ŀ¼
+ * @warning 依赖：
+ * - JSON 解析由 LevelConfigParser 完成（RapidJSON，Cocos2d-x 内置），服务端回放校验共用同一份解析代码
+ * - 文件路径必须存在于 Resources 目录中
  */
 #include "LevelConfigLoader.h"
+#include "configs/loaders/LevelConfigParser.h"
+#include "utils/AllocTracker.h"
+#include "utils/Profiler.h"
 #include "cocos2d.h"
-#include "json/rapidjson.h"
-#include "json/document.h"
 
 using namespace cocos2d;
 
 /**
- * @brief عؿļ̬
- * @param filename ļ· Resources Ŀ¼
- *                 磺"levels/level_1.json"
+ * @brief 加载关卡配置文件（静态方法）
+ * @param filename 配置文件路径，相对于 Resources 目录
+ *                 例如："levels/level_1.json"
  * 
- * @return LevelConfig 󣬰ͱƶѵ
+ * @return LevelConfig 对象，包含主牌区和备用牌堆的配置数据
  * 
- * @details ִ̣
- * 1. **ȡļ**ͨ FileUtils ȡ JSON ַ
- * 2. ** JSON**ʹ RapidJSON ַתΪ Document 
- * 3. **ȡ** "Playfield"  "Stack" 飬ÿſ
- * 4. **ؽ**װΪ LevelConfig ṹ巵
+ * @details 执行流程：
+ * 1. **读取文件**：通过 FileUtils 读取 JSON 字符串
+ * 2. **解析 JSON**：交给 LevelConfigParser（RapidJSON）转换为 Document 对象
+ * 3. **提取数据**：遍历 "Playfield" 和 "Stack" 数组，解析每张卡牌
+ * 4. **返回结果**：封装为 LevelConfig 结构体返回
  * 
- * @note 
- * - ļڣؿյ LevelConfigplayFieldCards  stackCards Ϊգ
- * -  JSON ʧܣͬؿ
- * - ÷Ӧ鷵صǷΪ
+ * @note 错误处理：
+ * - 如果文件不存在，返回空的 LevelConfig（playFieldCards 和 stackCards 为空）
+ * - 如果 JSON 解析失败，同样返回空配置
+ * - 调用方应检查返回的配置是否为空
  * 
  * @example
  * ```cpp
@@ -49,127 +50,33 @@ using namespace cocos2d;
  * }
  * ```
  * 
- * @see LevelConfig - ݽṹ
- * @see CardConfigData - ſ
+ * @see LevelConfig - 配置数据结构定义
+ * @see CardConfigData - 单张卡牌配置数据
  */
 LevelConfig LevelConfigLoader::loadLevelConfig(const std::string& filename) {
+    PROFILE_ZONE("LevelConfigLoader::loadLevelConfig");
+    ALLOC_SCOPE(AllocTag::LOADER);
     LevelConfig config;
 
-    // ========== 1: ȡļ ==========
-    // FileUtils::getInstance()  Cocos2d-x ļ
-    // getStringFromFile() Զ Resources Ŀ¼
+    // ========== 步骤1: 读取文件内容 ==========
+    // FileUtils::getInstance() 是 Cocos2d-x 的文件管理单例
+    // getStringFromFile() 会自动搜索 Resources 目录
     std::string jsonContent = FileUtils::getInstance()->getStringFromFile(filename);
     if (jsonContent.empty()) {
         CCLOG("LevelConfigLoader: Failed to read file %s", filename.c_str());
         return config;
     }
 
-    // ========== 2:  JSON ַ ==========
-    rapidjson::Document doc;
-    doc.Parse(jsonContent.c_str());
-
-    // JSON ﷨⣨ȱٶšŲƥȣ
-    if (doc.HasParseError()) {
+    // ========== 步骤2: 解析 JSON，提取 "Playfield" 和 "Stack" 数组 ==========
+    if (!LevelConfigParser::parse(jsonContent, config)) {
         CCLOG("LevelConfigLoader: Parse error in %s", filename.c_str());
         return config;
     }
 
-    // ========== 3:  "Playfield" 飨ã==========
-    //  JSON Ƿ "Playfield" ֶΣΪ
-    if (doc.HasMember("Playfield") && doc["Playfield"].IsArray()) {
-        const auto& playFieldArray = doc["Playfield"];
-        
-        // еÿԪأÿԪشһſƣ
-        for (const auto& item : playFieldArray.GetArray()) {
-            // øſƵ
-            config.playFieldCards.push_back(parseCardNode(&item));
-        }
-    }
-
-    // ========== 4:  "Stack" 飨ƶã==========
-    //  Playfield ߼ͬ
-    if (doc.HasMember("Stack") && doc["Stack"].IsArray()) {
-        const auto& stackArray = doc["Stack"];
-        for (const auto& item : stackArray.GetArray()) {
-            config.stackCards.push_back(parseCardNode(&item));
-        }
-    }
-
-    // ========== 5: ־ ==========
-    // ¼ɹصĿڵ
+    // ========== 步骤3: 输出加载日志 ==========
+    // 记录成功加载的卡牌数量，便于调试
     CCLOG("LevelConfigLoader: Loaded %s, Playfield: %d, Stack: %d",
         filename.c_str(), (int)config.playFieldCards.size(), (int)config.stackCards.size());
 
     return config;
 }
-
-/**
- * @brief ſƵ JSON ڵ㣨˽и
- * @param jsonValuePtr ָ RapidJSON Value ָ루Ͳͷļ
- * 
- * @return CardConfigData 󣬰Ƶĵɫλ
- * 
- * @details JSON ڵṹʾ
- * ```json
- * {
- *     "CardFace": 12,       // 0=A, 12=Kμ CardFaceType ö٣
- *     "CardSuit": 0,        // ɫ0=÷, 1=, 2=, 3=ң
- *     "Position": {
- *         "x": 250,         // X ꣨Ļϵ½Ϊԭ㣩
- *         "y": 1000         // Y 
- *     }
- * }
- * ```
- * 
- * @note ƿ
- * - ʹ void* ֱӴ rapidjson::Value& ԭ
- *   ͷļа RapidJSONٱ
- * - ֶζṩĬֵֹ JSON ȱֶʱ
- * 
- * @warning 
- * - ָָЧ rapidjson::Value 
- * - ÷ȷָ
- * 
- * @see CardConfigData - ݽṹ
- * @see CardFaceType - öٶ
- * @see CardSuitType - ɫöٶ
- */
-
-CardConfigData LevelConfigLoader::parseCardNode(const void* jsonValuePtr) {
-
-    // ========== ͻԭ ==========
-    //  void* ǿת rapidjson::Value& .cpp 
-    const rapidjson::Value& item = *static_cast<const rapidjson::Value*>(jsonValuePtr);
-    CardConfigData data;
-
-    // ========== ֶ "CardFace" ==========
-    // ֶǷڣʲڵļ쳣
-    if (item.HasMember("CardFace")) {
-        // GetInt() ȡֵȻǿתΪ CardFaceType ö
-        data.face = static_cast<CardFaceType>(item["CardFace"].GetInt());
-    }
-    // ֶβڣʹ CardConfigData 캯ĬֵCFT_NONE
-
-    // ========== ɫֶ "CardSuit" ==========
-    if (item.HasMember("CardSuit")) {
-        data.suit = static_cast<CardSuitType>(item["CardSuit"].GetInt());
-    }
-    // ĬֵCST_NONE
-
-    // ========== λö "Position" ==========
-    // λһǶ׶Ҫ IsObject()
-    if (item.HasMember("Position") && item["Position"].IsObject()) {
-        const auto& posObj = item["Position"];
-
-        // ȡ x ꣬ʹ 0.0f
-        float x = posObj.HasMember("x") ? posObj["x"].GetFloat() : 0.0f;
-
-        // ȡ y ꣬ʹ 0.0f
-        float y = posObj.HasMember("y") ? posObj["y"].GetFloat() : 0.0f;
-
-        //  Cocos2d-x  Vec2 
-        data.position = Vec2(x, y);
-    }
-    // ĬֵVec2(0, 0)
-    return data;
-}
\ No newline at end of file
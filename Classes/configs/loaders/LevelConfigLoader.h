@@ -5,23 +5,17 @@
 #include <string>
 
 /**
- * @brief ̬ü
- * ְ𣺸ȡ JSON ļΪ LevelConfig ṹ
+ * @brief 静态配置加载器
+ * 职责：负责读取 JSON 文件并解析为 LevelConfig 结构体（解析由 LevelConfigParser 完成）
  */
 class LevelConfigLoader {
 public:
     /**
-     * ָؿ
-     * @param filename jsonļ· ( "levels/level_1.json")
-     * @return Ĺؿö
+     * 加载指定关卡的配置
+     * @param filename json文件路径 (例如 "levels/level_1.json")
+     * @return 解析后的关卡配置对象
      */
     static LevelConfig loadLevelConfig(const std::string& filename);
-
-private:
-    // Ƶ JSON 
-    // ʹ void* Ϊ˱ͷļа rapidjson ͷļ
-    //  .cpp ʵлǿתΪ const rapidjson::Value&
-    static CardConfigData parseCardNode(const void* jsonValue);
 };
 
 #endif // LEVEL_CONFIG_LOADER_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef LEVEL_CONFIG_PARSER_H
+#define LEVEL_CONFIG_PARSER_H
+
+#include "configs/models/LevelConfig.h"
+#include <string>
+
+/**
+ * @brief 关卡配置解析器
+ * 职责：把关卡 JSON 文本解析为 LevelConfig 结构体
+ * 特性：无状态，只依赖 RapidJSON 头文件，不依赖引擎（客户端和服务端回放校验共用）
+ *
+ * @note 文件读取由调用方负责：客户端通过 LevelConfigLoader（FileUtils），命令行工具直接读文件
+ */
+class LevelConfigParser {
+public:
+    /**
+     * 解析关卡配置
+     * @param jsonContent JSON 文本
+     * @param config 输出的关卡配置（会被清空后填充）
+     * @return JSON 语法错误时返回 false
+     */
+    static bool parse(const std::string& jsonContent, LevelConfig& config);
+
+private:
+    // 辅助函数：解析单个卡牌的 JSON 对象
+    // 使用 void* 是为了避免在头文件中包含 rapidjson 依赖，保持头文件清洁
+    // 在 .cpp 实现中会强制转换为 const rapidjson::Value&
+    static CardConfigData parseCardNode(const void* jsonValue);
+};
+
+#endif // LEVEL_CONFIG_PARSER_H
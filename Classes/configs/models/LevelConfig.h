@@ -2,14 +2,14 @@
 #define LEVEL_CONFIG_H
 
 #include "configs/GameConsts.h"
-#include "cocos2d.h"
+#include "utils/Vector2.h"
 #include <vector>
 
 struct CardConfigData {
-    // ʹµöֵ CFT_NONE  CST_NONE
+    // 【修正】使用新的枚举值 CFT_NONE 和 CST_NONE
     CardFaceType face = CardFaceType::CFT_NONE;
     CardSuitType suit = CardSuitType::CST_NONE;
-    cocos2d::Vec2 position = cocos2d::Vec2::ZERO;
+    Vector2 position = Vector2::ZERO;
 };
 
 struct LevelConfig {
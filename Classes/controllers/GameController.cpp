@@ -1,19 +1,20 @@
 /**
  * @file GameController.cpp
- * @brief Ϸʵ - MVCܹеĺĿƲ
+ * @brief 游戏控制器实现 - MVC架构中的核心控制层
  * 
- * ְ
- * 1. ЭϷ̵ĳʼ
- * 2. ӿStackController, PlayFieldController
- * 3. ƶ볷ҵ߼
- * 4. ݲ㣨GameModelͼ㣨GameView
+ * 职责：
+ * 1. 协调整个游戏流程的初始化与运行
+ * 2. 管理子控制器（StackController, PlayFieldController）的生命周期
+ * 3. 处理卡牌移动与撤销操作的业务逻辑
+ * 4. 连接数据层（GameModel）与视图层（GameView）
  * 
- * ϵ
- * - УGameModelݣGameViewͼUndoManager˹
- * - StackControllerƶѿPlayFieldController
+ * 依赖关系：
+ * - 持有：GameModel（数据）、GameView（视图）、UndoManager（回退管理器）
+ * - 管理：StackController（备用牌堆控制器）、PlayFieldController（主牌区控制器）
  */
 
 #include "controllers/GameController.h"
+#include "controllers/GameServices.h"
 #include "configs/loaders/LevelConfigLoader.h"
 #include "services/GameModelFromLevelGenerator.h"
 #include "services/GameLogicService.h"
@@ -22,263 +23,1106 @@
 #include "controllers/PlayFieldController.h"
 #include "views/GameView.h"
 #include "managers/UndoManager.h"
+#include "managers/TextureBudgetManager.h"
+#include "managers/AsyncFileWriter.h"
+#include "managers/GameStatePublisher.h"
+#include "managers/InputQueueManager.h"
+#include "managers/JobSystem.h"
+#include "managers/LoopbackServer.h"
+#include "managers/MovePredictor.h"
+#include "managers/ReplayRecorder.h"
+#include "managers/TelemetryManager.h"
+#include "models/GameSnapshot.h"
+#include "models/WorkerResult.h"
+#include "services/GameStateHasher.h"
+#include "services/MoveProtocol.h"
+#include "services/MoveService.h"
+#include "services/ReplayCodec.h"
+#include "services/SnapshotCodec.h"
+#include "services/SnapshotService.h"
+#include "utils/AllocTracker.h"
+#include "utils/MpscQueue.h"
+#include "utils/Profiler.h"
+#include "utils/VectorConvert.h"
 #include "views/CardView.h" 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 
 using namespace cocos2d;
 
-// ****
-// ؿļ·levels/level_<id>.json
+// **常量定义**
+// 关卡配置文件路径规则：levels/level_<id>.json
 const std::string kLevelPathPrefix = "levels/level_";
 const std::string kLevelPathSuffix = ".json";
 
+// 分帧构建新场景时每帧可用的时间预算（毫秒），其余时间留给当前场景的动画
+static const double kSceneBuildBudgetMs = 4.0;
+
+// 分帧构建的调度 key
+static const std::string kSceneBuildKey = "scene_build";
+
+// 每帧最多处理的输入命令数，超出的留到下一帧，保证单帧逻辑开销有上限
+static const size_t kMaxInputCommandsPerFrame = 8;
+
+// 卡牌移动 / 撤销动画的标准时长（秒）
+static const float kMoveDuration = 0.3f;
+
+// 回放文件保存目录（相对于可写目录）与扩展名
+static const std::string kReplayDirectory = "replays/";
+static const std::string kReplayExtension = ".cgr";
+
+// 后台任务结果队列的容量；队列满时新结果被丢弃（只影响日志，不影响文件本身）
+static const size_t kWorkerResultCapacity = 64;
+
+// 存档目录（相对于可写目录）与文件名；只保留一份，即最近一次切到后台时的那一局
+static const std::string kSaveDirectory = "saves/";
+static const std::string kSaveFileName = "resume.sav";
+
+// 存档通道的容量（单个存档的最大字节数，含录制中的回放）
+static const size_t kSaveMaxBytes = 256 * 1024;
+
+// 存档的完整路径
+static std::string getSavePath() {
+    return FileUtils::getInstance()->getWritablePath() + kSaveDirectory + kSaveFileName;
+}
+
+// 串行化存档写入：工作线程有多个，存档通道同一时刻只能有一个写入方（直接写文件时也不能同时写同一个临时文件）
+static std::mutex s_saveWriteMutex;
+
+// 工作线程交给主线程的结果；生产者入队失败时只计数
+static MpscQueue<WorkerResult> s_workerResults(kWorkerResultCapacity);
+static std::atomic<uint64_t> s_droppedWorkerResults(0);
+
+// 提交一条后台任务结果（任意线程）
+static void postWorkerResult(const WorkerResult& result) {
+    if (!s_workerResults.tryPush(result)) {
+        s_droppedWorkerResults.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 写文件（可在任意线程调用）
+ * @param bytes 文件内容
+ * @param path 目标路径
+ * @param atomic 为 true 时先写 path.tmp 再改名，写到一半被中断时旧文件仍然完整
+ */
+static bool writeBytesToFile(const std::vector<uint8_t>& bytes, const std::string& path, bool atomic) {
+    Data data;
+    data.copy(bytes.data(), (ssize_t)bytes.size());
+    auto fileUtils = FileUtils::getInstance();
+    if (!atomic) return fileUtils->writeDataToFile(data, path);
+
+    std::string tempPath = path + ".tmp";
+    return fileUtils->writeDataToFile(data, tempPath) && fileUtils->renameFile(tempPath, path);
+}
+
+bool GameController::s_sceneBuildInProgress = false;
+
 
 /**
- * @brief 캯
- * @details ʼгԱΪָ룬ʹδʼָ
+ * @brief 构造函数
+ * @details 初始化所有成员为空指针，避免使用未初始化的指针
  */
 GameController::GameController()
     : _gameModel(nullptr)
+    , _stateDirty(false)
     , _gameView(nullptr)
     , _stackController(nullptr)
     , _playFieldController(nullptr)
+    , _levelId(0)
+    , _sessionTime(0.0)
+    , _lastMoveTime(0.0)
+    , _replayFed(0)
+    , _replayVerified(0)
+    , _replayRealtime(false)
+    , _sessionId(0)
+    , _pendingScene(nullptr)
+    , _nextBuildStep(0)
+    , _pendingLevelId(0)
+    , _buildFrames(0)
+    , _maxTransitionFrameMs(0.0f)
+    , _sceneSwapped(false)
 {
 }
 
 /**
- * @brief 
- * @details ͷӿüֹڴй©
- * @note ʹ CC_SAFE_RELEASE ȷͷǰָЧ
+ * @brief 析构函数
+ * @details 释放子控制器的引用计数，防止内存泄漏
+ * @note 使用 CC_SAFE_RELEASE 宏确保在释放前检查指针有效性
  */
 GameController::~GameController() {
+    Director::getInstance()->getScheduler()->unscheduleUpdate(this);
+    if (_services->activeController == this) _services->activeController = nullptr;
+    _saveReplay();
+    if (_services->telemetryManager && _telemetryPlay.playId != 0 && _gameModel) {
+        int cardsLeft = MoveService::countPlayFieldCardsLeft(*_gameModel);
+        _services->telemetryManager->recordLevelEnd(_telemetryPlay, cardsLeft == 0 ? LevelOutcome::CLEARED : LevelOutcome::ABANDONED,
+            cardsLeft, (uint32_t)(_sessionTime * 1000.0));
+    }
+    if (_inputQueue) {
+        const auto& stats = _inputQueue->getStats();
+        CCLOG("Input: %llu commands in %llu batches, %llu coalesced, max batch %.3f ms",
+            (unsigned long long)stats.commands, (unsigned long long)stats.batches,
+            (unsigned long long)stats.coalesced, stats.maxBatchMs);
+    }
+    if (_predictor) {
+        const auto& stats = _predictor->getStats();
+        CCLOG("Prediction: %llu predicted, %llu confirmed, %llu rollbacks (%llu moves replayed), max %d pending",
+            (unsigned long long)stats.predicted, (unsigned long long)stats.confirmed,
+            (unsigned long long)stats.rollbacks, (unsigned long long)stats.replayed, (int)stats.maxPending);
+    }
+    if (_statePublisher) {
+        const auto& stats = _statePublisher->getStats();
+        CCLOG("State: %llu versions published, %d buffers, max %d awaiting reclaim",
+            (unsigned long long)stats.published, (int)stats.buffers, (int)stats.maxRetired);
+    }
     CC_SAFE_RELEASE(_stackController);
     CC_SAFE_RELEASE(_playFieldController);
     CCLOG("GameController released");
 }
 
 /**
- * @brief Ϸڣ̬
- * @param levelId ؿIDڼضӦĹؿļ
+ * @brief 注册存档通道
+ * @param services 跨关卡共享的服务
+ *
+ * @details 启动时注册一次（预先分配缓冲），之后每次存档只是一次内存拷贝
+ */
+void GameController::openSaveChannel(GameServices& services) {
+    services.saveChannel = AsyncFileWriter::INVALID_CHANNEL;
+    if (!services.fileWriter) return;
+
+    auto fileUtils = FileUtils::getInstance();
+    fileUtils->createDirectory(fileUtils->getWritablePath() + kSaveDirectory);
+    services.saveChannel = services.fileWriter->openChannel(getSavePath(), FileWriteMode::REPLACE, kSaveMaxBytes);
+    if (services.saveChannel == AsyncFileWriter::INVALID_CHANNEL) {
+        CCLOG("Save: no file writer channel, writing directly");
+    }
+}
+
+/**
+ * @brief 游戏启动入口（静态工厂方法）
+ * @param services 跨关卡共享的服务
+ * @param levelId 关卡ID，用于加载对应的关卡配置文件
+ * 
+ * @note 上一个关卡的场景仍在分帧构建时忽略本次调用（例如连续点击关卡按钮）
+ */
+void GameController::startGame(const std::shared_ptr<GameServices>& services, int levelId) {
+    if (s_sceneBuildInProgress) return;
+    _launch(services, levelId, nullptr, false, nullptr);
+}
+
+/**
+ * @brief 创建控制器并加载关卡
  * 
- * @details ִ̣
- * 1.  GameController ʵԶͷų
- * 2. ֶ retain һΣֹʼбǰͷ
- * 3.  _initWithLevel ʵʳʼ
+ * @details 执行流程：
+ * 1. 创建 GameController 实例并加入自动释放池
+ * 2. 手动 retain 一次，防止初始化过程中被提前释放
+ * 3. 记下服务与回放，调用 _initWithLevel 完成实际初始化
  * 
- * @note ׶ιģʽ + init Cocos2d-x ı׼
+ * @note 采用两阶段构造模式（构造 + init）是 Cocos2d-x 的标准做法
  */
-void GameController::startGame(int levelId) {
-    // ʹ new (std::nothrow) ʧʱ׳쳣
+void GameController::_launch(const std::shared_ptr<GameServices>& services, int levelId,
+    std::shared_ptr<ReplayData> replay, bool realtime, std::shared_ptr<GameSnapshot> snapshot) {
+    // 使用 new (std::nothrow) 避免分配失败时抛出异常
     GameController* controller = new (std::nothrow) GameController();
     if (controller) {
         controller->autorelease();
-        controller->retain(); // ãֱʼ
-        controller->_initWithLevel(levelId);
+        controller->retain(); // 保持引用，直到初始化完成
+        controller->_services = services;
+        controller->_replay = replay;
+        controller->_replayRealtime = realtime;
+        // 回放从关卡初始状态开始，不使用存档
+        controller->_initWithLevel(levelId, replay ? nullptr : snapshot);
+    }
+}
+
+
+/**
+ * @brief 加载回放中的关卡并自动播放
+ * @param services 跨关卡共享的服务，结果写入 services->replayState
+ * @param replay 回放数据
+ * @param realtime 是否按录制时的时间戳播放
+ * @return 是否开始播放
+ */
+bool GameController::startReplay(const std::shared_ptr<GameServices>& services, const ReplayData& replay, bool realtime) {
+    if (s_sceneBuildInProgress) return false;
+
+    services->replayState = ReplayState::PLAYING;
+    _launch(services, (int)replay.levelId, std::make_shared<ReplayData>(replay), realtime, nullptr);
+    return true;
+}
+
+/**
+ * @brief 保存正在进行的一局
+ * @param services 跨关卡共享的服务
+ *
+ * @details 主线程只编码录制中的回放（录制器只在主线程访问）；模型部分由工作线程从状态发布器读取，
+ *          与编码、文件写入一起在任务系统中完成。
+ *          新的存档会取消尚未开始写入的旧存档，避免连续切换前后台时重复写文件
+ */
+void GameController::saveRunningGame(GameServices& services) {
+    GameController* controller = services.activeController;
+    if (!controller || !controller->_statePublisher || controller->_replay) return;
+
+    // ========== 主线程：发布最新状态，编码录制中的回放 ==========
+    auto captureStart = std::chrono::steady_clock::now();
+    if (controller->_stateDirty) controller->_publishState();
+    auto publisher = controller->_statePublisher;
+    uint64_t version = publisher->latestVersion();
+    uint32_t sessionTimeMs = (uint32_t)(controller->_sessionTime * 1000.0);
+    auto replay = std::make_shared<std::vector<uint8_t>>();
+    if (controller->_replayRecorder && controller->_replayRecorder->isRecording()) {
+        ReplayCodec::encode(controller->_replayRecorder->getReplay(), *replay);
+    }
+    double captureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - captureStart).count();
+
+    // ========== 工作线程：读取发布的状态，编码后写临时文件再改名 ==========
+    auto fileUtils = FileUtils::getInstance();
+    fileUtils->createDirectory(fileUtils->getWritablePath() + kSaveDirectory);
+    std::string path = getSavePath();
+    int levelId = controller->_levelId;
+    CCLOG("Save: level %d state v%llu captured in %.3f ms", levelId, (unsigned long long)version, captureMs);
+
+    if (services.saveToken) services.saveToken->cancel();
+    auto token = std::make_shared<JobToken>();
+    services.saveToken = token;
+
+    // 有文件写入器时交给它的 IO 线程落盘（立即唤醒，不等合并窗口）；结果经无锁队列交给主线程，由 update 统一处理
+    auto writer = services.saveChannel != AsyncFileWriter::INVALID_CHANNEL ? services.fileWriter : nullptr;
+    int32_t channel = services.saveChannel;
+    auto work = [publisher, version, sessionTimeMs, replay, path, token, levelId, writer, channel]() {
+        WorkerResult result;
+        result.levelId = levelId;
+        result.stateVersion = version;
+
+        GameSnapshot snapshot;
+        {
+            // 回放与状态必须对应同一时刻：存档之后又发布了新状态（玩家继续操作）时放弃，由下一次存档覆盖
+            GameStatePublisher::ReadGuard state(*publisher);
+            if (!state || state->version != version) {
+                result.type = WorkerResultType::SAVE_STALE;
+                postWorkerResult(result);
+                return;
+            }
+            snapshot = state->snapshot;
+        }
+        snapshot.sessionTimeMs = sessionTimeMs;
+        snapshot.replay.swap(*replay);
+        std::vector<uint8_t> bytes;
+        SnapshotCodec::encode(snapshot, bytes);
+
+        std::lock_guard<std::mutex> lock(s_saveWriteMutex);
+        if (token->isCancelled()) return;
+        if (writer) {
+            bool queued = writer->write(channel, bytes.data(), bytes.size());
+            if (queued) writer->requestFlush();
+            result.type = queued ? WorkerResultType::SAVE_QUEUED : WorkerResultType::SAVE_FAILED;
+        }
+        else {
+            result.type = writeBytesToFile(bytes, path, true) ? WorkerResultType::SAVE_WRITTEN : WorkerResultType::SAVE_FAILED;
+        }
+        result.bytes = (uint32_t)bytes.size();
+        postWorkerResult(result);
+    };
+
+    if (!services.jobSystem || !services.jobSystem->submit(JobPriority::HIGH, work, nullptr, token)) {
+        work();
+    }
+}
+
+/**
+ * @brief 读取存档并继续上次的一局
+ * @param services 跨关卡共享的服务
+ * @return 是否开始加载
+ */
+bool GameController::resumeGame(const std::shared_ptr<GameServices>& services) {
+    if (s_sceneBuildInProgress) return false;
+
+    Data data = FileUtils::getInstance()->getDataFromFile(getSavePath());
+    auto snapshot = std::make_shared<GameSnapshot>();
+    if (data.isNull() || !SnapshotCodec::decode(data.getBytes(), (size_t)data.getSize(), *snapshot)) {
+        CCLOG("Save: no valid save at %s", getSavePath().c_str());
+        return false;
     }
+
+    _launch(services, (int)snapshot->levelId, nullptr, false, snapshot);
+    return true;
 }
 
+/**
+ * @brief 是否存在可以继续的存档
+ */
+bool GameController::hasSavedGame() {
+    return FileUtils::getInstance()->isFileExist(getSavePath());
+}
 
 /**
- * @brief ؿʼ˽зĳʼ߼
- * @param levelId ؿID
+ * @brief 关卡初始化私有方法（核心初始化逻辑）
+ * @param levelId 关卡ID
+ * @param snapshot 加载后写入的存档（可为空）
  * 
- * @details ִ̣ϸ MVC ܹ
- * 1. **ؾ̬** -  JSON ļȡؿݣConfig 㣩
- * 2. **ʱ** - תΪ GameModelService 㣩
- * 3. **ʼ** -  UndoManager ߼Manager 㣩
- * 4. **ʼӿ** -  StackController  PlayFieldController
- * 5. **ͼ** -  Scene  GameViewͼװ
- * 6. **ͼݰ** - ӿ initView ɿƾ
- * 7. **л** - ϷΪǰг
+ * @details 执行流程（严格按照 MVC 架构）：
+ * 1. **加载静态配置** - 从 JSON 文件读取关卡布局数据（Config 层）
+ * 2. **生成运行时数据** - 将配置转换为 GameModel（Service 层）
+ * 3. **初始化管理器** - 创建 UndoManager 处理撤销逻辑（Manager 层）
+ * 4. **初始化子控制器** - 创建并配置 StackController 和 PlayFieldController
+ * 5. **构建视图层** - 创建 Scene 和 GameView，将视图组装到场景中
+ * 6. **视图与数据绑定** - 调用子控制器的 initView 方法生成卡牌精灵
+ * 7. **切换场景** - 卡牌视图在后续若干帧内分批创建，全部完成后再切换场景
  * 
- * @warning κһʧܶӦжϲ¼־δΪ
+ * @warning 任何一步失败都应该中断并记录日志，避免产生未定义行为
  */
-void GameController::_initWithLevel(int levelId) {
-    // ========== 1: عؿ ==========
-    // ƴļ· "levels/level_1.json"
+void GameController::_initWithLevel(int levelId, std::shared_ptr<GameSnapshot> snapshot) {
+    PROFILE_ZONE("GameController::initWithLevel");
+    _levelId = levelId;
+    _loadAllocStart = AllocTracker::snapshot();
+
+    // ========== 步骤0: 统计上一场景残留的贴图 ==========
+    if (_services->textureBudgetManager) {
+        _services->textureBudgetManager->logReport(StringUtils::format("before level %d", levelId));
+    }
+
+    // ========== 步骤1: 加载关卡配置 ==========
+    // 拼接配置文件路径，例如 "levels/level_1.json"
     std::string path = StringUtils::format("%s%d%s", kLevelPathPrefix.c_str(), levelId, kLevelPathSuffix.c_str());
     LevelConfig config = LevelConfigLoader::loadLevelConfig(path);
 
-    // У飺ûκοݣжϳʼ
+    // 配置校验：如果没有任何卡牌数据，则中断初始化
     if (config.playFieldCards.empty() && config.stackCards.empty()) {
         CCLOG("Error: Level config empty");
+        if (_replay) _failReplay("level config empty");
+        this->release();
         return;
     }
 
-    // ========== 2: Ϸģ ==========
-    //  Service 㽫̬תΪʱ
+    // ========== 步骤2: 生成游戏数据模型 ==========
+    // 调用 Service 层将静态配置转换为运行时数据
     _gameModel = GameModelFromLevelGenerator::generateGameModel(config);
 
-    // ========== 3: ʼ˹ ==========
-    // ʹ shared_ptr  UndoManager ڣManager ֹ
+    // ========== 步骤2.5: 计算屏幕布局 ==========
+    // 主牌区包围盒每个关卡只算一次，之后屏幕尺寸变化时只需重新计算布局
+    _playfieldBounds = LayoutService::computePlayfieldBounds(config);
+    _layout = LayoutService::computeLayout(Director::getInstance()->getVisibleSize(), _playfieldBounds);
+
+    // ========== 步骤3: 初始化回退管理器 ==========
+    // 使用 shared_ptr 管理 UndoManager 生命周期（Manager 层禁止单例）
     _undoManager = std::make_shared<UndoManager>();
 
-    // ========== 4: ʼƶѿ ==========
-    // ҵ߼
+    // ========== 步骤3.2: 读档 ==========
+    // 存档直接写入刚生成的模型和回退历史，不重放操作；失败时按新开局继续
+    bool restored = snapshot && _restoreSnapshot(*snapshot);
+
+    // ========== 步骤3.5: 初始化输入队列 ==========
+    // 触摸回调只压入命令，每帧开始时统一处理（先于所有节点的 update 和动画）
+    _inputQueue = std::make_shared<InputQueueManager>(kMaxInputCommandsPerFrame);
+    Director::getInstance()->getScheduler()->scheduleUpdate(this, Scheduler::PRIORITY_NON_SYSTEM_MIN, false);
+
+    // ========== 步骤4: 初始化备用牌堆控制器 ==========
+    // 负责管理抽牌区域的业务逻辑
     _stackController = StackController::create();
     _stackController->retain();
     _stackController->init(_gameModel, _undoManager, this);
 
-    // ========== 5: ʼ ==========
-    // 濨Ƶĵƥ߼
+    // ========== 步骤5: 初始化主牌区控制器 ==========
+    // 负责管理桌面卡牌的点击与匹配逻辑
     _playFieldController = PlayFieldController::create();
     _playFieldController->retain();
     _playFieldController->init(_gameModel, _undoManager, this);
 
-    // ========== 6: ͼ ==========
-    Scene* scene = Scene::create(); //Cocos2d-x 
-    _gameView = GameView::create(); //ϷͼUIֹ
+    // ========== 步骤6: 创建场景与主视图 ==========
+    Scene* scene = nullptr;
+    {
+        ALLOC_SCOPE(AllocTag::VIEWS);
+        scene = Scene::create(); //Cocos2d-x 场景容器
+        _gameView = GameView::create(); //游戏主视图（UI布局管理器）
+    }
 
     if (_gameView) {
         scene->addChild(_gameView);
-        // Controller󶨵ViewUserObjectڻصз
+        //将 Controller绑定到View的UserObject，便于回调中访问
         _gameView->setUserObject(this);
+        _gameView->applyLayout(_layout);
+
+        // ========== 步骤7: 子控制器初始化各自的视图 ==========
+        // 数据立即就绪，每张卡牌视图的创建登记为一个构建步骤
+        // 读档时数据已经就绪，子控制器只按模型创建视图，不再发牌和摆放
+        if (_stackController) _stackController->initView(_gameView, &_buildSteps, restored);
+        if (_playFieldController) _playFieldController->initView(_gameView, &_buildSteps, restored);
+
+        // ========== 步骤7.2: 回放录制 / 校验初始状态 ==========
+        // 子控制器的 initView 完成了数据层的初始布局（底牌、层级、翻面），此时的状态即为初始状态
+        // 读档时不是初始状态：录制由 _restoreSnapshot 接着存档中的回放继续，存档中没有回放则不录制
+        // 服务端权威模式：发送 JOIN，由服务端核对初始哈希并保存操作记录，本地不录制
+        uint64_t initialHash = _computeStateHash();
+        _statePublisher = std::make_shared<GameStatePublisher>();
+        _publishState();
+        if (_replay) {
+            if (_replay->ruleSet != GameLogicService::RULE_SET_VERSION) _failReplay("rule set mismatch");
+            else if (_replay->initialHash != initialHash) _failReplay("initial state mismatch");
+        }
+        else if (_services->loopbackServer && !restored) {
+            _server = _services->loopbackServer;
+            _server->addLevel((uint32_t)levelId, config);
+            _predictor = std::make_shared<MovePredictor>();
+
+            JoinFrame join;
+            join.levelId = (uint32_t)levelId;
+            join.ruleSet = GameLogicService::RULE_SET_VERSION;
+            join.initialHash = initialHash;
+            _frameBuffer.clear();
+            MoveProtocol::encode(join, _frameBuffer);
+            _server->send(_frameBuffer.data(), _frameBuffer.size());
+        }
+        else if (!restored) {
+            _replayRecorder = std::make_shared<ReplayRecorder>();
+            _replayRecorder->begin((uint32_t)levelId, 0, GameLogicService::RULE_SET_VERSION, initialHash);
+        }
+
+        // ========== 步骤7.3: 遥测：开局 ==========
+        // 回放不是真实的一局，不记录；读档继续的一局使用新的 playId，detail 标记为恢复
+        if (_services->telemetryManager && !_replay) {
+            _telemetryPlay.playId = _services->telemetryManager->newPlayId();
+            _telemetryPlay.levelId = (uint16_t)levelId;
+            _lastMoveTime = _sessionTime;
+            _services->telemetryManager->recordLevelStart(_telemetryPlay, restored);
+        }
+
+        // ========== 步骤7.5: 贴图显存预算 ==========
+        // 旧场景在新场景进入时才被释放，因此在新场景运行后的第一帧再统计与淘汰
+        if (_services->textureBudgetManager) {
+            auto budgetManager = _services->textureBudgetManager;
+            _gameView->scheduleOnce([budgetManager, scene, levelId](float) {
+                budgetManager->trackSceneTextures(scene);
+                budgetManager->enforceBudget();
+                budgetManager->logReport(StringUtils::format("level %d loaded", levelId));
+                }, 0.0f, "texture_budget");
+        }
+    }
+
+    // ========== 步骤8: 分帧构建场景 ==========
+    // 新场景在屏幕外构建，期间当前场景照常运行；构建完成后由 _presentScene 切换
+    _pendingScene = scene;
+    _pendingScene->retain();
+    _pendingLevelId = levelId;
+
+    if (!Director::getInstance()->getRunningScene()) {
+        // 没有正在运行的场景（例如直接启动关卡），无需分帧，直接构建并运行
+        for (auto& step : _buildSteps) step();
+        _buildSteps.clear();
+        _presentScene();
+        _finishSceneBuild();
+        return;
+    }
+
+    // ========== 步骤9: 启动构建调度 ==========
+    // 以 this 为调度目标；_launch 中的 retain 保持到构建结束，由 _finishSceneBuild 释放
+    s_sceneBuildInProgress = true;
+    Director::getInstance()->getScheduler()->schedule(
+        CC_CALLBACK_1(GameController::_buildSceneStep, this), this, 0.0f, false, kSceneBuildKey);
+}
+
+/**
+ * @brief 分帧构建的每帧回调
+ * @param dt 距上一帧的时间（秒），即当前场景在过渡期间的实际帧耗时
+ *
+ * @details 
+ * 1. 记录帧耗时，用于统计过渡期间的最大帧时间
+ * 2. 在时间预算内依次执行构建步骤（每帧至少执行一步，保证进度）
+ * 3. 全部完成后切换场景；下一帧的 dt 覆盖切换帧（含新场景首次渲染），统计后结束
+ */
+void GameController::_buildSceneStep(float dt) {
+    _buildFrames++;
+    _maxTransitionFrameMs = std::max(_maxTransitionFrameMs, dt * 1000.0f);
 
-        // ========== 7: ӿʼԵͼ ==========
-        // ÿӿ𴴽ԼĿƾ
-        if (_stackController) _stackController->initView(_gameView);
-        if (_playFieldController) _playFieldController->initView(_gameView);
+    if (_sceneSwapped) {
+        _finishSceneBuild();
+        return;
+    }
+
+    auto sliceStart = std::chrono::steady_clock::now();
+    while (_nextBuildStep < _buildSteps.size()) {
+        _buildSteps[_nextBuildStep++]();
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sliceStart).count();
+        if (elapsedMs >= kSceneBuildBudgetMs) break;
+    }
+
+    if (_nextBuildStep >= _buildSteps.size()) {
+        _buildSteps.clear();
+        _nextBuildStep = 0;
+        _presentScene();
+        _sceneSwapped = true;
     }
+}
+
+/**
+ * @brief 切换到构建完成的场景
+ * @note 如果已有场景在运行，则替换；否则直接运行
+ */
+void GameController::_presentScene() {
+    if (!_pendingScene) return;
 
-    // ========== 8: лϷ ==========
-    // гУ滻ֱ
     if (Director::getInstance()->getRunningScene()) {
-        Director::getInstance()->replaceScene(scene);
+        Director::getInstance()->replaceScene(_pendingScene);
     }
     else {
-        Director::getInstance()->runWithScene(scene);
+        Director::getInstance()->runWithScene(_pendingScene);
+    }
+    _pendingScene->release();
+    _pendingScene = nullptr;
+    _services->activeController = this;
+}
+
+/**
+ * @brief 结束分帧构建：停止调度、输出过渡统计并释放临时引用
+ */
+void GameController::_finishSceneBuild() {
+    if (s_sceneBuildInProgress) {
+        Director::getInstance()->getScheduler()->unschedule(kSceneBuildKey, this);
+        s_sceneBuildInProgress = false;
+        CCLOG("Scene build: level %d, %d frames, max frame time %.2f ms",
+            _pendingLevelId, _buildFrames, _maxTransitionFrameMs);
+    }
+    if (AllocTracker::isEnabled()) {
+        CCLOG("AllocTracker: level %d load: %s", _levelId,
+            AllocTracker::format(AllocTracker::snapshot() - _loadAllocStart).c_str());
     }
 
-    // ========== 9: ͷʱ ==========
-    // Ӧ startGame е retainƽü
+    // 对应 _launch 中的 retain，平衡引用计数
     this->release();
 }
 
 
 /**
- * @brief ִпƶҵ߼
- * @param card ҪƶĿģ
- * @param targetPos ĿλãͨǵƶѶ
+ * @brief 屏幕尺寸变化后重新布局
+ *
+ * @details 执行流程：
+ * 1. 按新的可见区域计算布局，尺寸未变化时直接返回
+ * 2. 一次遍历换算所有卡牌的位置，并立即同步到视图（打断正在进行的动画）
+ * 3. 换算撤销历史中记录的位置，保证回退后仍落在新布局的对应位置
+ * 4. 通知备用牌堆控制器和主视图更新锚点
+ */
+void GameController::relayout() {
+    PROFILE_ZONE("GameController::relayout");
+    if (!_gameModel || !_gameView) return;
+
+    ScreenLayout oldLayout = _layout;
+    ScreenLayout newLayout = LayoutService::computeLayout(Director::getInstance()->getVisibleSize(), _playfieldBounds);
+    if (newLayout.visibleSize.equals(oldLayout.visibleSize)) return;
+    _layout = newLayout;
+
+    // ========== 卡牌位置 ==========
+    for (auto& card : _gameModel->allCards) {
+        Vec2 newPos = LayoutService::remapPosition(oldLayout, newLayout, toVec2(card->getPosition()));
+        GameLogicService::applyMove(card.get(), toVector2(newPos), card->getZIndex());
+
+        CardView* cv = _gameView->getCardView(card->getId());
+        if (cv) {
+            cv->cancelMoves();
+            cv->setBaseScale(newLayout.cardScale);
+            cv->updateView();
+        }
+    }
+
+    // ========== 撤销历史 ==========
+    if (_undoManager) {
+        _undoManager->remapPositions([&oldLayout, &newLayout](const Vector2& pos) {
+            return toVector2(LayoutService::remapPosition(oldLayout, newLayout, toVec2(pos)));
+            });
+    }
+
+    // ========== 子控制器与视图 ==========
+    if (_stackController) _stackController->applyLayout(newLayout);
+    _gameView->applyLayout(newLayout);
+    _stateDirty = true;
+}
+
+/**
+ * @brief 执行卡牌移动操作（核心业务逻辑）
+ * @param card 要移动的卡牌数据模型
+ * @param targetPos 目标位置（通常是底牌堆顶部）
  * 
- * @details ִ̣
- * 1. ȡǰƶѶƣ¿Ƶ Z ȷ¿ϲ㣩
- * 2.  GameLogicService ¿Ƶ߼ݣλáZ
- * 3.  StackController Ķ
- * 4. ͼҵӦ CardViewִƶ
+ * @details 执行流程：
+ * 1. 调用 MoveService 提交数据变更：记录 Undo、翻到正面、计算新的 Z 序（盖在旧底牌上面）、
+ *    更新位置并设为新的底牌（GameModel::topCardId）
+ * 2. 在视图层找到对应的 CardView，追加一段移动动画（不打断正在播放的段）
  * 
- * @note  MVC ķֲ㣺
- *       - Service 㴦ݸ£״̬
- *       - Controller Э߼ͼ
- *       - View ֻ𶯻
+ * @note 这个方法体现了 MVC 的分层：
+ *       - Service 层处理数据更新（无状态，与回放校验共用同一套规则）
+ *       - Controller 协调逻辑与视图
+ *       - View 层只负责动画表现
  */
 void GameController::performMoveCard(std::shared_ptr<CardModel> card, const cocos2d::Vec2& targetPos) {
-    if (!_stackController) return;
-
-    // ========== ݲ ==========
-    // 1. ȡǰġջơҲǵƶţ
-    auto topCard = _stackController->getTopCard();
-    // 2. 㼶 (Z-Index)
-    // һؼϸڣ·Ʊھ档
-    // оƣƵĲ㼶 = Ʋ㼶 + 1ǵһƣ㼶Ϊ 100
-    int newZ = topCard ? topCard->getZIndex() + 1 : 100;
-
-    // 3. ¿Ƶ
-    //  Service 㣬Ƶ (x, y) ΪĿλãZΪ²㼶
-    // ע⣺һֻǸڴݣĻϵƻû
-    GameLogicService::applyMove(card.get(), targetPos, newZ);
-
-    // 4. Ϸ״̬
-    //  StackControllerµĵˣԺƥ䶼Ҫȡ
-    _stackController->setTopCard(card);
-
-
-    // ========== ͼ ==========
-    // пͼҵӦ CardView ִж
-    //  GameView ӽڵ
-    for (auto child : _gameView->getChildren()) {
-        // ԰ѽڵת CardView
-        CardView* cv = dynamic_cast<CardView*>(child);
-        if (cv && cv->getCardId() == card->getId()) {
-            cv->stopAllActions();  // ȫʩڶȴ
-
-            // ƶ0.3ƶĿλã
-            auto move = MoveTo::create(0.3f, targetPos);
-
-            // ɺĻصZˢʾ
-            auto callback = CallFunc::create([cv, newZ]() {
-                cv->setLocalZOrder(newZ);
-                cv->updateView();
-                });
-
-            // ==========  ==========
-            // Spawn: ͬʱִƶ + ŵЧ
-            // Sequence: ȷŴ 1.2  1.0 ģ""ķ
-            cv->runAction(Sequence::create(
-                Spawn::create(move, Sequence::create(ScaleTo::create(0.15f, 1.2f), ScaleTo::create(0.15f, 1.0f), nullptr), nullptr),
-                callback, nullptr
-            ));
+    PROFILE_ZONE("GameController::performMoveCard");
+    if (!card || !_gameModel || !_undoManager) return;
+
+    // ========== 数据层更新 ==========
+    // 新飞来的牌盖在旧底牌上面（旧层级 + 1；底牌堆为空时为 100），并成为新的底牌，以后匹配都要跟它比。
+    // 注意：这一步只是改了内存里的数据，屏幕上的牌还没动。
+    int newZ = MoveService::moveToTop(*_gameModel, *_undoManager, card.get(), toVector2(targetPos));
+
+
+    // ========== 视图层更新 ==========
+    // 按 ID 找到对应的 CardView，追加一段带回弹的移动动画（0.3秒移动到目标位置）
+    // 数据已经提交，动画只负责表现：这张牌如果还在飞，新的一段排在后面播放，不会被打断或瞬移
+    CardView* cv = _gameView->getCardView(card->getId());
+    if (cv) {
+        cv->enqueueMove(targetPos, newZ, kMoveDuration, true);
+    }
+}
+
+/**
+ * @brief 把一次用户输入压入输入队列
+ * @param type 命令类型
+ * @param cardId 被点击的卡牌ID
+ */
+void GameController::enqueueInput(InputCommandType type, int cardId) {
+    if (!_inputQueue) return;
+    // 回放期间忽略真实输入，保证结果只由回放决定
+    if (_replay) return;
+    _inputQueue->push(InputCommand(type, cardId, Director::getInstance()->getTotalFrames()));
+}
+
+/**
+ * @brief 每帧更新：批量处理输入命令
+ * @param dt 距上一帧的时间（秒）
+ */
+void GameController::update(float dt) {
+    PROFILE_ZONE("GameController::update");
+    _sessionTime += dt;
+    _drainWorkerResults();
+    // 服务端的确认先于本帧的输入处理：回滚之后，本帧的新操作在已确认的状态上预测
+    if (_server) _pollServer();
+    // 回放从场景切换之后开始，保证操作作用在已经显示的场景上
+    if (_replay && !_pendingScene) _feedReplay();
+
+    if (_inputQueue && _inputQueue->size() > 0) {
+        auto batchStart = std::chrono::steady_clock::now();
+        size_t count = _inputQueue->drain(_inputBatch);
+        for (const auto& cmd : _inputBatch) {
+            _executeInput(cmd);
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStart).count();
+        _inputQueue->recordBatch(count, elapsedMs);
+    }
+
+    // 本帧的所有操作合并为一帧发出
+    if (_server) _flushMoveBatch();
+
+    // 本帧的状态变化（可能有多步）合并为一次发布
+    if (_stateDirty) _publishState();
+}
+
+/**
+ * @brief 执行一条输入命令
+ * @param cmd 输入命令
+ *
+ * @details 
+ * - 被接受的命令：正常游戏时连同时间戳和状态哈希录制下来；回放时校验状态哈希
+ * - 被拒绝的命令（例如点数不匹配）不改变状态，不录制；回放中出现则说明与录制时不一致
+ */
+void GameController::_executeInput(const InputCommand& cmd) {
+    ALLOC_REPORT("tap");
+    ALLOC_SCOPE(AllocTag::TAP);
+    if (_server) _predictor->beginMove(*_gameModel, *_undoManager, cmd.type, cmd.cardId);
+    bool accepted = _processInput(cmd);
+    if (accepted) _stateDirty = true;
+
+    if (_replay) {
+        if (_services->replayState != ReplayState::PLAYING) return;
+        if (!accepted) {
+            _failReplay("move rejected");
+            return;
+        }
+        _verifyReplayMove(cmd, _computeStateHash());
+        return;
+    }
+
+    if (!accepted) return;
+    if (_services->telemetryManager && _telemetryPlay.playId != 0) {
+        _telemetryPlay.moveCount++;
+        if (cmd.type == InputCommandType::UNDO) _telemetryPlay.undoCount++;
+        _services->telemetryManager->recordMove(_telemetryPlay, cmd.type, cmd.cardId, (uint32_t)((_sessionTime - _lastMoveTime) * 1000.0));
+        _lastMoveTime = _sessionTime;
+    }
+    uint64_t stateHash = _computeStateHash();
+
+    if (_replayRecorder) {
+        _replayRecorder->record(cmd.type, cmd.cardId, (uint32_t)(_sessionTime * 1000.0), stateHash);
+    }
+
+    // 服务端权威模式：本地已经乐观执行，记下预测结果，操作随本帧的 MOVE_BATCH 发出
+    if (_server) {
+        uint32_t seq = _predictor->commitMove(stateHash);
+        if (_outgoingBatch.moves.empty()) _outgoingBatch.firstSeq = seq;
+        _outgoingBatch.moves.push_back(ProtocolMove(cmd.type, cmd.cardId));
+    }
+}
+
+/**
+ * @brief 把输入命令交给对应的子控制器
+ * @param cmd 输入命令
+ * @return 命令是否被接受
+ *
+ * @details 按命令来源交给对应的子控制器，与原先触摸回调直接调用的路由保持一致
+ */
+bool GameController::_processInput(const InputCommand& cmd) {
+    switch (cmd.type) {
+    case InputCommandType::PLAYFIELD_TAP:
+        return _playFieldController && _playFieldController->handleCardClick(cmd.cardId);
+    case InputCommandType::STACK_TAP:
+        return _stackController && _stackController->handleCardClick(cmd.cardId);
+    case InputCommandType::UNDO:
+        return onUndoClicked();
+    }
+    return false;
+}
+
+/**
+ * @brief 处理服务端发来的帧
+ *
+ * @details 
+ * - JOINED：记录会话；被拒绝（关卡或初始状态不一致）时退出服务端权威模式，按单机继续
+ * - ACK_BATCH：逐条交给 MovePredictor；发生回滚后把视图移回模型中的位置，
+ *   失步时同样同步视图并退出服务端权威模式
+ */
+void GameController::_pollServer() {
+    _server->tick();
+    _incomingFrames.clear();
+    _server->receive(_incomingFrames);
+
+    bool rolledBack = false;
+    bool desynced = false;
+    AckBatchFrame acks;
+    for (const auto& frame : _incomingFrames) {
+        FrameType type;
+        if (!MoveProtocol::peekType(frame.data(), frame.size(), type)) continue;
+
+        if (type == FrameType::JOINED) {
+            JoinedFrame joined;
+            if (!MoveProtocol::decode(frame.data(), frame.size(), joined)) continue;
+            if (joined.sessionId == 0) {
+                CCLOG("Server: join refused for level %d, playing offline", _levelId);
+                desynced = true;
+                break;
+            }
+            _sessionId = joined.sessionId;
+        }
+        else if (type == FrameType::ACK_BATCH) {
+            if (!MoveProtocol::decode(frame.data(), frame.size(), acks) || acks.sessionId != _sessionId) continue;
+            for (size_t i = 0; i < acks.acks.size() && !desynced; ++i) {
+                auto result = _predictor->applyAck(*_gameModel, *_undoManager, acks.firstSeq + (uint32_t)i, acks.acks[i]);
+                if (result == MovePredictor::AckResult::ROLLED_BACK) rolledBack = true;
+                if (result == MovePredictor::AckResult::DESYNC) {
+                    CCLOG("Server: state diverged at move %u, playing offline", acks.firstSeq + (unsigned)i);
+                    rolledBack = true;
+                    desynced = true;
+                }
+            }
+        }
+    }
+
+    if (rolledBack) {
+        _syncCardViews();
+        _stateDirty = true;
+    }
+    if (desynced) {
+        _server = nullptr;
+        _outgoingBatch.moves.clear();
+    }
+}
+
+/**
+ * @brief 把本帧的操作合并为一个 MOVE_BATCH 发出
+ */
+void GameController::_flushMoveBatch() {
+    if (_sessionId == 0 || _outgoingBatch.moves.empty()) return;
+
+    _outgoingBatch.sessionId = _sessionId;
+    _frameBuffer.clear();
+    MoveProtocol::encode(_outgoingBatch, _frameBuffer);
+    _server->send(_frameBuffer.data(), _frameBuffer.size());
+    _outgoingBatch.moves.clear();
+}
+
+/**
+ * @brief 把卡牌视图移到模型中的位置和层级
+ *
+ * @details 只处理与模型不一致或仍在播放动画的视图：打断剩余的动画段，改为一段移回模型位置的动画，
+ *          动画结束时 CardView::updateView 按模型刷新正反面
+ */
+void GameController::_syncCardViews() {
+    if (!_gameView) return;
+
+    for (auto& card : _gameModel->allCards) {
+        CardView* cv = _gameView->getCardView(card->getId());
+        if (!cv) continue;
+
+        Vec2 target = toVec2(card->getPosition());
+        if (cv->isMoving() || !cv->getPosition().equals(target) || cv->getLocalZOrder() != card->getZIndex()) {
+            cv->cancelMoves();
+            cv->enqueueMove(target, card->getZIndex(), kMoveDuration, false);
+        }
+    }
+}
+
+/**
+ * @brief 处理工作线程交回的结果（每帧一次）
+ *
+ * @details 结果记录定长，经无锁队列传递；目前只记录日志，存档和回放文件本身在工作线程已经写完
+ */
+void GameController::_drainWorkerResults() {
+    s_workerResults.drain([](const WorkerResult& result) {
+        switch (result.type) {
+        case WorkerResultType::SAVE_WRITTEN:
+            CCLOG("Save: level %d state v%llu written, %u bytes",
+                result.levelId, (unsigned long long)result.stateVersion, result.bytes);
+            break;
+        case WorkerResultType::SAVE_QUEUED:
+            CCLOG("Save: level %d state v%llu queued for writing, %u bytes",
+                result.levelId, (unsigned long long)result.stateVersion, result.bytes);
+            break;
+        case WorkerResultType::SAVE_STALE:
+            CCLOG("Save: level %d state v%llu superseded, not written",
+                result.levelId, (unsigned long long)result.stateVersion);
             break;
+        case WorkerResultType::SAVE_FAILED:
+            CCLOG("Save: level %d failed to write", result.levelId);
+            break;
+        case WorkerResultType::REPLAY_WRITTEN:
+            CCLOG("Replay: level %d saved %u moves (%u bytes)", result.levelId, result.moves, result.bytes);
+            break;
+        case WorkerResultType::REPLAY_FAILED:
+            CCLOG("Replay: level %d failed to write", result.levelId);
+            break;
+        }
+        });
+
+    uint64_t dropped = s_droppedWorkerResults.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) CCLOG("Worker results: %llu dropped (queue full)", (unsigned long long)dropped);
+}
+
+/**
+ * @brief 计算当前的游戏状态哈希
+ * @return GameStateHasher 的 64 位哈希
+ */
+uint64_t GameController::_computeStateHash() const {
+    if (!_gameModel) return 0;
+    return GameStateHasher::hash(*_gameModel, _undoManager ? _undoManager->size() : 0);
+}
+
+/**
+ * @brief 每帧推进回放
+ *
+ * @details 
+ * - 实时模式：下一步的时间戳已到、且输入队列已空时放入一步；
+ *   走与真实触摸相同的输入队列，队列里同一时刻只有一条回放命令，不会被合并
+ * - 快速模式：直接依次执行剩余的全部操作，不经过队列的每帧上限
+ */
+void GameController::_feedReplay() {
+    if (_services->replayState != ReplayState::PLAYING) return;
+    const auto& moves = _replay->moves;
+
+    if (_replayRealtime) {
+        uint32_t nowMs = (uint32_t)(_sessionTime * 1000.0);
+        if (_replayFed < moves.size() && moves[_replayFed].timeMs <= nowMs && _inputQueue->size() == 0) {
+            const ReplayMove& move = moves[_replayFed++];
+            _inputQueue->push(InputCommand(move.type, move.cardId, Director::getInstance()->getTotalFrames()));
+        }
+    }
+    else {
+        while (_services->replayState == ReplayState::PLAYING && _replayFed < moves.size()) {
+            const ReplayMove& move = moves[_replayFed++];
+            _executeInput(InputCommand(move.type, move.cardId, Director::getInstance()->getTotalFrames()));
+        }
+    }
+
+    // 没有操作的回放：初始状态校验通过即可结束
+    if (moves.empty()) _verifyReplayMove(InputCommand(), _computeStateHash());
+}
+
+/**
+ * @brief 校验刚执行完的一步回放操作
+ * @param cmd 已执行的命令
+ * @param stateHash 执行后的状态哈希
+ *
+ * @details 每一步比较命令本身和哈希的低 32 位；最后一步之后再比较完整的 64 位最终哈希
+ */
+void GameController::_verifyReplayMove(const InputCommand& cmd, uint64_t stateHash) {
+    const auto& moves = _replay->moves;
+    if (_replayVerified < moves.size()) {
+        const ReplayMove& expected = moves[_replayVerified];
+        if (expected.type != cmd.type || expected.cardId != cmd.cardId) {
+            _failReplay("command mismatch");
+            return;
         }
+        if (expected.stateHash != (uint32_t)stateHash) {
+            _failReplay("state hash mismatch");
+            return;
+        }
+        _replayVerified++;
+    }
+
+    if (_replayVerified == moves.size()) {
+        if (_replay->finalHash != stateHash) {
+            _failReplay("final hash mismatch");
+            return;
+        }
+        _services->replayState = ReplayState::PASSED;
+        CCLOG("Replay: level %d passed, %d moves verified", _levelId, (int)moves.size());
     }
 }
 
 /**
- * @brief Undo ťص
+ * @brief 回放失败
+ * @param reason 失败原因
+ */
+void GameController::_failReplay(const char* reason) {
+    _services->replayState = ReplayState::FAILED;
+    CCLOG("Replay: level %d failed at move %d/%d: %s",
+        _levelId, (int)_replayVerified, _replay ? (int)_replay->moves.size() : 0, reason);
+}
+
+/**
+ * @brief 结束录制并保存回放
+ *
+ * @details 没有任何操作的一局不保存；写入失败只记录日志，不影响退出流程
+ */
+void GameController::_saveReplay() {
+    if (!_replayRecorder || !_replayRecorder->isRecording() || _replayRecorder->moveCount() == 0) return;
+
+    std::vector<uint8_t> bytes;
+    _replayRecorder->finish(_computeStateHash(), bytes);
+
+    auto fileUtils = FileUtils::getInstance();
+    std::string dir = fileUtils->getWritablePath() + kReplayDirectory;
+    fileUtils->createDirectory(dir);
+    std::string path = StringUtils::format("%slevel_%d%s", dir.c_str(), _levelId, kReplayExtension.c_str());
+
+    // 控制器析构时调用，写入交给工作线程，不阻塞关卡切换
+    auto data = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+    int moveCount = (int)_replayRecorder->moveCount();
+    int levelId = _levelId;
+    auto work = [data, path, moveCount, levelId]() {
+        WorkerResult result;
+        result.type = writeBytesToFile(*data, path, false) ? WorkerResultType::REPLAY_WRITTEN : WorkerResultType::REPLAY_FAILED;
+        result.levelId = levelId;
+        result.bytes = (uint32_t)data->size();
+        result.moves = (uint32_t)moveCount;
+        postWorkerResult(result);
+    };
+    if (!_services->jobSystem || !_services->jobSystem->submit(JobPriority::NORMAL, work)) {
+        work();
+    }
+}
+
+/**
+ * @brief 发布当前状态
+ *
+ * @details 模型部分由 SnapshotService 采集到发布器复用的缓冲中；补充关卡、规则版本、布局尺寸和状态哈希。
+ *          已用时间和回放属于会话状态，不随每次操作发布，由 saveRunningGame 单独采集
+ */
+void GameController::_publishState() {
+    if (!_statePublisher || !_gameModel || !_undoManager) return;
+
+    PublishedGameState& state = _statePublisher->beginPublish();
+    SnapshotService::capture(*_gameModel, *_undoManager, state.snapshot);
+    state.snapshot.levelId = (uint32_t)_levelId;
+    state.snapshot.ruleSet = GameLogicService::RULE_SET_VERSION;
+    state.snapshot.layoutWidth = _layout.visibleSize.width;
+    state.snapshot.layoutHeight = _layout.visibleSize.height;
+    state.snapshot.sessionTimeMs = 0;
+    state.snapshot.replay.clear();
+    state.stateHash = _computeStateHash();
+    _statePublisher->commitPublish();
+    _stateDirty = false;
+}
+
+/**
+ * @brief 把存档写入刚生成的模型
+ * @param snapshot 存档数据
+ * @return 是否读档成功
+ *
+ * @details 执行流程：
+ * 1. 校验关卡和规则版本，由 SnapshotService 直接写入卡牌状态、备用堆顺序和回退历史
+ * 2. 屏幕尺寸与存档时不同：按存档时的尺寸重算旧布局，把所有位置换算到当前布局
+ * 3. 恢复已用时间，接着存档中的回放继续录制
+ */
+bool GameController::_restoreSnapshot(const GameSnapshot& snapshot) {
+    auto restoreStart = std::chrono::steady_clock::now();
+
+    // ========== 步骤1: 写入模型 ==========
+    if (snapshot.levelId != (uint32_t)_levelId || snapshot.ruleSet != GameLogicService::RULE_SET_VERSION) {
+        CCLOG("Save: snapshot is for level %u rule set %u, ignored", snapshot.levelId, (unsigned)snapshot.ruleSet);
+        return false;
+    }
+    if (!SnapshotService::restore(snapshot, *_gameModel, *_undoManager)) {
+        CCLOG("Save: snapshot does not match level %d, ignored", _levelId);
+        return false;
+    }
+
+    // ========== 步骤2: 换算到当前布局 ==========
+    Size savedSize(snapshot.layoutWidth, snapshot.layoutHeight);
+    if (!savedSize.equals(_layout.visibleSize)) {
+        ScreenLayout savedLayout = LayoutService::computeLayout(savedSize, _playfieldBounds);
+        const ScreenLayout& layout = _layout;
+        for (auto& card : _gameModel->allCards) {
+            Vec2 newPos = LayoutService::remapPosition(savedLayout, layout, toVec2(card->getPosition()));
+            GameLogicService::applyMove(card.get(), toVector2(newPos), card->getZIndex());
+        }
+        _undoManager->remapPositions([&savedLayout, &layout](const Vector2& pos) {
+            return toVector2(LayoutService::remapPosition(savedLayout, layout, toVec2(pos)));
+            });
+    }
+
+    // ========== 步骤3: 会话时间与回放录制 ==========
+    _sessionTime = snapshot.sessionTimeMs / 1000.0;
+    ReplayData replay;
+    if (!snapshot.replay.empty() && ReplayCodec::decode(snapshot.replay.data(), snapshot.replay.size(), replay)) {
+        _replayRecorder = std::make_shared<ReplayRecorder>();
+        _replayRecorder->resume(replay);
+    }
+
+    double restoreMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restoreStart).count();
+    CCLOG("Save: level %d restored, %d cards, %d undo steps in %.3f ms",
+        _levelId, (int)snapshot.cards.size(), (int)snapshot.undoHistory.size(), restoreMs);
+    return true;
+}
+
+/**
+ * @brief 处理撤销操作（Undo 按钮点击回调）
  * 
- * @details ִ̣ performMoveCard ෴
- * 1.  UndoManager ǷпɳĲ
- * 2. ӳջеһβ
- * 3. ݻָƵλáZ״̬
- * 4. µƶѶΪǰĿ
- * 5. ͼ㲥ŷ򶯻ƻԭλã
+ * @details 执行流程（与 performMoveCard 相反）：
+ * 1. 检查 UndoManager 是否有可撤销的操作
+ * 2. 从撤销栈中弹出最后一次操作的命令数据
+ * 3. 根据命令数据恢复卡牌的位置、Z序、状态
+ * 4. 更新底牌堆顶部引用为撤销前的卡牌
+ * 5. 在视图层播放反向动画（将卡牌移回原位置）
  * 
- * @note ߼ȫ UndoCommand м¼Ŀݣ
- *       - cardId: ĿID
- *       - fromPos: ԭʼλ
- *       - prevZIndex: ԭʼ Z 
- *       - prevState: ԭʼ״̬/ǣ
- *       - prevTopCardId: ǰĵƶѶID
- */
-void GameController::onUndoClicked() {
-    // ========== ǰü ==========
-    if (!_undoManager || !_undoManager->canUndo()) return;
-
-    // ========== ȡ ==========
-    UndoCommand cmd = _undoManager->popCommand();
-
-    //  ID ȡؿƵ shared_ptr
-    auto currentCard = _gameModel->getCardById(cmd.cardId);
-    auto prevTopCard = _gameModel->getCardById(cmd.prevTopCardId);
-
-    if (currentCard && prevTopCard) {
-
-        // ========== ݲָ ==========
-        // ָƵλú Z 
-        GameLogicService::applyMove(currentCard.get(), cmd.fromPos, cmd.prevZIndex);
-
-        // ָƵ״̬ӷظǣ
-        GameLogicService::applyStateChange(currentCard.get(), cmd.prevState);
-
-        // ָƶѵĶ
-        if (_stackController) _stackController->setTopCard(prevTopCard);
-
-        // ========== ͼָ ==========
-        // ҵӦ CardView ŷƶ
-        for (auto child : _gameView->getChildren()) {
-            CardView* cv = dynamic_cast<CardView*>(child);
-            if (cv && cv->getCardId() == currentCard->getId()) {
-                cv->stopAllActions(); // ֹͣǰ
-
-                // ƶصԭλã
-                auto move = MoveTo::create(0.3f, cmd.fromPos);
-
-                // ɺ Z ˢʾ
-                auto callback = CallFunc::create([cv, currentCard]() {
-                    cv->setLocalZOrder(currentCard->getZIndex());
-                    cv->updateView();
-                    });
-                cv->runAction(Sequence::create(move, callback, nullptr));
-            }
-        }
+ * @note 撤销逻辑完全依赖 UndoCommand 中记录的快照数据：
+ *       - cardId: 被操作的卡牌ID
+ *       - fromPos: 原始位置
+ *       - prevZIndex: 原始 Z 序
+ *       - prevState: 原始状态（翻开/覆盖）
+ *       - prevTopCardId: 撤销前的底牌堆顶部卡牌ID
+ *
+ * @return 是否有操作被撤销
+ */
+bool GameController::onUndoClicked() {
+    PROFILE_ZONE("GameController::onUndoClicked");
+    // ========== 数据层恢复 ==========
+    // MoveService 弹出最近一步的命令，恢复卡牌的位置、Z 序、状态和底牌堆顶部
+    UndoCommand cmd;
+    if (!_gameModel || !_undoManager || !MoveService::undo(*_gameModel, *_undoManager, cmd)) return false;
+
+    // ========== 视图层恢复 ==========
+    // 找到对应的 CardView 并播放反向移动动画
+    CardView* cv = _gameView ? _gameView->getCardView(cmd.cardId) : nullptr;
+    if (cv && _gameModel->getCardById(cmd.prevTopCardId)) {
+        // 追加反向移动动画（回到原位置），排在这张牌尚未播放完的动画之后
+        cv->enqueueMove(toVec2(cmd.fromPos), cmd.prevZIndex, kMoveDuration, false);
     }
-}
\ No newline at end of file
+    return true;
+}
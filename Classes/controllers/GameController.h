@@ -1,54 +1,73 @@
 /**
  * @file GameController.h
- * @brief Ϸ - MVCܹеĺЭ
+ * @brief 游戏主控制器 - MVC架构中的核心协调层
  * 
- * @details ְΧ
- * 1. **Ϸڹ**Ϸʼл
- * 2. **ӿЭ** StackControllerƶѣ PlayFieldController
- * 3. **ͼŽ** GameModelݲ㣩 GameViewͼ㣩
- * 4. **ҵ߼**ƶȿģ
+ * @details 职责范围：
+ * 1. **游戏生命周期管理**：负责游戏的启动、初始化、场景切换
+ * 2. **子控制器协调**：管理 StackController（备用牌堆）和 PlayFieldController（主牌区）
+ * 3. **数据与视图桥接**：连接 GameModel（数据层）与 GameView（视图层）
+ * 4. **核心业务逻辑**：处理卡牌移动、撤销等跨模块操作
  * 
- * @note ԭ
- * - **һԴ**п״̬ͳһ GameModel 
- * - **ְ**ֱӲ UIͨ GameView ӿӿ
- * - **ɲ**йؼ߼ͨ Mock ӿеԪ
+ * @note 设计原则：
+ * - **单一数据源**：所有卡牌状态统一由 GameModel 管理
+ * - **职责分离**：不直接操作 UI，通过 GameView 和子控制器间接控制
+ * - **可测试性**：所有关键逻辑都可通过 Mock 子控制器进行单元测试
  * 
- * @warning ע
- * - ̳ cocos2d::Refʹü
- * - ӿʹԭʼָ + retain/release ֶ
- * - UndoManager  GameModel ʹ shared_ptr Զ
+ * @warning 注意事项：
+ * - 本类继承自 cocos2d::Ref，使用引用计数管理生命周期
+ * - 子控制器使用原始指针 + retain/release 手动管理
+ * - UndoManager 和 GameModel 使用 shared_ptr 自动管理
  * 
- * @see GameModel - Ϸģ
- * @see GameView - Ϸͼ
- * @see StackController - ƶѿ
- * @see PlayFieldController - 
+ * @see GameModel - 游戏数据模型
+ * @see GameView - 游戏主视图
+ * @see StackController - 备用牌堆控制器
+ * @see PlayFieldController - 主牌区控制器
  */
 #ifndef GAME_CONTROLLER_H
 #define GAME_CONTROLLER_H
 
 #include "cocos2d.h"
+#include "services/LayoutService.h"
+#include "models/InputCommand.h"
+#include "models/ProtocolModel.h"
+#include "models/TelemetryEvent.h"
+#include "utils/AllocTracker.h"
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
-// ========== ǰ (Forward Declarations) ==========
-// ŵ㣺
-// 1. ѭ GameView ҲҪ GameController
-// 2. ӿٶȣͷļ
-// 3. ϶ȣֻ .cpp аʵ֣
+// ========== 前向声明 (Forward Declarations) ==========
+// 优点：
+// 1. 避免循环依赖（例如 GameView 可能也需要引用 GameController）
+// 2. 加快编译速度（减少头文件包含链）
+// 3. 降低耦合度（只在 .cpp 中包含具体实现）
 class GameModel;
 class UndoManager;
-class GameView;         // ؼֻ include
+class GameView;         // 【关键】只声明，不 include
 class StackController;
 class PlayFieldController;
 class CardModel;
+class TextureBudgetManager;
+class InputQueueManager;
+class ReplayRecorder;
+struct ReplayData;
+struct GameSnapshot;
+class LoopbackServer;
+class JobSystem;
+class AsyncFileWriter;
+class GameStatePublisher;
+class JobToken;
+class MovePredictor;
+class TelemetryManager;
+struct GameServices;
 
 
 /**
  * @class GameController
- * @brief ϷЭϵͳ
+ * @brief 游戏主控制器，负责协调所有子系统
  * 
- * @details ͼϵ
+ * @details 类图关系：
  * ```
  * GameController (1) --owns--> (1) GameModel
  *                (1) --owns--> (1) GameView
@@ -57,183 +76,525 @@ class CardModel;
  *                (1) --manages--> (1) PlayFieldController
  * ```
  * 
- * @note ڣ
- * - ̬ͨ startGame() 
- * - ʼɺ Director ĳ
- * - ʱԶͷţ Cocos2d-x ü
+ * @note 生命周期：
+ * - 通过静态工厂方法 startGame() 创建，持有调用方传入的 GameServices
+ * - 初始化完成后由 Director 的场景持有
+ * - 场景销毁时自动释放（由 Cocos2d-x 引用计数管理）
  */
 class GameController : public cocos2d::Ref {
 public:
-    // ==================== ӿ ====================
+    /**
+     * @brief 回放状态
+     */
+    enum class ReplayState {
+        NONE,       // 没有回放
+        PLAYING,    // 正在播放
+        PASSED,     // 全部操作执行完毕，每一步和最终的状态哈希都一致
+        FAILED      // 规则版本 / 初始状态 / 某一步的状态哈希不一致，或操作被拒绝
+    };
+
+    // ==================== 公共接口 ====================
     
     /**
-     * @brief Ϸڣ̬
-     * @param levelId ؿIDڼضӦĹؿļ
+     * @brief 游戏启动入口（静态工厂方法）
+     * @param services 跨关卡共享的服务（由 AppDelegate 创建），新控制器持有一份引用
+     * @param levelId 关卡ID，用于加载对应的关卡配置文件
      * 
-     * @details ִ̣
-     * 1.  GameController ʵ
-     * 2. عؿ (LevelConfig)
-     * 3. ʱ (GameModel)
-     * 4. ʼӿͼ
-     * 5. лϷ
+     * @details 执行流程：
+     * 1. 创建 GameController 实例
+     * 2. 加载关卡配置 (LevelConfig)
+     * 3. 生成运行时数据 (GameModel)
+     * 4. 初始化子控制器和视图
+     * 5. 切换到游戏场景
      * 
      * @example
-     * // ڲ˵һ
-     * GameController::startGame(1);
+     * // 在菜单场景中启动第一关
+     * GameController::startGame(_services, 1);
      * ```
      * 
      * @warning 
-     * - ô˷Զл֮ǰĳᱻ
-     * - levelId Ӧһڵļlevels/level_<id>.json
+     * - 调用此方法会自动切换场景，之前的场景会被销毁
+     * - levelId 必须对应一个存在的配置文件（levels/level_<id>.json）
+     */
+    static void startGame(const std::shared_ptr<GameServices>& services, int levelId);
+
+    /**
+     * @brief 加载回放中的关卡并自动播放
+     * @param services 跨关卡共享的服务，播放结果写入 services->replayState
+     * @param replay 回放数据（由 ReplayCodec 解码）
+     * @param realtime true：按录制时的时间戳播放，每帧最多一步，与真实触摸走同一条输入队列；
+     *                 false：尽快播放，场景就绪后的第一帧内执行完所有操作（无窗口基准测试使用）
+     * @return 是否开始播放（已有关卡正在分帧构建时返回 false）
+     *
+     * @details 
+     * - 播放期间忽略真实输入，也不录制新的回放
+     * - 每执行一步都计算状态哈希并与录制值比对，不一致时立即停止并记为 FAILED
+     * - 结果通过 GameServices::replayState 查询
+     */
+    static bool startReplay(const std::shared_ptr<GameServices>& services, const ReplayData& replay, bool realtime);
+
+    /**
+     * @brief 保存正在进行的一局（应用切到后台时由 AppDelegate 调用）
+     * @param services 跨关卡共享的服务，保存的是其中的 activeController
+     *
+     * @details
+     * 1. 主线程上采集模型、备用堆顺序、回退历史和录制中的回放，编码为二进制存档（SnapshotCodec）
+     * 2. 编码作为高优先级任务交给任务系统（GameServices::jobSystem），落盘交给文件写入器的 IO 线程（见 openSaveChannel）：
+     *    先写临时文件再改名为 saves/resume.sav，写到一半被系统杀掉时旧存档仍然完整
+     *
+     * @note 没有正在进行的关卡，或正在播放回放时不保存
+     */
+    static void saveRunningGame(GameServices& services);
+
+    /**
+     * @brief 读取存档并继续上次的一局
+     * @param services 跨关卡共享的服务
+     * @return 存档不存在、损坏或已有关卡正在分帧构建时返回 false
+     *
+     * @details 存档解码后随关卡一起加载：关卡生成模型后直接写入存档中的状态，
+     *          不重放任何操作；读档耗时输出到日志
+     */
+    static bool resumeGame(const std::shared_ptr<GameServices>& services);
+
+    /**
+     * @brief 是否存在可以继续的存档（关卡选择界面据此显示"继续"按钮）
+     */
+    static bool hasSavedGame();
+
+    /**
+     * @brief 在 services->fileWriter 中注册存档通道（主线程，创建文件写入器后调用一次）
+     * @param services 跨关卡共享的服务，通道记录到 services.saveChannel
+     *
+     * @details 存档注册为 REPLACE 通道（预先分配缓冲）：存档任务编码后只做一次内存拷贝，
+     *          由 IO 线程写临时文件、fsync 后改名；连续多次存档只落盘最后一次。
+     *          没有文件写入器或注册失败时，存档任务直接写文件
      */
-    static void startGame(int levelId);
+    static void openSaveChannel(GameServices& services);
 
     /**
-     * @brief ִпƶҵ߼
-     * @param card ҪƶĿģͣshared_ptr ȷڰȫ
-     * @param targetPos ĿλãͨǵƶѶ꣩
+     * @brief 当前一局的状态发布器，供后台任务读取游戏状态
+     * @return 关卡加载完成前为 nullptr
+     *
+     * @details 每帧结束时，如果本帧有操作被执行、回滚或布局改变，发布一份新的只读状态；
+     *          后台任务持有返回的 shared_ptr，用 GameStatePublisher::ReadGuard 读取，不需要访问 GameModel
+     */
+    std::shared_ptr<GameStatePublisher> getStatePublisher() const { return _statePublisher; }
+
+    /**
+     * @brief 执行卡牌移动操作（核心业务逻辑）
+     * @param card 要移动的卡牌数据模型（shared_ptr 确保生命周期安全）
+     * @param targetPos 目标位置（通常是底牌堆顶部的坐标）
      * 
-     * @details ִ̣
-     * 1. µ Z ȷƶĿʾϲ㣩
-     * 2.  GameLogicService  Model ݣλáZ
-     * 3.  StackController Ķ
-     * 4.  GameView ҵӦ CardViewִƶ
+     * @details 执行流程：
+     * 1. 计算新的 Z 序（确保移动的卡牌显示在最上层）
+     * 2. 调用 GameLogicService 更新 Model 数据（位置、Z序）
+     * 3. 更新 StackController 的顶部卡牌引用
+     * 4. 在 GameView 中找到对应的 CardView，执行移动动画
      * 
      * @example
      * ```cpp
      * auto card = _gameModel->getCardById(123);
-     * Vec2 discardPilePos(540, 200); // ƶλ
+     * Vec2 discardPilePos(540, 200); // 底牌堆中心位置
      * _gameController->performMoveCard(card, discardPilePos);
      * ```
      * 
-     * @note ˷ MVC ķֲ㣺
-     *       - Service ݣ״̬
-     *       - Controller Э߼
-     *       - View ֻ𶯻
+     * @note 此方法体现了 MVC 的分层：
+     *       - Service 层更新数据（无状态）
+     *       - Controller 协调逻辑
+     *       - View 层只负责动画
      */
     void performMoveCard(std::shared_ptr<CardModel> card, const cocos2d::Vec2& targetPos);
         /**
-     * @brief ȡƶѿṩӿã
-     * @return StackController ָ루תȨ
+     * @brief 获取备用牌堆控制器（提供给子控制器调用）
+     * @return StackController 指针（不转移所有权）
      * 
-     * @details ʹó
-     * - PlayFieldController ҪѯǰƶѶ
-     * - UndoManager Ҫָƶ״̬
+     * @details 使用场景：
+     * - PlayFieldController 需要查询当前底牌堆顶部卡牌
+     * - UndoManager 需要恢复底牌堆状态
      * 
      * @example
      * ```cpp
      * auto topCard = _gameController->getStackController()->getTopCard();
      * if (topCard) {
-     *     // Ƿ붥ƥ
+     *     // 检查是否可以与顶部卡牌匹配
      * }
      * ```
      */
     StackController* getStackController() const { return _stackController; }
+
+    /**
+     * @brief 获取当前屏幕布局（提供给子控制器和视图读取）
+     * @return 由 LayoutService 针对当前关卡和屏幕尺寸计算的布局
+     *
+     * @note 子控制器不再自行查询 Director 或硬编码偏移量，所有坐标锚点都从这里获取
+     */
+    const ScreenLayout& getLayout() const { return _layout; }
+
+    /**
+     * @brief 屏幕尺寸变化后重新布局
+     *
+     * @details 执行流程：
+     * 1. 按新的可见区域重新计算布局（复用关卡加载时缓存的主牌区包围盒，不重新解析配置）
+     * 2. 一次遍历把所有卡牌位置从旧布局换算到新布局
+     * 3. 同步改写撤销历史中的位置、子控制器的锚点、背景和按钮
+     *
+     * @note 由 GameView 收到 EVENT_SCREEN_RESIZED 后调用
+     */
+    void relayout();
         /**
-     * @brief ť¼
+     * @brief 处理撤销按钮点击事件
      * 
-     * @details ִ̣
-     * 1.  UndoManager ǷпɳĲ
-     * 2. ӳջеһβݣUndoCommand
-     * 3. ݻָƵλáZ״̬
-     * 4. µƶѶΪǰĿ
-     * 5. ͼ㲥ŷ򶯻
+     * @details 执行流程：
+     * 1. 检查 UndoManager 是否有可撤销的操作
+     * 2. 从撤销栈中弹出最后一次操作的命令数据（UndoCommand）
+     * 3. 根据命令数据恢复卡牌的位置、Z序、状态
+     * 4. 更新底牌堆顶部引用为撤销前的卡牌
+     * 5. 在视图层播放反向动画
      * 
-     * @note ƣ
-     * - ģʽ (Command Pattern)
-     * - ÿβǰ¼ݵ UndoCommand
-     * - ʱݿջָ״̬
+     * @note 撤销机制：
+     * - 基于命令模式 (Command Pattern)
+     * - 每次操作前记录快照数据到 UndoCommand
+     * - 撤销时根据快照恢复状态
      * 
-     * @see UndoManager::popCommand()
-     * @see UndoCommand ṹ
+     * @return 是否有操作被撤销（历史为空时返回 false）
+     *
+     * @see MoveService::undo()
+     * @see UndoCommand 结构定义
      */
-    void onUndoClicked();
+    bool onUndoClicked();
+
+    /**
+     * @brief 把一次用户输入压入输入队列（由触摸 / 按钮回调调用）
+     * @param type 命令类型（主牌区点击 / 备用堆点击 / 撤销）
+     * @param cardId 被点击的卡牌ID，UNDO 时忽略
+     *
+     * @details 回调中不再直接执行游戏逻辑，只记录一条 InputCommand；
+     *          逻辑统一在下一次 update 开始时批量处理
+     */
+    void enqueueInput(InputCommandType type, int cardId = -1);
+
+    /**
+     * @brief 每帧更新（由 Scheduler 以最高的非系统优先级调度，先于所有节点的 update）
+     * @param dt 距上一帧的时间（秒）
+     *
+     * @details 执行流程：
+     * 1. 从输入队列取出本帧的命令（同一张卡牌的重复点击已合并，超出每帧上限的留到下一帧）
+     * 2. 依次分发给对应的子控制器 / onUndoClicked
+     * 3. 记录本帧处理输入的耗时
+     */
+    void update(float dt);
 
 protected:
-    // ==================== ڹ ====================
+    // ==================== 生命周期管理 ====================
     
     /**
-     * @brief 캯ֹⲿֱ new
-     * @details ʼָΪ nullptrҰָ
-     * @note ѭ Cocos2d-x ׶ιģʽ + init
+     * @brief 构造函数（保护，防止外部直接 new）
+     * @details 初始化所有指针为 nullptr，避免野指针
+     * @note 遵循 Cocos2d-x 的两阶段构造模式（构造 + init）
      */
     GameController();
         /**
-     * @brief ֶ֧̬
-     * @details ͷӿü
-     * @warning ʹ CC_SAFE_RELEASE ȷͷǰָЧ
+     * @brief 析构函数（虚析构，支持多态）
+     * @details 释放子控制器的引用计数
+     * @warning 使用 CC_SAFE_RELEASE 宏确保释放前检查指针有效性
      */
     virtual ~GameController();
 
 private:
-    // ==================== ˽з ====================
+    // ==================== 私有方法 ====================
     
     /**
-     * @brief ؿʼ˽ʵ֣
-     * @param levelId ؿID
+     * @brief 创建控制器并加载关卡（startGame / startReplay / resumeGame 的共同实现）
+     * @param services 跨关卡共享的服务
+     * @param levelId 关卡ID
+     * @param replay 加载后播放的回放，为空时正常游戏
+     * @param realtime 回放是否按录制时的时间戳播放
+     * @param snapshot 加载后写入的存档，为空时新开局（播放回放时忽略）
+     */
+    static void _launch(const std::shared_ptr<GameServices>& services, int levelId,
+        std::shared_ptr<ReplayData> replay, bool realtime, std::shared_ptr<GameSnapshot> snapshot);
+
+    /**
+     * @brief 关卡初始化（私有实现）
+     * @param levelId 关卡ID
+     * @param snapshot 加载后写入的存档（可为空）
      * 
-     * @details ϸ裨MVC ܹ׼̣
-     * 1. ؾ̬ (Config )
-     * 2. ʱ (Service )
-     * 3. ʼ (Manager )
-     * 4. ʼӿ (Controller )
-     * 5. ͼ (View )
-     * 6. ͼݰ
-     * 7. л
+     * @details 详细步骤（MVC 架构标准流程）：
+     * 1. 加载静态配置 (Config 层)
+     * 2. 生成运行时数据 (Service 层)
+     * 3. 初始化管理器 (Manager 层)
+     * 4. 初始化子控制器 (Controller 层)
+     * 5. 构建视图层 (View 层)
+     * 6. 视图与数据绑定
+     * 7. 切换场景
      * 
-     * @note κβʧܶӦжϲ¼־
-     * @see startGame() - ⲿ
+     * @note 任何步骤失败都应该中断并记录日志
+     * @see _launch() - 创建控制器并设置回放后调用
+     */
+    void _initWithLevel(int levelId, std::shared_ptr<GameSnapshot> snapshot);
+
+    /**
+     * @brief 分帧构建回调（由 Scheduler 每帧调用）
+     * @param dt 距上一帧的时间（秒）
+     * @details 在每帧的时间预算内执行构建步骤，全部完成后切换场景
+     */
+    void _buildSceneStep(float dt);
+
+    /**
+     * @brief 切换到已构建完成的场景
+     */
+    void _presentScene();
+
+    /**
+     * @brief 结束分帧构建
+     * @details 停止调度，输出过渡期间的帧数与最大帧时间，释放 _launch 中的临时引用
+     */
+    void _finishSceneBuild();
+
+    /**
+     * @brief 执行一条输入命令，并把结果交给回放录制或校验
+     * @param cmd 输入命令
+     */
+    void _executeInput(const InputCommand& cmd);
+
+    /**
+     * @brief 把输入命令交给对应的子控制器
+     * @param cmd 输入命令
+     * @return 命令是否被游戏逻辑接受（改变了游戏状态）
+     */
+    bool _processInput(const InputCommand& cmd);
+
+    /**
+     * @brief 计算当前的游戏状态哈希
+     */
+    uint64_t _computeStateHash() const;
+
+    /**
+     * @brief 处理工作线程经无锁队列交回的结果记录（update 开始时调用，每帧一次）
+     * @details 存档、回放写入等后台任务只把定长记录压入 MpscQueue，不加锁、不分配内存，
+     *          代替 performFunctionInCocosThread（每次调用加锁并分配 std::function）
+     */
+    static void _drainWorkerResults();
+
+    /**
+     * @brief 每帧推进回放：实时模式放出到期的一步，快速模式执行剩余的全部操作
+     */
+    void _feedReplay();
+
+    /**
+     * @brief 校验刚执行完的一步回放操作
+     * @param cmd 已执行的命令
+     * @param stateHash 执行后的状态哈希
+     */
+    void _verifyReplayMove(const InputCommand& cmd, uint64_t stateHash);
+
+    /**
+     * @brief 回放失败：记录原因并停止播放
+     */
+    void _failReplay(const char* reason);
+
+    /**
+     * @brief 结束录制并把回放写入可写目录（replays/level_<id>.cgr，每关保留最近一局）
+     */
+    void _saveReplay();
+
+    /**
+     * @brief 处理服务端发来的帧（JOINED / ACK_BATCH），每帧开始时调用
+     */
+    void _pollServer();
+
+    /**
+     * @brief 把本帧预测执行的操作合并为一个 MOVE_BATCH 发给服务端，每帧结束时调用
+     * @note 尚未收到 JOINED 时继续累积，加入后一次发出
+     */
+    void _flushMoveBatch();
+
+    /**
+     * @brief 回滚之后把卡牌视图移到模型中的位置和层级
+     */
+    void _syncCardViews();
+
+    /**
+     * @brief 发布当前状态（模型、备用堆顺序、回退历史、布局尺寸和状态哈希）
+     * @details 关卡加载完成时发布一次；之后由 update 在本帧状态有变化时调用
+     */
+    void _publishState();
+
+    /**
+     * @brief 把存档写入刚生成的模型（_initWithLevel 调用）
+     * @param snapshot 存档数据
+     * @return 存档与当前关卡不对应时返回 false，模型保持为新开局的状态
+     *
+     * @details 屏幕尺寸与存档时不同时，按两套布局换算卡牌和回退历史中的位置；
+     *          存档中有录制到一半的回放时继续录制
      */
-    void _initWithLevel(int levelId);
+    bool _restoreSnapshot(const GameSnapshot& snapshot);
 
 private:
-    // ==================== Ա ====================
+    // ==================== 成员变量 ====================
     
     /**
-     * @brief Ϸģָͣ
+     * @brief 游戏数据模型（智能指针管理）
      * @details 
-     * - 洢пƵʱ״̬λáZ򡢷/ǣ
-     * - ʹ shared_ptr ͬһԴ
-     * - һԶ
+     * - 存储所有卡牌的运行时状态（位置、Z序、翻开/覆盖）
+     * - 使用 shared_ptr 允许多个控制器共享同一数据源
+     * - 生命周期由最后一个持有者自动管理
      */
     std::shared_ptr<GameModel> _gameModel;
         /**
-     * @brief ָ
+     * @brief 撤销管理器（智能指针管理）
      * @details 
-     * - άʷջUndoCommand У
-     * - ṩ canUndo/popCommand Ƚӿ
-     * - ֹʵΪѭܹҪ
+     * - 维护操作历史栈（UndoCommand 队列）
+     * - 提供 canUndo/popCommand 等接口
+     * - 禁止实现为单例（遵循架构要求）
      */
     std::shared_ptr<UndoManager> _undoManager;
 
+    /**
+     * @brief 只读状态发布器（后台任务通过 getStatePublisher 共享）；本帧是否有未发布的状态变化
+     */
+    std::shared_ptr<GameStatePublisher> _statePublisher;
+    bool _stateDirty;
+
         /**
-     * @brief Ϸͼԭʼָ + Cocos2d-x ü
+     * @brief 游戏主视图（原始指针 + Cocos2d-x 引用计数）
      * @details 
-     * - ϷĲ
-     * - UI ť
-     * - ͨ Scene üԶ
+     * - 负责管理整个游戏界面的布局
+     * - 包含背景、卡牌容器、UI 按钮等
+     * - 通过 Scene 的引用计数自动管理生命周期
      * 
-     * @warning Ҫֶ delete Scene ʱԶͷ
+     * @warning 不要手动 delete，由 Scene 销毁时自动释放
      */
     GameView* _gameView;
 
         /**
-     * @brief ƶѿԭʼָ + ֶ retain/release
+     * @brief 备用牌堆控制器（原始指针 + 手动 retain/release）
      * @details 
-     * - ҵ߼
-     * - Ʋƺľ
-     * - Ҫڹ캯 retain release
+     * - 负责管理抽牌区域的业务逻辑
+     * - 处理翻牌操作、备用牌耗尽检测等
+     * - 需要在构造函数中 retain，析构函数中 release
      */
     StackController* _stackController;
     
         /**
-     * @brief ԭʼָ + ֶ retain/release
+     * @brief 主牌区控制器（原始指针 + 手动 retain/release）
      * @details 
-     * - 濨Ƶĵƥ߼
-     * - жϿǷɵǷƥ
-     * - Ҫڹ캯 retain release
+     * - 负责管理桌面卡牌的点击与匹配逻辑
+     * - 判断卡牌是否可点击、是否与底牌匹配
+     * - 需要在构造函数中 retain，析构函数中 release
      */
     PlayFieldController* _playFieldController;
+
+    /**
+     * @brief 关卡主牌区包围盒（关卡坐标）
+     * @details 关卡加载时由 LayoutService 计算一次，屏幕尺寸变化时直接复用
+     */
+    cocos2d::Rect _playfieldBounds;
+
+    /**
+     * @brief 当前屏幕布局
+     * @details 关卡加载和屏幕尺寸变化时更新，子控制器通过 getLayout() 读取
+     */
+    ScreenLayout _layout;
+
+    /**
+     * @brief 输入队列管理器（智能指针管理）
+     * @details 触摸回调只负责压入命令，update 开始时统一取出处理
+     */
+    std::shared_ptr<InputQueueManager> _inputQueue;
+
+    /**
+     * @brief 本帧取出的输入命令（复用容量，避免每帧分配）
+     */
+    std::vector<InputCommand> _inputBatch;
+
+    // ==================== 回放 ====================
+
+    /**
+     * @brief 当前关卡ID
+     */
+    int _levelId;
+
+    /**
+     * @brief 本局游戏经过的时间（秒），由 update 的 dt 累加，用作回放时间戳
+     */
+    double _sessionTime;
+
+    /**
+     * @brief 本局的遥测上下文（playId 为 0 表示本局不记录）与上一次操作的时间（秒，同 _sessionTime）
+     */
+    TelemetryPlay _telemetryPlay;
+    double _lastMoveTime;
+
+    /**
+     * @brief 回放录制器（正常游戏时创建，回放时为空）
+     */
+    std::shared_ptr<ReplayRecorder> _replayRecorder;
+
+    /**
+     * @brief 正在播放的回放（正常游戏时为空）
+     * @details _replayFed：已放入输入队列 / 已执行的操作数；_replayVerified：已校验的操作数
+     */
+    std::shared_ptr<ReplayData> _replay;
+    size_t _replayFed;
+    size_t _replayVerified;
+    bool _replayRealtime;
+
+    // ==================== 服务端权威模式 ====================
+
+    /**
+     * @brief 服务端与预测管理器（未开启服务端权威模式时为空）
+     */
+    std::shared_ptr<LoopbackServer> _server;
+    std::shared_ptr<MovePredictor> _predictor;
+
+    /**
+     * @brief 服务端分配的会话（0 表示尚未加入）
+     */
+    uint64_t _sessionId;
+
+    /**
+     * @brief 本帧待发送的操作，以及服务端发来的帧（复用容量）
+     */
+    MoveBatchFrame _outgoingBatch;
+    std::vector<std::vector<uint8_t>> _incomingFrames;
+    std::vector<uint8_t> _frameBuffer;
+
+    // ==================== 跨关卡服务 ====================
+
+    /**
+     * @brief 跨关卡共享的服务（贴图预算、任务系统、文件写入器、遥测、服务端）与存档 / 回放状态
+     * @details 由 startGame 等入口传入；_presentScene 时把本控制器记为 activeController，析构时清空
+     */
+    std::shared_ptr<GameServices> _services;
+
+    // ==================== 分帧构建 ====================
+
+    /**
+     * @brief 正在屏幕外构建的场景（构建期间手动 retain）
+     */
+    cocos2d::Scene* _pendingScene;
+
+    /**
+     * @brief 待执行的构建步骤（每步创建一张卡牌视图）
+     * @details 由子控制器的 initView 追加，_buildSceneStep 按时间预算逐帧消费
+     */
+    std::vector<std::function<void()>> _buildSteps;
+    size_t _nextBuildStep;
+
+    // 过渡统计：关卡 ID、经历的帧数、最大帧时间（毫秒）、场景是否已切换
+    int _pendingLevelId;
+    int _buildFrames;
+    float _maxTransitionFrameMs;
+    bool _sceneSwapped;
+
+    // 分配统计：关卡加载开始时的快照，构建结束时输出差值（CARDGAME_ALLOC_TRACKING 构建）
+    AllocCounters _loadAllocStart;
+
+    /**
+     * @brief 是否有关卡正在分帧构建（防止重复点击触发多次构建）
+     */
+    static bool s_sceneBuildInProgress;
 };
 
 #endif // GAME_CONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * @file GameServices.h
+ * @brief 游戏控制器使用的跨关卡服务与运行状态
+ */
+#ifndef GAME_SERVICES_H
+#define GAME_SERVICES_H
+
+#include "controllers/GameController.h"
+#include "managers/AsyncFileWriter.h"
+#include <memory>
+
+class JobSystem;
+class JobToken;
+class LoopbackServer;
+class TelemetryManager;
+class TextureBudgetManager;
+
+/**
+ * @brief 游戏服务集合 (GameServices)
+ * 职责：集中持有跨关卡共享的管理器，以及只在主线程访问的存档 / 回放状态
+ *
+ * @details
+ * - 由 AppDelegate 创建并持有，经 LevelSelectView 传给 GameController::startGame / startReplay / resumeGame，
+ *   每个 GameController 持有同一份 shared_ptr
+ * - 管理器成员均可为空，对应功能随之关闭（见各成员说明）
+ * - 退出时 AppDelegate 先把管理器成员置空再关闭管理器，之后析构的控制器不再使用它们
+ *
+ * @note 不是单例：测试或无窗口入口可以各自创建一份
+ */
+struct GameServices {
+    // ==================== 管理器 ====================
+
+    // 贴图显存预算：关卡切换时打印残留贴图，新场景进入后超出预算则淘汰；为空时不统计
+    std::shared_ptr<TextureBudgetManager> textureBudgetManager;
+
+    // 后台任务系统：存档（高优先级）和回放文件（普通优先级）在工作线程编码与写入；为空时在主线程同步执行
+    std::shared_ptr<JobSystem> jobSystem;
+
+    // 后台文件写入器与其中的存档通道（见 GameController::openSaveChannel）；没有通道时存档任务直接写文件
+    std::shared_ptr<AsyncFileWriter> fileWriter;
+    AsyncFileWriter::ChannelId saveChannel = AsyncFileWriter::INVALID_CHANNEL;
+
+    // 遥测：记录开局、操作和结束时的结果；为空时不记录
+    std::shared_ptr<TelemetryManager> telemetryManager;
+
+    // 服务端权威模式使用的服务端（目前为本地回环服务端）；为空时单机游戏（默认）
+    // 之后加载的关卡（读档和回放除外）发送 JOIN，点击在本地预测执行、由服务端确认，被拒绝的操作回滚；本地不录制回放
+    std::shared_ptr<LoopbackServer> loopbackServer;
+
+    // ==================== 运行状态（主线程） ====================
+
+    // 场景正在显示的控制器（saveRunningGame 保存的对象），控制器析构时清空
+    GameController* activeController = nullptr;
+
+    // 最近一次存档任务的取消令牌：新的存档取消尚未开始写入的旧存档
+    std::shared_ptr<JobToken> saveToken;
+
+    // 最近一次回放的状态（startReplay 置为 PLAYING，播放结束时更新）
+    GameController::ReplayState replayState = GameController::ReplayState::NONE;
+};
+
+#endif // GAME_SERVICES_H
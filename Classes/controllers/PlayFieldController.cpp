@@ -3,6 +3,10 @@
 #include "controllers/GameController.h"
 #include "controllers/StackController.h"
 #include "services/GameLogicService.h"
+#include "services/MoveService.h"
+#include "utils/AllocTracker.h"
+#include "utils/Profiler.h"
+#include "utils/VectorConvert.h"
 #include "views/CardView.h"
 #include "views/GameView.h" 
 
@@ -20,57 +24,52 @@ void PlayFieldController::init(std::shared_ptr<GameModel> model, std::shared_ptr
     _mainController = mainController;
 }
 
-void PlayFieldController::initView(GameView* gameView) {
+void PlayFieldController::initView(GameView* gameView, std::vector<std::function<void()>>* deferredSteps, bool restored) {
     if (!_gameModel) return;
 
-    // ƫ
-    // ԭʼ Y=600 ᵲס(߶580)ǰ 250 
-    const float PLAYFIELD_OFFSET_Y = 250.0f;
+    // 【布局】关卡坐标 -> 屏幕坐标的变换由 LayoutService 统一计算
+    // （默认整体上移 250 像素避开底部操作区，屏幕放不下时等比缩小）
+    const ScreenLayout& layout = _mainController->getLayout();
 
     for (auto& card : _gameModel->allCards) {
-        // ɸѡ PlayField  (OriginPos != 0,0)
-        if (!card->getOriginPosition().equals(Vec2::ZERO)) {
+        // 筛选出 PlayField 的牌 (OriginPos != 0,0)
+        if (!card->getOriginPosition().equals(Vector2::ZERO)) {
 
-            // 1.  Model λ (ֹӾ߼һ)
-            Vec2 oldPos = card->getPosition();
-            Vec2 newPos = Vec2(oldPos.x, oldPos.y + PLAYFIELD_OFFSET_Y);
+            // 1. 修正 Model 数据位置 (防止视觉和逻辑不一致)
+            //    读档时牌可能已经在底牌堆里，位置以存档为准
+            if (!restored) {
+                Vec2 newPos = layout.toScreen(toVec2(card->getOriginPosition()));
 
-            // ʹ Service ޸ (ѭܹ)
-            // ע⣺ﲻҪ Undoǳʼ
-            GameLogicService::applyMove(card.get(), newPos, card->getZIndex());
-
-            // 2. ͼ
-            CardView* cv = CardView::create(card.get());
-            if (cv) {
-                cv->setClickCallback([this](int id) {
-                    this->handleCardClick(id);
-                    });
-                gameView->addCardView(cv);
+                // 使用 Service 修改数据 (遵循架构)
+                // 注意：这里不需要记入 Undo，这是初始化布局
+                GameLogicService::applyMove(card.get(), toVector2(newPos), card->getZIndex());
             }
+
+            // 2. 创建视图（分帧构建时只登记步骤，数据已经就绪）
+            auto createView = [this, gameView, card]() {
+                ALLOC_SCOPE(AllocTag::VIEWS);
+                CardView* cv = CardView::create(card.get());
+                if (cv) {
+                    cv->setBaseScale(_mainController->getLayout().cardScale);
+                    // 点击只压入输入队列，逻辑在 GameController::update 中统一处理
+                    cv->setClickCallback([this](int id) {
+                        _mainController->enqueueInput(InputCommandType::PLAYFIELD_TAP, id);
+                        });
+                    gameView->addCardView(cv);
+                }
+                };
+            if (deferredSteps) deferredSteps->push_back(createView);
+            else createView();
         }
     }
 }
 
-// ... handleCardClick ֲ ...
+// 匹配判定由 MoveService 完成，Undo 记录在 performMoveCard 中由 MoveService 统一写入
 bool PlayFieldController::handleCardClick(int cardId) {
-    auto card = _gameModel->getCardById(cardId);
-    if (!card) return false;
-
-    auto stackCtrl = _mainController->getStackController();
-    auto topCard = stackCtrl->getTopCard();
-
-    if (!topCard) return false;
-
-    if (GameLogicService::canMatch(topCard.get(), card.get())) {
-        UndoCommand cmd(card->getId(), card->getPosition(), topCard->getId(), card->getState(), card->getZIndex());
-        _undoManager->pushCommand(cmd);
-
-        Vec2 targetPos = topCard->getPosition();
-        _mainController->performMoveCard(card, targetPos);
-
-        CCLOG("Action: PlayField Match Success");
-        return true;
-    }
+    PROFILE_ZONE("PlayFieldController::handleCardClick");
+    if (!MoveService::canMovePlayFieldCard(*_gameModel, cardId)) return false;
 
-    return false;
+    Vec2 targetPos = toVec2(_gameModel->getTopCard()->getPosition());
+    _mainController->performMoveCard(_gameModel->getCardById(cardId), targetPos);
+    return true;
 }
\ No newline at end of file
@@ -4,9 +4,11 @@
 #include "cocos2d.h"
 #include "models/GameModel.h"
 #include "managers/UndoManager.h"
+#include <functional>
 #include <memory>
+#include <vector>
 
-// ؼ޸ǰ
+// 【关键修复】前向声明
 class GameView;
 class GameController;
 
@@ -16,8 +18,10 @@ public:
 
     void init(std::shared_ptr<GameModel> model, std::shared_ptr<UndoManager> undoMgr, GameController* mainController);
 
-    // õ GameView*Ҫǰ
-    void initView(GameView* gameView);
+    // 这里用到了 GameView*，所以需要前向声明
+    // deferredSteps 不为空时，卡牌视图的创建被拆成独立步骤追加进去，由 GameController 分帧执行
+    // restored 为 true 时模型来自存档：保留存档中的位置，不再按关卡坐标摆放
+    void initView(GameView* gameView, std::vector<std::function<void()>>* deferredSteps = nullptr, bool restored = false);
 
     bool handleCardClick(int cardId);
 
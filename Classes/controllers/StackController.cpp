@@ -14,11 +14,23 @@
 #include "controllers/StackController.h"
 #include "controllers/GameController.h"
 #include "services/GameLogicService.h"
+#include "services/LayoutService.h"
+#include "services/MoveService.h"
+#include "utils/AllocTracker.h"
+#include "utils/Profiler.h"
+#include "utils/VectorConvert.h"
 #include "views/CardView.h"
 #include "views/GameView.h"
+#include <algorithm>
 
 using namespace cocos2d;
 
+// 备用堆最多同时存在的卡牌视图数量，其余的牌只以角标计数显示
+static const int kMaxStockViews = 5;
+
+// 备用堆扇形展开的间距
+static const float kStockFanOffsetX = 70.0f;
+
 
 /**
  * @brief 创建实例（静态工厂方法）
@@ -43,22 +55,30 @@ StackController* StackController::create() {
  * 
  * @details 
  * - 保存核心组件的引用
- * - 计算备用堆（Stock）和底牌堆（Active）的屏幕坐标
- * - 坐标基于屏幕中心计算，适配不同分辨率
+ * - 从主控制器的屏幕布局读取备用堆（Stock）和底牌堆（Active）的坐标
  */
 void StackController::init(std::shared_ptr<GameModel> model, std::shared_ptr<UndoManager> undoMgr, GameController* mainController) {
     _gameModel = model;
     _undoManager = undoMgr;
     _mainController = mainController;
+    _gameView = nullptr;
+    _buriedCount = 0;
 
-    // 获取屏幕可见区域大小
-    Size visibleSize = Director::getInstance()->getVisibleSize();
+    if (_mainController) applyLayout(_mainController->getLayout());
+}
 
-    // 计算备用牌堆位置（左侧）
-    _stockPos = Vec2(visibleSize.width / 2 - 250, 290);
+/**
+ * @brief 更新区域锚点
+ * @param layout 新的屏幕布局
+ *
+ * @details 只更新锚点和角标；卡牌位置由 GameController::relayout 统一换算
+ */
+void StackController::applyLayout(const ScreenLayout& layout) {
+    _stockPos = layout.stockPos;
+    _activePos = layout.activePos;
+    _stockBadgePos = layout.stockBadgePos;
 
-    // 计算底牌堆位置（右侧，用于放置翻开的牌）
-    _activePos = Vec2(visibleSize.width / 2 + 150, 290);
+    if (_gameView) _gameView->updateStockBadge(_stockBadgePos, _buriedCount);
 }
 
 
@@ -67,60 +87,137 @@ void StackController::init(std::shared_ptr<GameModel> model, std::shared_ptr<Und
  * @param gameView 游戏主视图
  * 
  * @details 执行流程：
- * 1. **筛选卡牌**：从 GameModel 中找出所有属于 Stack 的卡牌（位置为 ZERO 的牌）
+ * 1. **发牌**：由 MoveService::dealStack 完成数据层的初始状态（与回放校验共用同一套规则）
+ *    - 最后一张牌 -> 翻开 -> 设为底牌堆顶部（TopCard）
+ *    - 其他牌 -> 依次叠入备用堆（Stock）
  * 2. **分配位置**：
- *    - 最后一张牌 -> 翻开 -> 放入底牌堆（Active） -> 设为 TopCard
- *    - 其他牌 -> 覆盖 -> 放入备用堆（Stock）
- * 3. **创建视图**：为每张牌创建 CardView，并绑定点击回调
- * 4. **添加到场景**：将 CardView 添加到 GameView 中显示
+ *    - 底牌放在 Active 位置
+ *    - 备用堆顶部 kMaxStockViews 张扇形展开，其余叠在堆底
+ * 3. **创建视图**：只为底牌和备用堆顶部的牌创建 CardView，堆底的牌只显示角标计数
+ *    （传入 deferredSteps 时改为登记步骤，由 GameController 分帧执行）
+ * 4. **按需补建**：顶部的牌被抽走后，由 materializeBuriedCards 为下面的牌补建视图
+ *
+ * @note 备用牌再多，初始化开销和节点数量也保持不变
+ * @note 读档时（restored）数据已由 SnapshotService 写入，改由 restoreView 按存档重建视图
  */
-void StackController::initView(GameView* gameView) {
+void StackController::initView(GameView* gameView, std::vector<std::function<void()>>* deferredSteps, bool restored) {
     if (!_gameModel) return;
+    _gameView = gameView;
 
-    // 筛选出所有备用牌（在 LevelConfigLoader 中位置被设为 0,0 的牌）
-    std::vector<std::shared_ptr<CardModel>> stackCards;
-    for (auto& card : _gameModel->allCards) {
-        if (card->getOriginPosition().equals(Vec2::ZERO)) {
-            stackCards.push_back(card);
-        }
+    // 分帧构建时只登记视图创建步骤，数据在本函数内立即就绪
+    auto createView = [this, deferredSteps](const std::shared_ptr<CardModel>& card) {
+        if (deferredSteps) deferredSteps->push_back([this, card]() { createCardView(card); });
+        else createCardView(card);
+        };
+
+    if (restored) {
+        restoreView(createView);
+        return;
     }
 
-    int offsetIndex = 0;
+    // 发牌：底牌翻开成为顶部卡牌，其余按顺序进入备用堆（在 LevelConfigLoader 中位置被设为 0,0 的牌）
+    MoveService::dealStack(*_gameModel, _stockCards);
+    auto activeCard = _gameModel->getTopCard();
+    if (!activeCard) return;
 
-    // 遍历并设置初始状态
-    for (auto& card : stackCards) {
+    // 初始底牌放在右侧 Active 位置
+    GameLogicService::applyMove(activeCard.get(), toVector2(_activePos), activeCard->getZIndex());
+    createView(activeCard);
 
-        // 判断是否是最后一张牌（作为初始底牌）
-        bool isLastOne = (card == stackCards.back());
-        if (isLastOne) {
-            // 初始底牌：翻开，放在右侧 Active 位置
-            GameLogicService::applyMove(card.get(), _activePos,100);
-            GameLogicService::applyStateChange(card.get(), CardState::FACE_UP);
-            _topStackCard = card;// 记录为当前底牌
-        }
-        else {
+    // 备用牌：堆底的牌叠放在 Stock 位置，顶部的牌向右展开
+    _buriedCount = std::max(0, (int)_stockCards.size() - kMaxStockViews);
 
-            float offsetX = offsetIndex * 70.0f;
-            float offsetY = offsetIndex * 0.f;
+    for (int i = 0; i < (int)_stockCards.size(); ++i) {
+        auto& card = _stockCards[i];
+        int fanIndex = std::max(0, i - _buriedCount);
+        Vec2 finalPos = _stockPos + Vec2(fanIndex * kStockFanOffsetX, 0.f);
 
-            Vec2 finalPos = _stockPos + Vec2(offsetX, offsetY);
-            // 备用牌：覆盖，放在左侧 Stock 位置
-            GameLogicService::applyMove(card.get(),finalPos, offsetIndex);
-            GameLogicService::applyStateChange(card.get(), CardState::FACE_UP);
-            offsetIndex++;
-        }
+        GameLogicService::applyMove(card.get(), toVector2(finalPos), card->getZIndex());
 
-        // 创建视图对象
-        CardView* cv = CardView::create(card.get());
-        if (cv) {
-            // 绑定点击回调：点击时调用 handleCardClick
-            cv->setClickCallback([this](int id) {
-                this->handleCardClick(id);
-                });
-            // 将卡牌视图添加到游戏场景中
-            gameView->addCardView(cv);
+        if (i >= _buriedCount) {
+            createView(card);
         }
     }
+
+    _gameView->updateStockBadge(_stockBadgePos, _buriedCount);
+}
+
+/**
+ * @brief 按存档重建备用堆 / 底牌堆的视图
+ * @param createView 创建（或登记创建）单张卡牌视图
+ *
+ * @details
+ * 1. 按 GameModel::stockCardIds 恢复备用堆顺序，状态、层级、位置都已在模型中，不再发牌
+ * 2. 仍留在备用堆中的牌（不在 Active 位置）超过 kMaxStockViews 张时，
+ *    堆底连续的那几张暂不创建视图，与正常发牌后的状态一致
+ * 3. 其余的备用牌组卡牌（包括已抽到底牌堆的）全部创建视图
+ */
+void StackController::restoreView(const std::function<void(const std::shared_ptr<CardModel>&)>& createView) {
+    _stockCards.clear();
+    for (int id : _gameModel->stockCardIds) {
+        auto card = _gameModel->getCardById(id);
+        if (card) _stockCards.push_back(card);
+    }
+
+    // 统计仍在备用堆中的牌，以及其中从堆底开始连续的张数
+    auto isInStock = [this](const std::shared_ptr<CardModel>& card) {
+        return !card->getPosition().equals(toVector2(_activePos));
+        };
+    int leadingInStock = 0;
+    while (leadingInStock < (int)_stockCards.size() && isInStock(_stockCards[leadingInStock])) leadingInStock++;
+    int inStock = (int)std::count_if(_stockCards.begin(), _stockCards.end(), isInStock);
+    _buriedCount = std::max(0, std::min(leadingInStock, inStock - kMaxStockViews));
+
+    for (auto& card : _gameModel->allCards) {
+        if (!MoveService::isStackCard(*card)) continue;
+        auto buriedEnd = _stockCards.begin() + _buriedCount;
+        if (std::find(_stockCards.begin(), buriedEnd, card) != buriedEnd) continue;
+        createView(card);
+    }
+
+    _gameView->updateStockBadge(_stockBadgePos, _buriedCount);
+}
+
+/**
+ * @brief 按需为堆底的牌补建视图
+ *
+ * @details 统计已有视图且仍留在备用堆中的牌（未被抽到 Active 位置），
+ *          不足 kMaxStockViews 张时，从堆底由上往下依次补建。
+ *          回退把牌送回备用堆时视图已经存在，不会重复创建。
+ */
+void StackController::materializeBuriedCards() {
+    if (!_gameView || _buriedCount <= 0) return;
+
+    int viewsInStock = 0;
+    for (int i = _buriedCount; i < (int)_stockCards.size(); ++i) {
+        if (!_stockCards[i]->getPosition().equals(toVector2(_activePos))) viewsInStock++;
+    }
+
+    while (viewsInStock < kMaxStockViews && _buriedCount > 0) {
+        _buriedCount--;
+        createCardView(_stockCards[_buriedCount]);
+        viewsInStock++;
+    }
+
+    _gameView->updateStockBadge(_stockBadgePos, _buriedCount);
+}
+
+/**
+ * @brief 创建卡牌视图并加入场景
+ * @param card 卡牌数据
+ */
+void StackController::createCardView(const std::shared_ptr<CardModel>& card) {
+    ALLOC_SCOPE(AllocTag::VIEWS);
+    CardView* cv = CardView::create(card.get());
+    if (cv) {
+        cv->setBaseScale(_mainController ? _mainController->getLayout().cardScale : 1.0f);
+        // 绑定点击回调：点击只压入输入队列，由 GameController::update 调用 handleCardClick
+        cv->setClickCallback([this](int id) {
+            if (_mainController) _mainController->enqueueInput(InputCommandType::STACK_TAP, id);
+            });
+        // 将卡牌视图添加到游戏场景中
+        _gameView->addCardView(cv);
+    }
 }
 
 ///**
@@ -169,51 +266,23 @@ void StackController::initView(GameView* gameView) {
 //    }
 //    return false;
 //}
+/**
+ * @brief 处理卡牌点击事件（抽牌）
+ * @param cardId 被点击的卡牌ID
+ * @return bool 是否成功处理了点击
+ *
+ * @details 
+ * 1. 由 MoveService 判定：属于备用牌组、且不是当前底牌（无论正反面都可以抽）
+ * 2. 委托主控制器把牌移到底牌堆（MoveService 负责记录 Undo、翻面、更新 TopCard，随后播放动画）
+ * 3. 顶部的牌离开后，为堆底的牌补建视图
+ */
 bool StackController::handleCardClick(int cardId) {
-    auto card = _gameModel->getCardById(cardId);
-    if (!card) return false;
-
-    // 1. 判定它是否属于 Stack 组 (根据原始位置判断)
-    bool isStackCard = card->getOriginPosition().equals(Vec2::ZERO);
-
-    // 2. 判定它不是当前右边的底牌
-    // (我们只允许点击左边的备用牌，右边的牌是用来被动接收的)
-    bool isNotActiveTop = (card != _topStackCard);
-
-    // 【核心修改】
-    // 这里的判断条件现在只看位置，不看正反面 (CardState)。
-    // 无论它是 FACE_UP 还是 FACE_DOWN，只要在备用堆里，就可以点。
-    if (isStackCard && isNotActiveTop) {
-
-        // 1. 记录撤销命令
-        UndoCommand cmd(
-            card->getId(),
-            card->getPosition(),
-            _topStackCard->getId(),
-            card->getState(),
-            card->getZIndex()
-        );
-        _undoManager->pushCommand(cmd);
-
-        // 2. 强制设为正面 (不管原来是啥，飞过去后必须是正面)
-        GameLogicService::applyStateChange(card.get(), CardState::FACE_UP);
-
-        // 3. 飞到右边
-        if (_mainController) {
-            _mainController->performMoveCard(card, _activePos);
-        }
-        return true;
-    }
+    PROFILE_ZONE("StackController::handleCardClick");
+    if (!_gameModel || !MoveService::canMoveStackCard(*_gameModel, cardId)) return false;
 
-    return false;
+    if (_mainController) {
+        _mainController->performMoveCard(_gameModel->getCardById(cardId), _activePos);
+    }
+    materializeBuriedCards();
+    return true;
 }
-/**
- * @brief 更新当前底牌堆顶部的卡牌引用
- * @param card 新的顶部卡牌
- * 
- * @note 此方法通常由 GameController 在执行移动后调用
- *       或者在 Undo 操作恢复状态时调用
- */
-void StackController::setTopCard(std::shared_ptr<CardModel> card) {
-    _topStackCard = card;
-}
\ No newline at end of file
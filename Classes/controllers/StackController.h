@@ -4,12 +4,14 @@
 #include "cocos2d.h"
 #include "models/GameModel.h"
 #include "managers/UndoManager.h"
+#include <functional>
 #include <memory>
 #include <vector>
 
-// ؼ޸ǰ
+// 【关键修复】前向声明
 class GameView;
 class GameController;
+struct ScreenLayout;
 
 class StackController : public cocos2d::Ref {
 public:
@@ -17,21 +19,43 @@ public:
 
     void init(std::shared_ptr<GameModel> model, std::shared_ptr<UndoManager> undoMgr, GameController* mainController);
 
-    // õ GameView* class GameView;
-    void initView(GameView* gameView);
+    // 这里用到了 GameView*，所以上面必须有 class GameView;
+    // deferredSteps 不为空时，卡牌视图的创建被拆成独立步骤追加进去，由 GameController 分帧执行
+    // restored 为 true 时模型来自存档：不再发牌，按模型中已有的备用堆顺序和位置创建视图
+    void initView(GameView* gameView, std::vector<std::function<void()>>* deferredSteps = nullptr, bool restored = false);
 
     bool handleCardClick(int cardId);
-    std::shared_ptr<CardModel> getTopCard() const { return _topStackCard; }
-    void setTopCard(std::shared_ptr<CardModel> card);
+
+    // 底牌堆顶部的卡牌（数据保存在 GameModel::topCardId 中）
+    std::shared_ptr<CardModel> getTopCard() const { return _gameModel ? _gameModel->getTopCard() : nullptr; }
+
+    // 屏幕布局变化时更新备用堆 / 底牌堆 / 角标锚点
+    void applyLayout(const ScreenLayout& layout);
 
 private:
     std::shared_ptr<GameModel> _gameModel;
     std::shared_ptr<UndoManager> _undoManager;
     GameController* _mainController;
 
-    std::shared_ptr<CardModel> _topStackCard;
+    // 为备用堆底部尚未创建视图的牌补建视图，使堆中可见的视图保持 kMaxStockViews 张
+    void materializeBuriedCards();
+
+    // 读档：按模型中的备用堆顺序重建视图（不发牌）
+    void restoreView(const std::function<void(const std::shared_ptr<CardModel>&)>& createView);
+
+    // 创建单张卡牌视图并绑定点击回调
+    void createCardView(const std::shared_ptr<CardModel>& card);
+
     cocos2d::Vec2 _stockPos;
     cocos2d::Vec2 _activePos;
+    cocos2d::Vec2 _stockBadgePos;
+
+    GameView* _gameView;
+
+    // 备用堆（不含初始底牌），从底到顶排列
+    std::vector<std::shared_ptr<CardModel>> _stockCards;
+    // _stockCards 中前 _buriedCount 张还没有创建视图
+    int _buriedCount;
 };
 
 #endif // STACK_CONTROLLER_H
\ No newline at end of file
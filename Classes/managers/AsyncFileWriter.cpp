@@ -0,0 +1,312 @@
+#include "managers/AsyncFileWriter.h"
+#include "utils/CoreLog.h"
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+const AsyncFileWriter::ChannelId AsyncFileWriter::INVALID_CHANNEL;
+const size_t AsyncFileWriter::MAX_CHANNELS;
+
+namespace {
+    // 中间缓冲的"有新数据"标记（低两位为缓冲下标）
+    const uint8_t kDirtyFlag = 0x4;
+    const uint8_t kIndexMask = 0x3;
+
+    bool syncFile(FILE* file) {
+        if (fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        // Windows 的 rename 不覆盖已存在的文件
+        std::remove(to.c_str());
+#endif
+        return std::rename(from.c_str(), to.c_str()) == 0;
+    }
+}
+
+/**
+ * @brief 一个文件通道
+ * @details 写入方只访问 back / tail，IO 线程只访问 front / head / file，两者通过原子变量交接
+ */
+struct AsyncFileWriter::Channel {
+    std::string path;
+    std::string tempPath;
+    FileWriteMode mode = FileWriteMode::REPLACE;
+    std::atomic<uint32_t> pendingWrites;    // 上次落盘以来的写入次数（用于统计合并）
+
+    // REPLACE：三缓冲
+    std::vector<uint8_t> buffers[3];
+    size_t capacity = 0;
+    uint8_t back = 0;                       // 写入方持有
+    std::atomic<uint8_t> middle;            // 交接缓冲（下标 | kDirtyFlag）
+    uint8_t front = 2;                      // IO 线程持有
+
+    // APPEND：环形字节缓冲；head / tail 之间留出一条缓存行，避免写入方与 IO 线程伪共享
+    // （通道在堆上分配，C++11 的 new 不保证 alignas(64)，这里用填充代替）
+    std::vector<uint8_t> ring;
+    size_t mask = 0;
+    char padding0[64];
+    std::atomic<size_t> head;               // IO 线程推进
+    char padding1[64];
+    std::atomic<size_t> tail;               // 写入方推进
+    char padding2[64];
+
+    // IO 线程
+    FILE* file = nullptr;                   // APPEND 文件保持打开
+    bool needsSync = false;
+
+    Channel() : pendingWrites(0), middle(1), head(0), tail(0) {}
+};
+
+AsyncFileWriter::AsyncFileWriter(const Config& config)
+    : _config(config)
+    , _channelCount(0)
+    , _flushRequested(false)
+    , _stopping(false)
+    , _stopped(false)
+    , _writes(0)
+    , _coalesced(0)
+    , _rejected(0)
+    , _fileWrites(0)
+    , _bytesWritten(0)
+    , _syncs(0)
+    , _errors(0)
+{
+    _thread = std::thread(&AsyncFileWriter::ioLoop, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    shutdown();
+}
+
+AsyncFileWriter::ChannelId AsyncFileWriter::openChannel(const std::string& path, FileWriteMode mode, size_t capacity) {
+    if (_stopping.load()) return INVALID_CHANNEL;
+
+    size_t count = _channelCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (_channels[i]->path == path) return (ChannelId)i;
+    }
+    if (count >= MAX_CHANNELS) return INVALID_CHANNEL;
+
+    // ========== 预先分配全部缓冲，之后的 write 不再分配内存 ==========
+    std::unique_ptr<Channel> channel(new Channel());
+    channel->path = path;
+    channel->tempPath = path + ".tmp";
+    channel->mode = mode;
+    if (mode == FileWriteMode::REPLACE) {
+        channel->capacity = capacity;
+        for (auto& buffer : channel->buffers) buffer.reserve(capacity);
+    }
+    else {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        channel->ring.resize(size);
+        channel->mask = size - 1;
+    }
+
+    // 先放好通道再公布数量，IO 线程看到的通道都是完整的
+    _channels[count] = std::move(channel);
+    _channelCount.store(count + 1, std::memory_order_release);
+    return (ChannelId)count;
+}
+
+bool AsyncFileWriter::write(ChannelId id, const void* data, size_t size) {
+    if (id < 0 || (size_t)id >= _channelCount.load(std::memory_order_acquire) || _stopping.load(std::memory_order_relaxed)) {
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Channel& channel = *_channels[id];
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    if (channel.mode == FileWriteMode::REPLACE) {
+        // ========== REPLACE：填写自己的缓冲，与中间缓冲交换 ==========
+        if (size > channel.capacity) {
+            _rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        channel.buffers[channel.back].assign(bytes, bytes + size);
+        channel.pendingWrites.fetch_add(1, std::memory_order_relaxed);
+        uint8_t previous = channel.middle.exchange((uint8_t)(channel.back | kDirtyFlag), std::memory_order_acq_rel);
+        channel.back = previous & kIndexMask;
+    }
+    else {
+        // ========== APPEND：拷贝到环形缓冲的空闲区域（可能分两段） ==========
+        size_t tail = channel.tail.load(std::memory_order_relaxed);
+        size_t head = channel.head.load(std::memory_order_acquire);
+        size_t capacity = channel.mask + 1;
+        if (capacity - (tail - head) < size) {
+            _rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        size_t offset = tail & channel.mask;
+        size_t first = std::min(size, capacity - offset);
+        memcpy(&channel.ring[offset], bytes, first);
+        if (first < size) memcpy(&channel.ring[0], bytes + first, size - first);
+        channel.pendingWrites.fetch_add(1, std::memory_order_relaxed);
+        channel.tail.store(tail + size, std::memory_order_release);
+    }
+    _writes.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncFileWriter::requestFlush() {
+    _flushRequested.store(true, std::memory_order_release);
+    _wake.notify_one();
+}
+
+void AsyncFileWriter::shutdown() {
+    if (_stopped) return;
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping.store(true);
+    }
+    _wake.notify_one();
+    _thread.join();
+    _stopped = true;
+}
+
+AsyncFileWriter::Stats AsyncFileWriter::getStats() const {
+    Stats stats;
+    stats.writes = _writes.load(std::memory_order_relaxed);
+    stats.coalesced = _coalesced.load(std::memory_order_relaxed);
+    stats.rejected = _rejected.load(std::memory_order_relaxed);
+    stats.fileWrites = _fileWrites.load(std::memory_order_relaxed);
+    stats.bytesWritten = _bytesWritten.load(std::memory_order_relaxed);
+    stats.syncs = _syncs.load(std::memory_order_relaxed);
+    stats.errors = _errors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AsyncFileWriter::ioLoop() {
+    PROFILE_THREAD_NAME("file io");
+    auto lastSync = std::chrono::steady_clock::now();
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wake.wait_for(lock, std::chrono::milliseconds(_config.coalesceWindowMs), [this]() {
+                return _flushRequested.load(std::memory_order_acquire) || _stopping.load();
+                });
+        }
+        _flushRequested.store(false, std::memory_order_relaxed);
+        bool stopping = _stopping.load();
+
+        // ========== 批量 fsync：到达间隔或关闭时同步所有追加过的文件 ==========
+        bool syncNow = stopping;
+        if (_config.syncIntervalMs > 0) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastSync >= std::chrono::milliseconds(_config.syncIntervalMs)) {
+                syncNow = true;
+                lastSync = now;
+            }
+        }
+        processChannels(syncNow);
+        if (stopping) break;
+    }
+
+    size_t count = _channelCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (_channels[i]->file) {
+            fclose(_channels[i]->file);
+            _channels[i]->file = nullptr;
+        }
+    }
+}
+
+void AsyncFileWriter::processChannels(bool syncNow) {
+    PROFILE_ZONE("AsyncFileWriter::processChannels");
+    size_t count = _channelCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        Channel& channel = *_channels[i];
+        bool written = channel.mode == FileWriteMode::REPLACE ? writeReplace(channel) : writeAppend(channel);
+        if (written) {
+            uint32_t merged = channel.pendingWrites.exchange(0, std::memory_order_relaxed);
+            if (merged > 1) _coalesced.fetch_add(merged - 1, std::memory_order_relaxed);
+        }
+
+        // REPLACE 在改名前已经同步；APPEND 按配置立即或批量同步
+        bool sync = _config.syncIntervalMs == 0 || syncNow;
+        if (channel.needsSync && sync && _config.syncIntervalMs >= 0) {
+            if (syncFile(channel.file)) _syncs.fetch_add(1, std::memory_order_relaxed);
+            else _errors.fetch_add(1, std::memory_order_relaxed);
+            channel.needsSync = false;
+        }
+    }
+}
+
+bool AsyncFileWriter::writeReplace(Channel& channel) {
+    if (!(channel.middle.load(std::memory_order_acquire) & kDirtyFlag)) return false;
+    uint8_t previous = channel.middle.exchange(channel.front, std::memory_order_acq_rel);
+    channel.front = previous & kIndexMask;
+    const std::vector<uint8_t>& data = channel.buffers[channel.front];
+
+    // ========== 写临时文件，同步后改名：中途失败时旧文件保持完整 ==========
+    FILE* file = fopen(channel.tempPath.c_str(), "wb");
+    bool ok = file != nullptr;
+    if (ok && !data.empty()) ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    if (ok && _config.syncIntervalMs >= 0) {
+        ok = syncFile(file);
+        if (ok) _syncs.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (file && fclose(file) != 0) ok = false;
+    if (ok) ok = replaceFile(channel.tempPath, channel.path);
+
+    if (!ok) {
+        _errors.fetch_add(1, std::memory_order_relaxed);
+        CORE_LOG("AsyncFileWriter: failed to write %s", channel.path.c_str());
+        return false;
+    }
+    _fileWrites.fetch_add(1, std::memory_order_relaxed);
+    _bytesWritten.fetch_add(data.size(), std::memory_order_relaxed);
+    return true;
+}
+
+bool AsyncFileWriter::writeAppend(Channel& channel) {
+    size_t head = channel.head.load(std::memory_order_relaxed);
+    size_t tail = channel.tail.load(std::memory_order_acquire);
+    if (head == tail) return false;
+
+    if (!channel.file) {
+        channel.file = fopen(channel.path.c_str(), "ab");
+        if (!channel.file) {
+            _errors.fetch_add(1, std::memory_order_relaxed);
+            CORE_LOG("AsyncFileWriter: failed to open %s", channel.path.c_str());
+            // 丢弃这批数据，避免环形缓冲一直满着拒绝后续写入
+            channel.head.store(tail, std::memory_order_release);
+            return false;
+        }
+    }
+
+    // ========== 窗口内的全部追加数据一次写出（环形缓冲回绕时分两段） ==========
+    size_t size = tail - head;
+    size_t capacity = channel.mask + 1;
+    size_t offset = head & channel.mask;
+    size_t first = std::min(size, capacity - offset);
+    bool ok = fwrite(&channel.ring[offset], 1, first, channel.file) == first;
+    if (ok && first < size) ok = fwrite(&channel.ring[0], 1, size - first, channel.file) == size - first;
+    if (ok) ok = fflush(channel.file) == 0;
+    channel.head.store(tail, std::memory_order_release);
+
+    if (!ok) {
+        _errors.fetch_add(1, std::memory_order_relaxed);
+        CORE_LOG("AsyncFileWriter: failed to append to %s", channel.path.c_str());
+        return false;
+    }
+    channel.needsSync = true;
+    _fileWrites.fetch_add(1, std::memory_order_relaxed);
+    _bytesWritten.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,131 @@
+#ifndef ASYNC_FILE_WRITER_H
+#define ASYNC_FILE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 文件通道的写入方式
+ */
+enum class FileWriteMode : uint8_t {
+    REPLACE,    // 每次写入整个文件（存档）：窗口内的多次写入只保留最后一次，先写临时文件再改名
+    APPEND      // 追加到文件末尾（日志、操作流水）：窗口内的多次写入合并为一次追加
+};
+
+/**
+ * @brief 后台文件写入器（不依赖引擎）
+ * 职责：所有磁盘写入集中到一个专用 IO 线程，调用方只把数据交给内存中的通道，不等待磁盘
+ *
+ * @details
+ * - 通道：每个文件在启动时 openChannel 一次，预先分配好缓冲；之后的 write 只做一次内存拷贝，
+ *   不分配内存、不加锁、不触发系统调用
+ *   - REPLACE：三缓冲。写入方填写自己的缓冲后与"中间缓冲"原子交换，IO 线程取走中间缓冲写盘；
+ *     IO 线程来不及写的旧内容直接被新内容替换（合并）
+ *   - APPEND：单生产者单消费者的环形字节缓冲。空间不足时本次写入被拒绝（返回 false），不会阻塞
+ * - 合并窗口：IO 线程每 coalesceWindowMs 检查一次所有通道，窗口内同一文件的多次写入只落盘一次；
+ *   requestFlush 立即唤醒 IO 线程（例如应用切到后台时）
+ * - fsync 批量化：
+ *   - syncIntervalMs < 0：从不 fsync，交给系统回写
+ *   - syncIntervalMs = 0：每次落盘后立即 fsync
+ *   - syncIntervalMs > 0：追加的文件积累到间隔后一起 fsync；REPLACE 的临时文件在改名前总是 fsync，
+ *     保证断电后看到的是完整的旧文件或完整的新文件
+ * - 关闭：shutdown（或析构）把所有通道中尚未落盘的数据写完并 fsync 后结束 IO 线程
+ *
+ * @note 每个通道同一时刻只能有一个线程调用 write（不同通道可以在不同线程写入）；
+ *       openChannel 只能在主线程调用
+ * @note 与其它管理器一样由 AppDelegate 创建并注入使用者，不设单例
+ */
+class AsyncFileWriter {
+public:
+    typedef int32_t ChannelId;
+    static const ChannelId INVALID_CHANNEL = -1;
+    static const size_t MAX_CHANNELS = 16;
+
+    struct Config {
+        uint32_t coalesceWindowMs = 50;     // IO 线程的检查间隔（合并窗口）
+        int32_t syncIntervalMs = 1000;      // fsync 间隔，见类说明
+    };
+
+    struct Stats {
+        uint64_t writes = 0;        // write 调用次数
+        uint64_t coalesced = 0;     // 被后来的写入合并（未单独落盘）的次数
+        uint64_t rejected = 0;      // 超出容量被拒绝的次数
+        uint64_t fileWrites = 0;    // 实际落盘次数
+        uint64_t bytesWritten = 0;  // 实际写入的字节数
+        uint64_t syncs = 0;         // fsync 次数
+        uint64_t errors = 0;        // 打开 / 写入 / 改名失败的次数
+    };
+
+    explicit AsyncFileWriter(const Config& config);
+    ~AsyncFileWriter();
+
+    /**
+     * @brief 注册一个文件通道（主线程，启动时调用）
+     * @param path 文件完整路径，所在目录需要已经存在
+     * @param mode 写入方式
+     * @param capacity REPLACE：单个文件的最大字节数；APPEND：环形缓冲大小（向上取整到 2 的幂）
+     * @return 通道已满或已经 shutdown 时返回 INVALID_CHANNEL；同一路径重复注册返回已有的通道
+     */
+    ChannelId openChannel(const std::string& path, FileWriteMode mode, size_t capacity);
+
+    /**
+     * @brief 写入数据（任意线程，同一通道单写者）
+     * @return 超出通道容量时返回 false，数据被丢弃
+     */
+    bool write(ChannelId channel, const void* data, size_t size);
+
+    // 立即唤醒 IO 线程处理所有通道（不等待写完）
+    void requestFlush();
+
+    // 写完所有通道的数据后结束 IO 线程；可以重复调用
+    void shutdown();
+
+    // 统计（任意线程，各计数单独读取，彼此之间不保证一致）
+    Stats getStats() const;
+
+private:
+    struct Channel;
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    void ioLoop();
+
+    // 处理一遍所有通道；syncNow 为 true 时 fsync 所有追加过、尚未同步的文件
+    void processChannels(bool syncNow);
+
+    // IO 线程：写一个 REPLACE 通道 / APPEND 通道的待写数据
+    bool writeReplace(Channel& channel);
+    bool writeAppend(Channel& channel);
+
+    Config _config;
+    std::unique_ptr<Channel> _channels[MAX_CHANNELS];
+    std::atomic<size_t> _channelCount;
+
+    std::thread _thread;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::atomic<bool> _flushRequested;
+    std::atomic<bool> _stopping;
+    bool _stopped;
+
+    // 写入方更新的计数
+    std::atomic<uint64_t> _writes;
+    std::atomic<uint64_t> _coalesced;
+    std::atomic<uint64_t> _rejected;
+
+    // IO 线程更新的计数
+    std::atomic<uint64_t> _fileWrites;
+    std::atomic<uint64_t> _bytesWritten;
+    std::atomic<uint64_t> _syncs;
+    std::atomic<uint64_t> _errors;
+};
+
+#endif // ASYNC_FILE_WRITER_H
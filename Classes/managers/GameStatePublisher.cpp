@@ -0,0 +1,107 @@
+#include "managers/GameStatePublisher.h"
+#include <algorithm>
+#include <limits>
+
+const size_t GameStatePublisher::MAX_READERS;
+
+GameStatePublisher::ReadGuard::ReadGuard(const GameStatePublisher& publisher)
+    : _publisher(publisher)
+    , _slot(MAX_READERS)
+    , _state(nullptr)
+{
+    // 先登记纪元，再读取当前版本（两步都是顺序一致的原子操作）：
+    // 写者替换版本之后才会扫描槽位，扫描时看不到这次登记，说明登记晚于替换，读到的一定是新版本
+    uint64_t epoch = publisher._epoch.load();
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        uint64_t expected = 0;
+        if (publisher._slots[i].epoch.compare_exchange_strong(expected, epoch)) {
+            _slot = i;
+            _state = publisher._current.load();
+            return;
+        }
+    }
+}
+
+GameStatePublisher::ReadGuard::~ReadGuard() {
+    if (_slot < MAX_READERS) {
+        _publisher._slots[_slot].epoch.store(0);
+    }
+}
+
+GameStatePublisher::GameStatePublisher()
+    : _current(nullptr)
+    , _epoch(1)
+    , _latestVersion(0)
+    , _writing(nullptr)
+    , _nextVersion(1)
+{
+    for (auto& slot : _slots) slot.epoch.store(0);
+}
+
+GameStatePublisher::~GameStatePublisher() {
+    delete _current.load();
+    delete _writing;
+    for (auto& retired : _retired) delete retired.state;
+    for (auto* state : _free) delete state;
+}
+
+PublishedGameState& GameStatePublisher::beginPublish() {
+    if (!_writing) {
+        if (!_free.empty()) {
+            _writing = _free.back();
+            _free.pop_back();
+        }
+        else {
+            _writing = new PublishedGameState();
+            _stats.buffers++;
+        }
+    }
+    return *_writing;
+}
+
+void GameStatePublisher::commitPublish() {
+    if (!_writing) return;
+
+    uint64_t version = _nextVersion++;
+    _writing->version = version;
+    PublishedGameState* previous = _current.exchange(_writing);
+    _latestVersion.store(version, std::memory_order_release);
+    _writing = nullptr;
+    _stats.published++;
+
+    if (previous) {
+        // 此后进入的读者登记的纪元都大于 epoch，不可能再拿到 previous
+        RetiredState retired;
+        retired.state = previous;
+        retired.epoch = _epoch.fetch_add(1);
+        _retired.push_back(retired);
+        _stats.maxRetired = std::max(_stats.maxRetired, _retired.size());
+    }
+    reclaim();
+}
+
+uint64_t GameStatePublisher::latestVersion() const {
+    return _latestVersion.load(std::memory_order_acquire);
+}
+
+void GameStatePublisher::reclaim() {
+    if (_retired.empty()) return;
+
+    uint64_t minActive = std::numeric_limits<uint64_t>::max();
+    for (const auto& slot : _slots) {
+        uint64_t epoch = slot.epoch.load();
+        if (epoch != 0) minActive = std::min(minActive, epoch);
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < _retired.size(); ++i) {
+        if (_retired[i].epoch < minActive) {
+            _free.push_back(_retired[i].state);
+            _stats.reclaimed++;
+        }
+        else {
+            _retired[kept++] = _retired[i];
+        }
+    }
+    _retired.resize(kept);
+}
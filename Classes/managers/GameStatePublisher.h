@@ -0,0 +1,123 @@
+#ifndef GAME_STATE_PUBLISHER_H
+#define GAME_STATE_PUBLISHER_H
+
+#include "models/GameSnapshot.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 发布给后台线程的只读游戏状态
+ * @note 发布后不再修改；snapshot 的 sessionTimeMs 与 replay 不填（它们属于主线程的会话状态）
+ */
+struct PublishedGameState {
+    uint64_t version = 0;       // 发布序号（从 1 开始递增）
+    uint64_t stateHash = 0;     // GameStateHasher 哈希
+    GameSnapshot snapshot;      // 模型、备用堆顺序与回退历史
+};
+
+/**
+ * @brief 游戏状态发布器（不依赖引擎）
+ * 职责：主线程在状态变化后发布一份不可变的状态副本，任何线程都可以无等待地读取最新发布的版本
+ *
+ * @details
+ * - 写者（只能是主线程）：beginPublish 取得一个可写缓冲并填写，commitPublish 原子地替换当前版本；
+ *   被替换的旧版本进入待回收列表
+ * - 读者（任意线程）：ReadGuard 在构造时占用一个读者槽位并登记当前纪元，随后读取当前版本；
+ *   析构时释放槽位。全程只有固定次数的原子操作，不加锁，不会被写者阻塞
+ * - 纪元回收：每次发布纪元加一；旧版本记下它被替换时的纪元 r，
+ *   只有所有正在读取的读者登记的纪元都大于 r 时才回收（此后没有读者能再拿到它）
+ * - 缓冲复用：回收的版本放入空闲列表，下次 beginPublish 直接复用（连同各 vector 的容量）；
+ *   没有读者长时间持有时，只会在两块缓冲之间交替
+ *
+ * @note 读者不要长时间持有 ReadGuard：持有期间发布的所有旧版本都无法回收
+ * @note 发布器析构前所有 ReadGuard 必须已经结束（后台任务通过 shared_ptr 持有发布器）
+ */
+class GameStatePublisher {
+public:
+    // 同时读取的读者上限；槽位用尽时 ReadGuard 为空，调用方稍后重试或放弃
+    static const size_t MAX_READERS = 32;
+
+    /**
+     * @brief 读取最新发布的状态（RAII）
+     * @details 守卫存活期间返回的状态保持有效且不变
+     */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const GameStatePublisher& publisher);
+        ~ReadGuard();
+
+        // 尚未发布过或槽位用尽时为 nullptr
+        const PublishedGameState* get() const { return _state; }
+        const PublishedGameState* operator->() const { return _state; }
+        explicit operator bool() const { return _state != nullptr; }
+
+    private:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const GameStatePublisher& _publisher;
+        size_t _slot;
+        const PublishedGameState* _state;
+    };
+
+    struct Stats {
+        uint64_t published = 0;     // 发布次数
+        uint64_t reclaimed = 0;     // 回收的旧版本数
+        size_t buffers = 0;         // 分配过的缓冲数
+        size_t maxRetired = 0;      // 同时等待回收的最大版本数
+    };
+
+    GameStatePublisher();
+    ~GameStatePublisher();
+
+    /**
+     * @brief 取得下一个版本的可写缓冲（主线程）
+     * @return 复用的缓冲可能残留旧内容，调用方需要填写全部字段（version 由 commitPublish 填写）
+     */
+    PublishedGameState& beginPublish();
+
+    // 发布 beginPublish 取得的缓冲，并回收已经没有读者的旧版本（主线程）
+    void commitPublish();
+
+    // 最新发布的版本号，尚未发布时为 0（任意线程）
+    uint64_t latestVersion() const;
+
+    // 统计（主线程）
+    const Stats& getStats() const { return _stats; }
+
+private:
+    // 读者槽位：0 表示空闲，否则为读者进入时登记的纪元；填充到一条缓存行，避免读者之间伪共享
+    // （发布器在堆上创建，C++11 的 new 不保证 alignas(64)，与 SpscQueue 一样用填充）
+    struct ReaderSlot {
+        std::atomic<uint64_t> epoch;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    // 被替换、等待回收的版本
+    struct RetiredState {
+        PublishedGameState* state;
+        uint64_t epoch;
+    };
+
+    GameStatePublisher(const GameStatePublisher&) = delete;
+    GameStatePublisher& operator=(const GameStatePublisher&) = delete;
+
+    // 回收所有读者都已离开的旧版本
+    void reclaim();
+
+    mutable ReaderSlot _slots[MAX_READERS];
+    std::atomic<PublishedGameState*> _current;
+    std::atomic<uint64_t> _epoch;
+    std::atomic<uint64_t> _latestVersion;
+
+    // 以下只由主线程访问
+    PublishedGameState* _writing;
+    std::vector<RetiredState> _retired;
+    std::vector<PublishedGameState*> _free;
+    uint64_t _nextVersion;
+    Stats _stats;
+};
+
+#endif // GAME_STATE_PUBLISHER_H
@@ -0,0 +1,45 @@
+#include "managers/InputQueueManager.h"
+#include <algorithm>
+
+InputQueueManager::InputQueueManager(size_t maxCommandsPerFrame)
+    : _maxCommandsPerFrame(std::max<size_t>(1, maxCommandsPerFrame))
+    , _head(0)
+{
+}
+
+void InputQueueManager::push(const InputCommand& cmd) {
+    if (cmd.type != InputCommandType::UNDO) {
+        // 同一张卡牌已有待处理的点击：合并（连续的 Undo 各自有效，不合并）
+        // 从后往前查找，遇到 Undo 停止：Undo 之后的重复点击是玩家有意重新出牌，不能合并
+        for (size_t i = _pending.size(); i > _head; --i) {
+            const InputCommand& pending = _pending[i - 1];
+            if (pending.type == InputCommandType::UNDO) break;
+            if (pending.type == cmd.type && pending.cardId == cmd.cardId) {
+                _stats.coalesced++;
+                return;
+            }
+        }
+    }
+    _pending.push_back(cmd);
+}
+
+size_t InputQueueManager::drain(std::vector<InputCommand>& out) {
+    out.clear();
+    size_t count = std::min(size(), _maxCommandsPerFrame);
+    out.insert(out.end(), _pending.begin() + _head, _pending.begin() + _head + count);
+    _head += count;
+
+    // 全部取空时复位，保留容量
+    if (_head == _pending.size()) {
+        _pending.clear();
+        _head = 0;
+    }
+    return count;
+}
+
+void InputQueueManager::recordBatch(size_t commandCount, double elapsedMs) {
+    _stats.batches++;
+    _stats.commands += commandCount;
+    _stats.totalBatchMs += elapsedMs;
+    _stats.maxBatchMs = std::max(_stats.maxBatchMs, elapsedMs);
+}
@@ -0,0 +1,55 @@
+#ifndef INPUT_QUEUE_MANAGER_H
+#define INPUT_QUEUE_MANAGER_H
+
+#include "models/InputCommand.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 输入队列管理器
+ * 职责：缓存触摸回调产生的 InputCommand，每帧按上限批量取出，并统计处理开销
+ *
+ * @details 
+ * - 合并：同一张卡牌的点击在被处理之前只保留一条（例如一帧内的重复触摸）；
+ *   中间隔着 Undo 的点击不合并
+ * - 限流：每帧最多取出 maxCommandsPerFrame 条，超出的留到下一帧，不丢弃
+ * - 统计：记录批次数、命令数、合并数和单帧最长处理时间
+ */
+class InputQueueManager {
+public:
+    struct Stats {
+        uint64_t batches = 0;       // 处理过的批次（帧）数
+        uint64_t commands = 0;      // 处理过的命令数
+        uint64_t coalesced = 0;     // 被合并掉的重复点击数
+        double totalBatchMs = 0.0;  // 处理耗时累计（毫秒）
+        double maxBatchMs = 0.0;    // 单帧最长处理耗时（毫秒）
+    };
+
+    explicit InputQueueManager(size_t maxCommandsPerFrame);
+
+    // 压入一条命令（重复的卡牌点击会被合并）
+    void push(const InputCommand& cmd);
+
+    // 取出本帧要处理的命令（最多 maxCommandsPerFrame 条），out 会被清空后填充
+    size_t drain(std::vector<InputCommand>& out);
+
+    // 记录一个批次的处理结果
+    void recordBatch(size_t commandCount, double elapsedMs);
+
+    // 队列中尚未处理的命令数
+    size_t size() const { return _pending.size() - _head; }
+
+    const Stats& getStats() const { return _stats; }
+
+private:
+    size_t _maxCommandsPerFrame;
+
+    // 待处理命令：[_head, size) 有效，取空后整体复位以复用内存
+    std::vector<InputCommand> _pending;
+    size_t _head;
+
+    Stats _stats;
+};
+
+#endif // INPUT_QUEUE_MANAGER_H
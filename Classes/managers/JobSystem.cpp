@@ -0,0 +1,178 @@
+#include "managers/JobSystem.h"
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    double elapsedMsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+JobSystem::JobSystem(size_t workerCount)
+    : _activeJobs(0)
+    , _stopping(false)
+    , _submitted(0)
+    , _completed(0)
+    , _cancelledJobs(0)
+    , _continuationsRun(0)
+    , _cancelledContinuations(0)
+    , _maxDrainMs(0.0)
+{
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+    _workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        _workers.push_back(std::thread(&JobSystem::workerLoop, this));
+    }
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+bool JobSystem::submit(JobPriority priority, Task work, Task continuation, std::shared_ptr<JobToken> token) {
+    Job job;
+    job.work = std::move(work);
+    job.continuation = std::move(continuation);
+    job.token = std::move(token);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) return false;
+        _queues[(size_t)priority].push_back(std::move(job));
+        _submitted++;
+    }
+    _workAvailable.notify_one();
+    return true;
+}
+
+void JobSystem::post(Task continuation, std::shared_ptr<JobToken> token) {
+    Job job;
+    job.continuation = std::move(continuation);
+    job.token = std::move(token);
+
+    std::lock_guard<std::mutex> lock(_continuationMutex);
+    _continuations.push_back(std::move(job));
+}
+
+size_t JobSystem::drainContinuations(double budgetMs) {
+    PROFILE_ZONE("JobSystem::drainContinuations");
+    auto start = std::chrono::steady_clock::now();
+    size_t executed = 0;
+
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(_continuationMutex);
+            if (_continuations.empty()) break;
+            job = std::move(_continuations.front());
+            _continuations.pop_front();
+            if (isCancelled(job)) {
+                _cancelledContinuations++;
+                continue;
+            }
+            _continuationsRun++;
+        }
+
+        // 在锁外执行，回调中可以继续提交任务或投递回调
+        job.continuation();
+        executed++;
+
+        if (elapsedMsSince(start) >= budgetMs) break;
+    }
+
+    if (executed > 0) {
+        double elapsedMs = elapsedMsSince(start);
+        std::lock_guard<std::mutex> lock(_continuationMutex);
+        _maxDrainMs = std::max(_maxDrainMs, elapsedMs);
+    }
+    return executed;
+}
+
+void JobSystem::waitIdle() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() {
+        if (_activeJobs > 0) return false;
+        for (const auto& queue : _queues) {
+            if (!queue.empty()) return false;
+        }
+        return true;
+        });
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) return;
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+    for (auto& worker : _workers) worker.join();
+
+    std::lock_guard<std::mutex> lock(_continuationMutex);
+    _continuations.clear();
+}
+
+JobSystem::Stats JobSystem::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.submitted = _submitted;
+        stats.completed = _completed;
+        stats.cancelled = _cancelledJobs;
+    }
+    std::lock_guard<std::mutex> lock(_continuationMutex);
+    stats.cancelled += _cancelledContinuations;
+    stats.continuations = _continuationsRun;
+    stats.pendingContinuations = _continuations.size();
+    stats.maxDrainMs = _maxDrainMs;
+    return stats;
+}
+
+bool JobSystem::popJob(Job& out) {
+    for (auto& queue : _queues) {
+        if (!queue.empty()) {
+            out = std::move(queue.front());
+            queue.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop() {
+    PROFILE_THREAD_NAME("job worker");
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        Job job;
+        if (!popJob(job)) {
+            // 队列已空：关闭时退出，否则等待新任务
+            if (_stopping) return;
+            _workAvailable.wait(lock);
+            continue;
+        }
+
+        if (isCancelled(job)) {
+            _cancelledJobs++;
+            if (_activeJobs == 0) _idle.notify_all();
+            continue;
+        }
+
+        _activeJobs++;
+        lock.unlock();
+
+        {
+            PROFILE_ZONE("JobSystem::work");
+            job.work();
+        }
+        if (job.continuation) post(std::move(job.continuation), std::move(job.token));
+
+        lock.lock();
+        _activeJobs--;
+        _completed++;
+        if (_activeJobs == 0) _idle.notify_all();
+    }
+}
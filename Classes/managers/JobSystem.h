@@ -0,0 +1,137 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 任务优先级：工作线程总是先取高优先级队列中的任务
+ */
+enum class JobPriority : uint8_t {
+    HIGH,       // 用户正在等待的结果（存档、当前关卡需要的数据）
+    NORMAL,     // 普通后台任务
+    LOW,        // 可有可无的预取（下一关、缩略图）
+    PRIORITY_COUNT
+};
+
+/**
+ * @brief 取消令牌：多个任务可以共享同一个令牌，一次取消全部
+ * @note 取消只是标记：尚未开始的任务和尚未执行的主线程回调会被跳过，
+ *       正在执行的任务需要自己在适当的位置检查 isCancelled()
+ */
+class JobToken {
+public:
+    JobToken() : _cancelled(false) {}
+
+    void cancel() { _cancelled.store(true, std::memory_order_release); }
+    bool isCancelled() const { return _cancelled.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<bool> _cancelled;
+};
+
+/**
+ * @brief 任务系统（不依赖引擎）
+ * 职责：所有后台功能共用的固定大小线程池，以及回到主线程执行的回调队列
+ *
+ * @details
+ * - 工作线程：构造时创建，数量固定；按 HIGH -> NORMAL -> LOW 的顺序取任务
+ * - 主线程回调：任务完成后，它的 continuation 进入回调队列，由主线程调用 drainContinuations 执行；
+ *   客户端由 AppDelegate 注册到 Scheduler，每帧在时间预算内执行，避免一帧内堆积的回调造成卡顿
+ * - 结果传递：work 与 continuation 通过各自捕获的 shared_ptr 共享结果
+ * - 关闭：shutdown（或析构）后不再接受新任务，已排队且未取消的任务仍会执行完（例如存档写入），
+ *   未执行的主线程回调被丢弃
+ *
+ * @note 与其它管理器一样由 AppDelegate 创建并注入使用者，不设单例
+ */
+class JobSystem {
+public:
+    typedef std::function<void()> Task;
+
+    struct Stats {
+        uint64_t submitted = 0;         // 提交的任务数
+        uint64_t completed = 0;         // 执行完成的任务数
+        uint64_t cancelled = 0;         // 因取消而跳过的任务和回调数
+        uint64_t continuations = 0;     // 在主线程执行的回调数
+        size_t pendingContinuations = 0;// 等待执行的回调数
+        double maxDrainMs = 0.0;        // 单次 drainContinuations 的最大耗时（毫秒）
+    };
+
+    // workerCount 为 0 时使用硬件线程数 - 1（至少 1 个），给主线程留出一个核
+    explicit JobSystem(size_t workerCount);
+    ~JobSystem();
+
+    /**
+     * @brief 提交任务
+     * @param priority 优先级
+     * @param work 在工作线程执行
+     * @param continuation work 完成后在主线程执行，可为空
+     * @param token 取消令牌，可为空
+     * @return 已经 shutdown 时返回 false，任务不会执行
+     */
+    bool submit(JobPriority priority, Task work, Task continuation = nullptr, std::shared_ptr<JobToken> token = nullptr);
+
+    // 直接投递一个主线程回调（任何线程都可以调用）
+    void post(Task continuation, std::shared_ptr<JobToken> token = nullptr);
+
+    /**
+     * @brief 在主线程执行回调，直到队列为空或用完时间预算
+     * @param budgetMs 时间预算（毫秒）；队列不为空时至少执行一个，保证进度
+     * @return 执行的回调数
+     */
+    size_t drainContinuations(double budgetMs);
+
+    // 阻塞直到所有已提交的任务执行完（不包括主线程回调）
+    void waitIdle();
+
+    // 停止接受新任务，执行完已排队的任务后结束工作线程；可以重复调用
+    void shutdown();
+
+    size_t workerCount() const { return _workers.size(); }
+
+    Stats getStats() const;
+
+private:
+    struct Job {
+        Task work;
+        Task continuation;
+        std::shared_ptr<JobToken> token;
+    };
+
+    static bool isCancelled(const Job& job) { return job.token && job.token->isCancelled(); }
+
+    void workerLoop();
+
+    // 取出优先级最高的任务（调用方持有 _mutex）
+    bool popJob(Job& out);
+
+    std::vector<std::thread> _workers;
+
+    // 任务队列：_mutex 保护以下成员
+    mutable std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _idle;
+    std::deque<Job> _queues[(size_t)JobPriority::PRIORITY_COUNT];
+    size_t _activeJobs;
+    bool _stopping;
+    uint64_t _submitted;
+    uint64_t _completed;
+    uint64_t _cancelledJobs;
+
+    // 主线程回调队列：_continuationMutex 保护以下成员
+    mutable std::mutex _continuationMutex;
+    std::deque<Job> _continuations;
+    uint64_t _continuationsRun;
+    uint64_t _cancelledContinuations;
+    double _maxDrainMs;
+};
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,102 @@
+#include "managers/LoopbackServer.h"
+#include "services/GameLogicService.h"
+#include "services/MoveProtocol.h"
+
+namespace {
+    AckStatus toAckStatus(SessionMoveStatus status) {
+        switch (status) {
+        case SessionMoveStatus::ACCEPTED: return AckStatus::ACCEPTED;
+        case SessionMoveStatus::REJECTED: return AckStatus::REJECTED;
+        default: return AckStatus::NO_SESSION;
+        }
+    }
+}
+
+LoopbackServer::LoopbackServer(uint32_t latencyTicks)
+    : _latencyTicks(latencyTicks)
+    , _now(0)
+{
+}
+
+bool LoopbackServer::addLevel(uint32_t levelId, const LevelConfig& config) {
+    return _host.addLevel(levelId, config);
+}
+
+void LoopbackServer::send(const uint8_t* data, size_t size) {
+    InFlightFrame frame;
+    frame.deliverAt = _now + _latencyTicks;
+    frame.data.assign(data, data + size);
+    _toServer.push_back(std::move(frame));
+}
+
+void LoopbackServer::tick() {
+    // 先处理本时刻之前送达的帧，回复经过同样的延迟送回客户端
+    while (!_toServer.empty() && _toServer.front().deliverAt <= _now) {
+        InFlightFrame reply;
+        reply.deliverAt = _now + _latencyTicks;
+        handleFrame(_toServer.front().data, reply.data);
+        _toServer.pop_front();
+        if (!reply.data.empty()) {
+            _stats.framesOut++;
+            _stats.bytesOut += reply.data.size();
+            _toClient.push_back(std::move(reply));
+        }
+    }
+    _now++;
+}
+
+void LoopbackServer::receive(std::vector<std::vector<uint8_t>>& out) {
+    while (!_toClient.empty() && _toClient.front().deliverAt < _now) {
+        out.push_back(std::move(_toClient.front().data));
+        _toClient.pop_front();
+    }
+}
+
+void LoopbackServer::handleFrame(const std::vector<uint8_t>& frame, std::vector<uint8_t>& reply) {
+    _stats.framesIn++;
+    _stats.bytesIn += frame.size();
+
+    FrameType type;
+    if (!MoveProtocol::peekType(frame.data(), frame.size(), type)) {
+        _stats.badFrames++;
+        return;
+    }
+
+    switch (type) {
+    case FrameType::JOIN: {
+        // ========== 加入：创建会话；规则版本或初始状态与客户端不一致时拒绝 ==========
+        JoinFrame join;
+        if (!MoveProtocol::decode(frame.data(), frame.size(), join)) break;
+        JoinedFrame joined;
+        if (join.ruleSet == GameLogicService::RULE_SET_VERSION) {
+            joined.sessionId = _host.createSession(join.levelId);
+            joined.initialHash = _host.getStateHash(joined.sessionId);
+            if (joined.sessionId != 0 && joined.initialHash != join.initialHash) {
+                _host.destroySession(joined.sessionId);
+                joined.sessionId = 0;
+            }
+        }
+        MoveProtocol::encode(joined, reply);
+        return;
+    }
+    case FrameType::MOVE_BATCH: {
+        // ========== 一批操作：逐步执行，整批确认 ==========
+        if (!MoveProtocol::decode(frame.data(), frame.size(), _moveBatch)) break;
+        _ackBatch.sessionId = _moveBatch.sessionId;
+        _ackBatch.firstSeq = _moveBatch.firstSeq;
+        _ackBatch.acks.resize(_moveBatch.moves.size());
+        for (size_t i = 0; i < _moveBatch.moves.size(); ++i) {
+            const ProtocolMove& move = _moveBatch.moves[i];
+            SessionMoveResult result = _host.applyMove(_moveBatch.sessionId, move.type, move.cardId);
+            _ackBatch.acks[i].status = toAckStatus(result.status);
+            _ackBatch.acks[i].stateHash = (uint32_t)result.stateHash;
+        }
+        _stats.moves += _moveBatch.moves.size();
+        MoveProtocol::encode(_ackBatch, reply);
+        return;
+    }
+    default:
+        break;
+    }
+    _stats.badFrames++;
+}
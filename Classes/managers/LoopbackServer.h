@@ -0,0 +1,74 @@
+#ifndef LOOPBACK_SERVER_H
+#define LOOPBACK_SERVER_H
+
+#include "configs/models/LevelConfig.h"
+#include "managers/SessionHost.h"
+#include "models/ProtocolModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief 本地回环服务端（测试与离线调试用的服务端替身，不依赖引擎）
+ * 职责：在客户端进程内扮演权威服务端：接收 MoveProtocol 帧，用 SessionHost 校验并执行，回复确认帧
+ *
+ * @details
+ * - 传输：两个方向各一条帧队列，每帧附带送达时刻；tick 推进一个时刻，
+ *   latencyTicks 模拟单程延迟（往返 2 * latencyTicks 个时刻），0 表示同一个 tick 内往返
+ * - 处理：与真实服务端相同的逻辑——JOIN 创建会话并核对初始哈希（不一致时拒绝），MOVE_BATCH 逐步执行并整批确认
+ * - 线程：与 SessionHost 一样不加锁，由调用方所在的线程驱动（客户端每帧调用一次 tick）
+ */
+class LoopbackServer {
+public:
+    struct Stats {
+        uint64_t framesIn = 0;      // 收到的帧数
+        uint64_t framesOut = 0;     // 发出的帧数
+        uint64_t bytesIn = 0;       // 收到的字节数
+        uint64_t bytesOut = 0;      // 发出的字节数
+        uint64_t moves = 0;         // 处理的操作数
+        uint64_t badFrames = 0;     // 无法解码的帧数
+    };
+
+    explicit LoopbackServer(uint32_t latencyTicks);
+
+    // 注册关卡（真实服务端从关卡包加载；回环服务端由客户端在加载关卡时一并注册）
+    bool addLevel(uint32_t levelId, const LevelConfig& config);
+
+    // 客户端发出一帧
+    void send(const uint8_t* data, size_t size);
+
+    // 推进一个时刻：处理已送达的客户端帧，回复帧进入发往客户端的队列
+    void tick();
+
+    // 取出已送达客户端的帧（追加到 out 末尾）
+    void receive(std::vector<std::vector<uint8_t>>& out);
+
+    SessionHost& getHost() { return _host; }
+
+    const Stats& getStats() const { return _stats; }
+
+private:
+    struct InFlightFrame {
+        uint64_t deliverAt;
+        std::vector<uint8_t> data;
+    };
+
+    // 处理一帧客户端数据，需要回复时写入 reply
+    void handleFrame(const std::vector<uint8_t>& frame, std::vector<uint8_t>& reply);
+
+    SessionHost _host;
+    uint32_t _latencyTicks;
+    uint64_t _now;
+
+    std::deque<InFlightFrame> _toServer;
+    std::deque<InFlightFrame> _toClient;
+
+    // 解码缓冲，跨帧复用容量
+    MoveBatchFrame _moveBatch;
+    AckBatchFrame _ackBatch;
+
+    Stats _stats;
+};
+
+#endif // LOOPBACK_SERVER_H
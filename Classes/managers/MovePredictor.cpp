@@ -0,0 +1,106 @@
+#include "managers/MovePredictor.h"
+#include "services/GameLogicService.h"
+#include "services/GameStateHasher.h"
+#include "services/MoveService.h"
+#include <algorithm>
+
+MovePredictor::MovePredictor()
+    : _nextSeq(0)
+    , _desynced(false)
+{
+}
+
+void MovePredictor::beginMove(const GameModel& model, const UndoManager& undoManager, InputCommandType type, int32_t cardId) {
+    _staged = PendingMove();
+    _staged.type = type;
+    _staged.cardId = cardId;
+    captureRevertInfo(model, undoManager, _staged);
+}
+
+uint32_t MovePredictor::commitMove(uint64_t stateHash) {
+    _staged.seq = _nextSeq++;
+    _staged.predictedHash = (uint32_t)stateHash;
+    _pending.push_back(_staged);
+
+    _stats.predicted++;
+    _stats.maxPending = std::max(_stats.maxPending, _pending.size());
+    return _staged.seq;
+}
+
+MovePredictor::AckResult MovePredictor::applyAck(GameModel& model, UndoManager& undoManager, uint32_t seq, const MoveAck& ack) {
+    if (_desynced) return AckResult::DESYNC;
+
+    // ========== 序号必须与最旧的未确认操作对应 ==========
+    if (_pending.empty() || _pending.front().seq != seq || ack.status == AckStatus::NO_SESSION) {
+        rollbackAll(model, undoManager);
+        _pending.clear();
+        _desynced = true;
+        return AckResult::DESYNC;
+    }
+
+    // ========== 与预测一致：确认 ==========
+    const PendingMove& front = _pending.front();
+    bool serverAccepted = ack.status == AckStatus::ACCEPTED;
+    if (serverAccepted == !front.rejectedLocally && (!serverAccepted || ack.stateHash == front.predictedHash)) {
+        _pending.pop_front();
+        _stats.confirmed++;
+        return AckResult::CONFIRMED;
+    }
+
+    // ========== 服务端接受了与预测不同的结果：状态已分叉 ==========
+    rollbackAll(model, undoManager);
+    if (serverAccepted) {
+        _pending.clear();
+        _desynced = true;
+        return AckResult::DESYNC;
+    }
+
+    // ========== 服务端拒绝：丢弃这一步，其后的操作从已确认的状态重新执行 ==========
+    _pending.pop_front();
+    _stats.rollbacks++;
+    for (auto& move : _pending) {
+        captureRevertInfo(model, undoManager, move);
+        move.rejectedLocally = !MoveService::applyCommand(model, undoManager, move.type, move.cardId);
+        move.predictedHash = (uint32_t)GameStateHasher::hash(model, undoManager.size());
+        _stats.replayed++;
+    }
+    return AckResult::ROLLED_BACK;
+}
+
+void MovePredictor::captureRevertInfo(const GameModel& model, const UndoManager& undoManager, PendingMove& move) {
+    if (move.type != InputCommandType::UNDO || !undoManager.canUndo()) return;
+
+    move.undone = undoManager.getHistory().back();
+    move.topCardId = model.topCardId;
+    auto card = model.getCardById(move.undone.cardId);
+    if (card) {
+        move.position = card->getPosition();
+        move.state = card->getState();
+        move.zIndex = card->getZIndex();
+    }
+}
+
+void MovePredictor::revert(GameModel& model, UndoManager& undoManager, const PendingMove& move) {
+    if (move.rejectedLocally) return;
+
+    if (move.type != InputCommandType::UNDO) {
+        // 普通操作：执行时压入了回退记录，直接撤回
+        UndoCommand cmd;
+        MoveService::undo(model, undoManager, cmd);
+        return;
+    }
+
+    // 撤销操作：把被撤销的记录压回去，恢复卡牌和底牌堆
+    auto card = model.getCardById(move.undone.cardId);
+    if (!card) return;
+    undoManager.pushCommand(move.undone);
+    GameLogicService::applyMove(card.get(), move.position, move.zIndex);
+    GameLogicService::applyStateChange(card.get(), move.state);
+    model.topCardId = move.topCardId;
+}
+
+void MovePredictor::rollbackAll(GameModel& model, UndoManager& undoManager) {
+    for (auto it = _pending.rbegin(); it != _pending.rend(); ++it) {
+        revert(model, undoManager, *it);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef MOVE_PREDICTOR_H
+#define MOVE_PREDICTOR_H
+
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/ProtocolModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/**
+ * @brief 客户端预测管理器（服务端权威模式）
+ * 职责：记录已在本地乐观执行、尚未被服务端确认的操作；确认不一致时借助回退机制回滚并重新预测
+ *
+ * @details 使用流程：
+ * 1. beginMove：执行一步之前调用，记录回滚这一步需要的信息
+ * 2. commitMove：本地执行成功后调用，得到这一步的序号（随 MOVE_BATCH 发出）；执行失败则不调用
+ * 3. applyAck：收到服务端的确认时按序号逐条调用
+ *    - 结果与预测一致：这一步转为已确认
+ *    - 服务端拒绝：从最新一步开始逐步回滚全部未确认的操作，丢弃被拒绝的这一步，
+ *      再把其后的操作按原顺序重新执行（服务端会对它们做同样的处理）
+ *    - 服务端接受但状态哈希不同：双方状态已经分叉，回滚后标记为失步，不再继续预测
+ *
+ * @note 回滚：普通操作由 MoveService::undo 撤回（它们执行时压入了回退记录）；
+ *       撤销操作本身没有回退记录，beginMove 时保存被撤销的那条记录和卡牌撤销前的状态，
+ *       回滚时把记录压回回退管理器并恢复卡牌
+ */
+class MovePredictor {
+public:
+    enum class AckResult {
+        CONFIRMED,      // 与预测一致
+        ROLLED_BACK,    // 服务端拒绝，已回滚并重新预测，调用方需要把视图同步到模型
+        DESYNC          // 状态分叉或序号不对应，已回滚到最后确认的状态并清空未确认的操作
+    };
+
+    struct Stats {
+        uint64_t predicted = 0;     // 本地预测执行的操作数
+        uint64_t confirmed = 0;     // 被确认的操作数
+        uint64_t rollbacks = 0;     // 回滚次数
+        uint64_t replayed = 0;      // 回滚后重新执行的操作数
+        size_t maxPending = 0;      // 同时等待确认的最大操作数
+    };
+
+    MovePredictor();
+
+    // 执行一步之前调用
+    void beginMove(const GameModel& model, const UndoManager& undoManager, InputCommandType type, int32_t cardId);
+
+    // 本地执行成功后调用，stateHash 为执行后的状态哈希
+    // @return 这一步的序号
+    uint32_t commitMove(uint64_t stateHash);
+
+    // 处理服务端对序号 seq 的确认
+    AckResult applyAck(GameModel& model, UndoManager& undoManager, uint32_t seq, const MoveAck& ack);
+
+    // 等待确认的操作数
+    size_t pendingCount() const { return _pending.size(); }
+
+    // 是否已经失步（之后 beginMove / commitMove 仍可调用，但不会再被确认）
+    bool isDesynced() const { return _desynced; }
+
+    const Stats& getStats() const { return _stats; }
+
+private:
+    // 一步未确认的操作
+    struct PendingMove {
+        uint32_t seq = 0;
+        InputCommandType type = InputCommandType::UNDO;
+        int32_t cardId = -1;
+        uint32_t predictedHash = 0;
+        bool rejectedLocally = false;   // 重新预测时本地已判定为非法（服务端也会拒绝）
+
+        // 仅撤销操作使用：被撤销的记录，以及撤销前卡牌和底牌堆的状态
+        UndoCommand undone;
+        Vector2 position;
+        CardState state = CardState::FACE_DOWN;
+        int zIndex = 0;
+        int topCardId = -1;
+    };
+
+    // 记录回滚 move 所需的信息（执行之前调用）
+    static void captureRevertInfo(const GameModel& model, const UndoManager& undoManager, PendingMove& move);
+
+    // 撤回一步已执行的操作
+    static void revert(GameModel& model, UndoManager& undoManager, const PendingMove& move);
+
+    // 从最新一步开始回滚全部未确认的操作
+    void rollbackAll(GameModel& model, UndoManager& undoManager);
+
+    std::deque<PendingMove> _pending;   // 按序号排列，队首最旧
+    PendingMove _staged;                // beginMove 记录、等待 commitMove 的一步
+    uint32_t _nextSeq;
+    bool _desynced;
+    Stats _stats;
+};
+
+#endif // MOVE_PREDICTOR_H
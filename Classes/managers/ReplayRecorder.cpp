@@ -0,0 +1,34 @@
+#include "managers/ReplayRecorder.h"
+#include "services/ReplayCodec.h"
+
+ReplayRecorder::ReplayRecorder()
+    : _recording(false)
+{
+}
+
+void ReplayRecorder::begin(uint32_t levelId, uint32_t seed, uint16_t ruleSet, uint64_t initialHash) {
+    _replay = ReplayData();
+    _replay.levelId = levelId;
+    _replay.seed = seed;
+    _replay.ruleSet = ruleSet;
+    _replay.initialHash = initialHash;
+    _recording = true;
+}
+
+void ReplayRecorder::resume(const ReplayData& replay) {
+    _replay = replay;
+    _replay.finalHash = 0;
+    _recording = true;
+}
+
+void ReplayRecorder::record(InputCommandType type, int32_t cardId, uint32_t timeMs, uint64_t stateHash) {
+    if (!_recording) return;
+    _replay.moves.push_back(ReplayMove(type, cardId, timeMs, (uint32_t)stateHash));
+}
+
+void ReplayRecorder::finish(uint64_t finalHash, std::vector<uint8_t>& out) {
+    out.clear();
+    _replay.finalHash = finalHash;
+    _recording = false;
+    ReplayCodec::encode(_replay, out);
+}
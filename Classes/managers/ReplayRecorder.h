@@ -0,0 +1,47 @@
+#ifndef REPLAY_RECORDER_H
+#define REPLAY_RECORDER_H
+
+#include "models/ReplayModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 回放录制器
+ * 职责：在一局游戏中逐步记录被接受的输入命令，结束时输出编码好的回放
+ *
+ * @details 
+ * - begin：写入关卡ID、种子、规则版本和初始状态哈希
+ * - resume：读档后接着存档时已录制的部分继续录制
+ * - record：每执行成功一条命令调用一次，附带时间戳和执行后的状态哈希
+ * - finish：写入最终哈希并编码为二进制（ReplayCodec）
+ */
+class ReplayRecorder {
+public:
+    ReplayRecorder();
+
+    // 开始录制新的一局（清空之前的记录）
+    void begin(uint32_t levelId, uint32_t seed, uint16_t ruleSet, uint64_t initialHash);
+
+    // 从存档中继续录制一局（保留已记录的操作，之后的操作接在后面）
+    void resume(const ReplayData& replay);
+
+    // 记录一步操作
+    void record(InputCommandType type, int32_t cardId, uint32_t timeMs, uint64_t stateHash);
+
+    // 结束录制，编码结果写入 out（out 会被清空）
+    void finish(uint64_t finalHash, std::vector<uint8_t>& out);
+
+    bool isRecording() const { return _recording; }
+
+    // 已记录的操作数
+    size_t moveCount() const { return _replay.moves.size(); }
+
+    const ReplayData& getReplay() const { return _replay; }
+
+private:
+    ReplayData _replay;
+    bool _recording;
+};
+
+#endif // REPLAY_RECORDER_H
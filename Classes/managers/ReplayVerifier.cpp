@@ -0,0 +1,184 @@
+#include "managers/ReplayVerifier.h"
+#include "services/GameLogicService.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameStateHasher.h"
+#include "services/MoveService.h"
+#include "services/ReplayCodec.h"
+#include <algorithm>
+
+// 每次领取的回放数：足够大以摊薄原子操作，足够小以让各线程的负载均衡
+static const size_t kClaimChunk = 64;
+
+ReplayVerifier::ReplayVerifier(size_t threadCount)
+    : _batch(nullptr)
+    , _verdicts(nullptr)
+    , _batchSize(0)
+    , _nextIndex(0)
+    , _generation(0)
+    , _busyWorkers(0)
+    , _stopping(false)
+{
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        _contexts.push_back(std::unique_ptr<WorkerContext>(new WorkerContext()));
+    }
+    for (size_t i = 1; i < threadCount; ++i) {
+        _threads.push_back(std::thread(&ReplayVerifier::workerLoop, this, i));
+    }
+}
+
+ReplayVerifier::~ReplayVerifier() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _workReady.notify_all();
+    for (auto& thread : _threads) thread.join();
+}
+
+bool ReplayVerifier::addLevel(uint32_t levelId, const LevelConfig& config) {
+    if (config.playFieldCards.empty() && config.stackCards.empty()) return false;
+
+    // 与客户端相同的初始化：配置 -> 运行时数据 -> 发牌
+    std::unique_ptr<Level> level(new Level());
+    auto generated = GameModelFromLevelGenerator::generateGameModel(config);
+    level->initialModel.copyStateFrom(*generated);
+    std::vector<std::shared_ptr<CardModel>> stockCards;
+    MoveService::dealStack(level->initialModel, stockCards);
+    level->initialHash = GameStateHasher::hash(level->initialModel, 0);
+
+    auto found = _levelSlots.find(levelId);
+    if (found != _levelSlots.end()) {
+        _levels[found->second] = std::move(level);
+        // 关卡内容变了，丢弃各线程按旧关卡创建的模型
+        for (auto& ctx : _contexts) {
+            if (found->second < ctx->models.size()) ctx->models[found->second].reset();
+        }
+    }
+    else {
+        _levelSlots[levelId] = _levels.size();
+        _levels.push_back(std::move(level));
+    }
+    return true;
+}
+
+void ReplayVerifier::verify(const ReplaySubmission* batch, size_t count, ReplayVerdict* verdicts) {
+    if (count == 0) return;
+
+    // ========== 发布批次 ==========
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _batch = batch;
+        _verdicts = verdicts;
+        _batchSize = count;
+        _nextIndex.store(0);
+        _busyWorkers = _threads.size();
+        _generation++;
+    }
+    _workReady.notify_all();
+
+    // ========== 调用线程也参与计算 ==========
+    runBatch(*_contexts[0]);
+
+    // ========== 等待工作线程领完并做完 ==========
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _workDone.wait(lock, [this]() { return _busyWorkers == 0; });
+        _batch = nullptr;
+        _verdicts = nullptr;
+        _batchSize = 0;
+    }
+
+    // ========== 汇总各线程的统计 ==========
+    for (auto& ctx : _contexts) {
+        _stats.replays += ctx->stats.replays;
+        _stats.moves += ctx->stats.moves;
+        for (size_t i = 0; i < (size_t)ReplayVerdict::VERDICT_COUNT; ++i) {
+            _stats.verdicts[i] += ctx->stats.verdicts[i];
+        }
+        ctx->stats = Stats();
+    }
+}
+
+void ReplayVerifier::runBatch(WorkerContext& ctx) {
+    for (;;) {
+        size_t begin = _nextIndex.fetch_add(kClaimChunk);
+        if (begin >= _batchSize) return;
+        size_t end = std::min(begin + kClaimChunk, _batchSize);
+        for (size_t i = begin; i < end; ++i) {
+            ReplayVerdict verdict = verifyOne(ctx, _batch[i]);
+            _verdicts[i] = verdict;
+            ctx.stats.replays++;
+            ctx.stats.verdicts[(size_t)verdict]++;
+        }
+    }
+}
+
+void ReplayVerifier::workerLoop(size_t index) {
+    WorkerContext& ctx = *_contexts[index];
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workReady.wait(lock, [this, seenGeneration]() { return _stopping || _generation != seenGeneration; });
+            if (_stopping) return;
+            seenGeneration = _generation;
+        }
+
+        runBatch(ctx);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busyWorkers == 0) _workDone.notify_one();
+        }
+    }
+}
+
+ReplayVerdict ReplayVerifier::verifyOne(WorkerContext& ctx, const ReplaySubmission& submission) {
+    // ========== 解码与头部校验 ==========
+    ReplayData& replay = ctx.replay;
+    if (!ReplayCodec::decode(submission.data, submission.size, replay)) return ReplayVerdict::CORRUPT;
+
+    auto found = _levelSlots.find(replay.levelId);
+    if (found == _levelSlots.end()) return ReplayVerdict::UNKNOWN_LEVEL;
+    if (replay.ruleSet != GameLogicService::RULE_SET_VERSION) return ReplayVerdict::RULE_SET_MISMATCH;
+
+    const Level& level = *_levels[found->second];
+    if (replay.initialHash != level.initialHash) return ReplayVerdict::INITIAL_STATE_MISMATCH;
+
+    // ========== 复用本线程的模型，恢复到初始局面 ==========
+    if (ctx.models.size() <= found->second) ctx.models.resize(_levels.size());
+    std::unique_ptr<GameModel>& slot = ctx.models[found->second];
+    if (!slot) slot.reset(new GameModel());
+    GameModel& model = *slot;
+    model.copyStateFrom(level.initialModel);
+    ctx.undoManager.clear();
+
+    // ========== 逐步重放并校验 ==========
+    uint64_t hash = level.initialHash;
+    for (const auto& move : replay.moves) {
+        if (!MoveService::applyCommand(model, ctx.undoManager, move.type, move.cardId)) return ReplayVerdict::ILLEGAL_MOVE;
+        ctx.stats.moves++;
+        hash = GameStateHasher::hash(model, ctx.undoManager.size());
+        if ((uint32_t)hash != move.stateHash) return ReplayVerdict::HASH_MISMATCH;
+    }
+
+    if (hash != replay.finalHash) return ReplayVerdict::FINAL_HASH_MISMATCH;
+    return ReplayVerdict::VALID;
+}
+
+const char* ReplayVerifier::verdictName(ReplayVerdict verdict) {
+    switch (verdict) {
+    case ReplayVerdict::VALID: return "valid";
+    case ReplayVerdict::CORRUPT: return "corrupt";
+    case ReplayVerdict::UNKNOWN_LEVEL: return "unknown_level";
+    case ReplayVerdict::RULE_SET_MISMATCH: return "rule_set_mismatch";
+    case ReplayVerdict::INITIAL_STATE_MISMATCH: return "initial_state_mismatch";
+    case ReplayVerdict::ILLEGAL_MOVE: return "illegal_move";
+    case ReplayVerdict::HASH_MISMATCH: return "hash_mismatch";
+    case ReplayVerdict::FINAL_HASH_MISMATCH: return "final_hash_mismatch";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef REPLAY_VERIFIER_H
+#define REPLAY_VERIFIER_H
+
+#include "configs/models/LevelConfig.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/ReplayModel.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 回放校验结果
+ */
+enum class ReplayVerdict : uint8_t {
+    VALID,                  // 每一步都合法，状态哈希与声明的一致
+    CORRUPT,                // 数据无法解码
+    UNKNOWN_LEVEL,          // 关卡未注册
+    RULE_SET_MISMATCH,      // 规则版本不同
+    INITIAL_STATE_MISMATCH, // 初始状态与关卡包不一致（关卡文件不同）
+    ILLEGAL_MOVE,           // 某一步不符合规则
+    HASH_MISMATCH,          // 某一步之后的状态哈希与声明的不一致
+    FINAL_HASH_MISMATCH,    // 最终状态与声明的结果不一致
+    VERDICT_COUNT
+};
+
+/**
+ * @brief 一条待校验的回放（不持有数据，调用方保证 verify 返回前有效）
+ */
+struct ReplaySubmission {
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief 回放校验器（服务端排行榜使用）
+ * 职责：按关卡包重建初始局面，用 MoveService 在线程池上重放每一局，输出校验结果
+ *
+ * @details
+ * - 关卡：addLevel 时生成一次初始模型和初始哈希，之后只读，所有线程共享
+ * - 线程：构造时创建 threadCount - 1 个工作线程，调用 verify 的线程也参与计算；
+ *   工作线程以原子计数器按块领取任务，批次之间在条件变量上休眠
+ * - 内存：每个线程持有自己的 GameModel（每个关卡一份）、UndoManager 和 ReplayData，
+ *   每局开始时按值覆盖而不是重新创建；预热之后校验一局不分配内存
+ *
+ * @note addLevel 与 verify 不能并发调用；verify 本身同一时刻只允许一个调用者
+ */
+class ReplayVerifier {
+public:
+    struct Stats {
+        uint64_t replays = 0;                                   // 校验过的回放数
+        uint64_t moves = 0;                                     // 重放过的操作数
+        uint64_t verdicts[(size_t)ReplayVerdict::VERDICT_COUNT] = {};  // 各结果的数量
+    };
+
+    // threadCount 为参与计算的线程总数（含调用 verify 的线程），0 表示按硬件线程数
+    explicit ReplayVerifier(size_t threadCount);
+    ~ReplayVerifier();
+
+    // 注册关卡，重复注册同一 ID 时覆盖；关卡为空时返回 false
+    bool addLevel(uint32_t levelId, const LevelConfig& config);
+
+    // 校验一批回放，阻塞直到全部完成；verdicts 需有 count 个元素
+    void verify(const ReplaySubmission* batch, size_t count, ReplayVerdict* verdicts);
+
+    size_t threadCount() const { return _contexts.size(); }
+
+    const Stats& getStats() const { return _stats; }
+
+    // 结果的可读名称（日志、命令行输出）
+    static const char* verdictName(ReplayVerdict verdict);
+
+private:
+    // 关卡包中的一个关卡：发牌后的初始模型和初始哈希
+    struct Level {
+        GameModel initialModel;
+        uint64_t initialHash;
+    };
+
+    // 每个线程独占的可复用数据
+    struct WorkerContext {
+        std::vector<std::unique_ptr<GameModel>> models;  // 下标与 _levels 一致，首次用到时创建
+        UndoManager undoManager;
+        ReplayData replay;
+        Stats stats;
+    };
+
+    // 校验单局回放
+    ReplayVerdict verifyOne(WorkerContext& ctx, const ReplaySubmission& submission);
+
+    // 从当前批次领取任务直到领完
+    void runBatch(WorkerContext& ctx);
+
+    // 工作线程主循环
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Level>> _levels;
+    std::unordered_map<uint32_t, size_t> _levelSlots;   // 关卡ID -> _levels 下标
+
+    std::vector<std::unique_ptr<WorkerContext>> _contexts;  // [0] 属于调用 verify 的线程
+    std::vector<std::thread> _threads;
+
+    // 当前批次
+    const ReplaySubmission* _batch;
+    ReplayVerdict* _verdicts;
+    size_t _batchSize;
+    std::atomic<size_t> _nextIndex;
+
+    // 批次同步：_generation 递增唤醒工作线程，_busyWorkers 归零时唤醒调用者
+    std::mutex _mutex;
+    std::condition_variable _workReady;
+    std::condition_variable _workDone;
+    uint64_t _generation;
+    size_t _busyWorkers;
+    bool _stopping;
+
+    Stats _stats;
+};
+
+#endif // REPLAY_VERIFIER_H
@@ -0,0 +1,148 @@
+#include "managers/SessionHost.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameStateHasher.h"
+#include "services/MoveService.h"
+
+const size_t SessionHost::SLAB_SIZE;
+
+// make_shared 把卡牌和引用计数放在同一块内存中，引用计数块约为两个指针加两个计数
+static const size_t kSharedControlBlockBytes = 2 * sizeof(void*) + 2 * sizeof(int);
+
+namespace {
+    SessionId makeSessionId(uint32_t index, uint32_t generation) {
+        return ((uint64_t)generation << 32) | index;
+    }
+}
+
+SessionHost::SessionHost() {
+}
+
+bool SessionHost::addLevel(uint32_t levelId, const LevelConfig& config) {
+    if (config.playFieldCards.empty() && config.stackCards.empty()) return false;
+
+    // 与客户端相同的初始化：配置 -> 运行时数据 -> 发牌
+    std::unique_ptr<Level> level(new Level());
+    auto generated = GameModelFromLevelGenerator::generateGameModel(config);
+    level->initialModel.copyStateFrom(*generated);
+    std::vector<std::shared_ptr<CardModel>> stockCards;
+    MoveService::dealStack(level->initialModel, stockCards);
+    level->initialHash = GameStateHasher::hash(level->initialModel, 0);
+
+    auto found = _levelSlots.find(levelId);
+    if (found != _levelSlots.end()) {
+        _levels[found->second] = std::move(level);
+    }
+    else {
+        _levelSlots[levelId] = _levels.size();
+        _levels.push_back(std::move(level));
+    }
+    return true;
+}
+
+SessionId SessionHost::createSession(uint32_t levelId) {
+    auto found = _levelSlots.find(levelId);
+    if (found == _levelSlots.end()) return 0;
+
+    // ========== 取一个空闲槽位，没有时分配新的一块 ==========
+    if (_freeSlots.empty()) {
+        uint32_t base = (uint32_t)(_slabs.size() * SLAB_SIZE);
+        _slabs.push_back(std::unique_ptr<Session[]>(new Session[SLAB_SIZE]));
+        // 倒序压入，先取到块内下标小的槽位
+        for (size_t i = SLAB_SIZE; i > 0; --i) {
+            _freeSlots.push_back(base + (uint32_t)(i - 1));
+        }
+        _stats.capacity += SLAB_SIZE;
+    }
+    uint32_t index = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    // ========== 从关卡初始模型按值复制（卡牌数相同时复用槽位中已有的卡牌对象） ==========
+    Session& session = slotAt(index);
+    session.model.copyStateFrom(_levels[found->second]->initialModel);
+    session.undoManager.clear();
+    session.moves = 0;
+    session.live = true;
+
+    _stats.liveSessions++;
+    _stats.created++;
+    return makeSessionId(index, session.generation);
+}
+
+bool SessionHost::destroySession(SessionId sessionId) {
+    Session* session = findSession(sessionId);
+    if (!session) return false;
+
+    // 模型和回退历史保留给下一个会话复用，只让旧句柄失效
+    session->live = false;
+    session->generation++;
+    if (session->generation == 0) session->generation = 1;
+    _freeSlots.push_back((uint32_t)sessionId);
+
+    _stats.liveSessions--;
+    _stats.destroyed++;
+    return true;
+}
+
+SessionMoveResult SessionHost::applyMove(SessionId sessionId, InputCommandType type, int32_t cardId) {
+    SessionMoveResult result;
+    Session* session = findSession(sessionId);
+    if (!session) return result;
+
+    if (MoveService::applyCommand(session->model, session->undoManager, type, cardId)) {
+        result.status = SessionMoveStatus::ACCEPTED;
+        session->moves++;
+        _stats.moves++;
+    }
+    else {
+        result.status = SessionMoveStatus::REJECTED;
+        _stats.rejected++;
+    }
+    result.stateHash = GameStateHasher::hash(session->model, session->undoManager.size());
+    return result;
+}
+
+void SessionHost::applyBatch(const SessionCommand* commands, size_t count, SessionMoveResult* results) {
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = applyMove(commands[i].sessionId, commands[i].type, commands[i].cardId);
+    }
+}
+
+const GameModel* SessionHost::getModel(SessionId sessionId) const {
+    const Session* session = findSession(sessionId);
+    return session ? &session->model : nullptr;
+}
+
+uint64_t SessionHost::getStateHash(SessionId sessionId) const {
+    const Session* session = findSession(sessionId);
+    return session ? GameStateHasher::hash(session->model, session->undoManager.size()) : 0;
+}
+
+bool SessionHost::getMemoryStats(SessionId sessionId, SessionMemoryStats& out) const {
+    const Session* session = findSession(sessionId);
+    if (!session) return false;
+
+    const GameModel& model = session->model;
+    out.slotBytes = sizeof(Session);
+    out.cardBytes = model.allCards.size() * (sizeof(CardModel) + kSharedControlBlockBytes);
+    out.indexBytes = model.allCards.capacity() * sizeof(std::shared_ptr<CardModel>)
+        + model.stockCardIds.capacity() * sizeof(int);
+    out.undoBytes = session->undoManager.capacity() * sizeof(UndoCommand);
+    out.totalBytes = out.slotBytes + out.cardBytes + out.indexBytes + out.undoBytes;
+    out.undoDepth = session->undoManager.size();
+    out.moves = session->moves;
+    return true;
+}
+
+SessionHost::Session* SessionHost::findSession(SessionId sessionId) {
+    return const_cast<Session*>(static_cast<const SessionHost*>(this)->findSession(sessionId));
+}
+
+const SessionHost::Session* SessionHost::findSession(SessionId sessionId) const {
+    uint32_t index = (uint32_t)sessionId;
+    uint32_t generation = (uint32_t)(sessionId >> 32);
+    if (index >= _slabs.size() * SLAB_SIZE) return nullptr;
+
+    const Session& session = slotAt(index);
+    if (!session.live || session.generation != generation) return nullptr;
+    return &session;
+}
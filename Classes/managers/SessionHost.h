@@ -0,0 +1,140 @@
+#ifndef SESSION_HOST_H
+#define SESSION_HOST_H
+
+#include "configs/models/LevelConfig.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/InputCommand.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 会话句柄：高 32 位为代数，低 32 位为槽位下标；0 表示无效
+ * @note 会话销毁后槽位的代数递增，旧句柄随之失效，不会误操作复用该槽位的新会话
+ */
+typedef uint64_t SessionId;
+
+/**
+ * @brief 一步操作的处理结果
+ */
+enum class SessionMoveStatus : uint8_t {
+    ACCEPTED,   // 合法并已执行
+    REJECTED,   // 不符合规则，状态未改变
+    NO_SESSION  // 会话不存在（已销毁或句柄无效）
+};
+
+/**
+ * @brief 发往某个会话的一条命令
+ */
+struct SessionCommand {
+    SessionId sessionId;
+    InputCommandType type;
+    int32_t cardId;
+};
+
+/**
+ * @brief 命令的处理结果，附带执行后的状态哈希（客户端据此确认自己的预测）
+ */
+struct SessionMoveResult {
+    SessionMoveStatus status = SessionMoveStatus::NO_SESSION;
+    uint64_t stateHash = 0;
+};
+
+/**
+ * @brief 单个会话占用的内存（字节，按容量而非元素数统计）
+ */
+struct SessionMemoryStats {
+    size_t slotBytes = 0;       // 槽位本身（会话对象）
+    size_t cardBytes = 0;       // 卡牌对象及其引用计数块
+    size_t indexBytes = 0;      // 卡牌指针数组、备用堆顺序
+    size_t undoBytes = 0;       // 回退历史
+    size_t totalBytes = 0;
+    size_t undoDepth = 0;       // 当前回退步数
+    uint32_t moves = 0;         // 已执行的操作数
+};
+
+/**
+ * @brief 多会话游戏主机（服务端权威模式使用，不依赖引擎）
+ * 职责：在一个进程中承载大量互相独立的对局，按会话句柄路由命令，用 MoveService 执行规则
+ *
+ * @details
+ * - 关卡：addLevel 时生成一次发牌后的初始模型和初始哈希，新会话从它按值复制
+ * - 内存：会话存放在固定大小的槽位块（slab）中，每块 SLAB_SIZE 个槽位，块一旦分配就不移动、不释放；
+ *   销毁的槽位进入空闲链表，再次创建时复用其中的模型和回退历史的容量，稳定运行后创建会话不分配内存
+ * - 线程：不加锁，一个 SessionHost 只由一个线程使用；多核时每个线程一个 SessionHost，
+ *   按会话分片（与 GameController 一样，不设单例）
+ */
+class SessionHost {
+public:
+    static const size_t SLAB_SIZE = 256;
+
+    struct Stats {
+        size_t liveSessions = 0;    // 存活的会话数
+        size_t capacity = 0;        // 已分配的槽位数
+        uint64_t created = 0;       // 累计创建的会话数
+        uint64_t destroyed = 0;     // 累计销毁的会话数
+        uint64_t moves = 0;         // 累计执行的操作数
+        uint64_t rejected = 0;      // 累计被拒绝的操作数
+    };
+
+    SessionHost();
+
+    // 注册关卡，重复注册同一 ID 时覆盖（只影响之后创建的会话）；关卡为空时返回 false
+    bool addLevel(uint32_t levelId, const LevelConfig& config);
+
+    // 创建一局新游戏，关卡未注册时返回 0
+    SessionId createSession(uint32_t levelId);
+
+    // 销毁会话，句柄无效时返回 false
+    bool destroySession(SessionId sessionId);
+
+    // 对一个会话执行一条命令
+    SessionMoveResult applyMove(SessionId sessionId, InputCommandType type, int32_t cardId);
+
+    // 依次执行一批命令（可以发往不同会话），results 需有 count 个元素
+    void applyBatch(const SessionCommand* commands, size_t count, SessionMoveResult* results);
+
+    // 会话的当前模型（只读），句柄无效时返回 nullptr
+    const GameModel* getModel(SessionId sessionId) const;
+
+    // 会话当前的状态哈希，句柄无效时返回 0
+    uint64_t getStateHash(SessionId sessionId) const;
+
+    // 会话的内存占用，句柄无效时返回 false
+    bool getMemoryStats(SessionId sessionId, SessionMemoryStats& out) const;
+
+    const Stats& getStats() const { return _stats; }
+
+private:
+    // 一个关卡：发牌后的初始模型和初始哈希
+    struct Level {
+        GameModel initialModel;
+        uint64_t initialHash;
+    };
+
+    // 一个槽位；live 为 false 时在空闲链表中
+    struct Session {
+        GameModel model;
+        UndoManager undoManager;
+        uint32_t generation = 1;
+        uint32_t moves = 0;
+        bool live = false;
+    };
+
+    Session* findSession(SessionId sessionId);
+    const Session* findSession(SessionId sessionId) const;
+    Session& slotAt(uint32_t index) const { return _slabs[index / SLAB_SIZE][index % SLAB_SIZE]; }
+
+    std::vector<std::unique_ptr<Level>> _levels;
+    std::unordered_map<uint32_t, size_t> _levelSlots;   // 关卡ID -> _levels 下标
+
+    std::vector<std::unique_ptr<Session[]>> _slabs;
+    std::vector<uint32_t> _freeSlots;                   // 空闲槽位下标，后进先出（复用刚释放、仍在缓存中的槽位）
+
+    Stats _stats;
+};
+
+#endif // SESSION_HOST_H
@@ -0,0 +1,279 @@
+#include "managers/TelemetryManager.h"
+#include "services/TelemetryCodec.h"
+#include "utils/CoreLog.h"
+#include "utils/Profiler.h"
+#include <chrono>
+#include <random>
+
+namespace {
+    // 还没有打开过文件
+    const uint32_t kNoSlot = 0xFFFFFFFFu;
+
+    const char* const kIndexFileName = "telemetry.idx";
+
+    // 每个实例一个递增的ID，线程缓存据此判断缓存的缓冲是否属于当前实例
+    std::atomic<uint64_t> s_nextInstanceId(1);
+
+    struct ThreadStreamCache {
+        uint64_t instanceId;
+        void* stream;
+    };
+    thread_local ThreadStreamCache t_streamCache = { 0, nullptr };
+}
+
+/**
+ * @brief 一个线程的事件缓冲
+ * @details 所属线程是唯一的生产者，后台线程是唯一的消费者
+ */
+struct TelemetryManager::Stream {
+    std::thread::id owner;
+    SpscQueue<TelemetryEvent> queue;
+    std::atomic<uint64_t> recorded;     // 只由所属线程写入
+
+    Stream(std::thread::id id, size_t capacity) : owner(id), queue(capacity), recorded(0) {}
+};
+
+TelemetryManager::TelemetryManager(const Config& config)
+    : _config(config)
+    , _instanceId(s_nextInstanceId.fetch_add(1))
+    , _playCounter(0)
+    , _flushRequested(false)
+    , _stopping(false)
+    , _stopped(false)
+    , _file(nullptr)
+    , _slot(kNoSlot)
+    , _fileBytes(0)
+    , _dropped(0)
+    , _written(0)
+    , _batches(0)
+    , _bytesWritten(0)
+    , _rotations(0)
+    , _errors(0)
+{
+    if (_config.maxFiles == 0) _config.maxFiles = 1;
+    std::random_device device;
+    _playSeed = device() ^ (uint32_t)nowMs();
+    _thread = std::thread(&TelemetryManager::flushLoop, this);
+}
+
+TelemetryManager::~TelemetryManager() {
+    shutdown();
+}
+
+uint32_t TelemetryManager::newPlayId() {
+    return _playSeed + ++_playCounter;
+}
+
+bool TelemetryManager::recordLevelStart(const TelemetryPlay& play, bool restored) {
+    TelemetryEvent event;
+    event.playId = play.playId;
+    event.levelId = play.levelId;
+    event.type = TelemetryEventType::LEVEL_START;
+    event.detail = restored ? 1 : 0;
+    event.moveCount = play.moveCount;
+    event.undoCount = play.undoCount;
+    return record(event);
+}
+
+bool TelemetryManager::recordMove(const TelemetryPlay& play, InputCommandType type, int32_t cardId, uint32_t sinceLastMoveMs) {
+    TelemetryEvent event;
+    event.playId = play.playId;
+    event.levelId = play.levelId;
+    event.type = type == InputCommandType::UNDO ? TelemetryEventType::UNDO : TelemetryEventType::MOVE;
+    event.detail = (uint8_t)type;
+    event.elapsedMs = sinceLastMoveMs;
+    event.value = type == InputCommandType::UNDO ? 0 : cardId;
+    event.moveCount = play.moveCount;
+    event.undoCount = play.undoCount;
+    return record(event);
+}
+
+bool TelemetryManager::recordLevelEnd(const TelemetryPlay& play, LevelOutcome outcome, int32_t cardsLeft, uint32_t durationMs) {
+    TelemetryEvent event;
+    event.playId = play.playId;
+    event.levelId = play.levelId;
+    event.type = TelemetryEventType::LEVEL_END;
+    event.detail = (uint8_t)outcome;
+    event.elapsedMs = durationMs;
+    event.value = cardsLeft;
+    event.moveCount = play.moveCount;
+    event.undoCount = play.undoCount;
+    return record(event);
+}
+
+bool TelemetryManager::record(const TelemetryEvent& event) {
+    if (_stopping.load(std::memory_order_relaxed)) return false;
+    Stream* stream = threadStream();
+
+    TelemetryEvent stamped = event;
+    if (stamped.timestampMs == 0) stamped.timestampMs = nowMs();
+    if (!stream->queue.tryPush(stamped)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // 单写者：读改写不需要原子加法
+    stream->recorded.store(stream->recorded.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void TelemetryManager::requestFlush() {
+    _flushRequested.store(true, std::memory_order_release);
+    _wake.notify_one();
+}
+
+void TelemetryManager::shutdown() {
+    if (_stopped) return;
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping.store(true);
+    }
+    _wake.notify_one();
+    _thread.join();
+    _stopped = true;
+}
+
+TelemetryManager::Stats TelemetryManager::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        for (const auto& stream : _streams) stats.recorded += stream->recorded.load(std::memory_order_relaxed);
+    }
+    stats.dropped = _dropped.load(std::memory_order_relaxed);
+    stats.written = _written.load(std::memory_order_relaxed);
+    stats.batches = _batches.load(std::memory_order_relaxed);
+    stats.bytesWritten = _bytesWritten.load(std::memory_order_relaxed);
+    stats.rotations = _rotations.load(std::memory_order_relaxed);
+    stats.errors = _errors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64_t TelemetryManager::nowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+TelemetryManager::Stream* TelemetryManager::threadStream() {
+    if (t_streamCache.instanceId == _instanceId) return static_cast<Stream*>(t_streamCache.stream);
+
+    // ========== 缓存未命中：查找本线程已登记的缓冲，没有则创建 ==========
+    std::thread::id self = std::this_thread::get_id();
+    Stream* stream = nullptr;
+    std::lock_guard<std::mutex> lock(_streamsMutex);
+    for (const auto& existing : _streams) {
+        if (existing->owner == self) stream = existing.get();
+    }
+    if (!stream) {
+        _streams.push_back(std::unique_ptr<Stream>(new Stream(self, _config.ringCapacity)));
+        stream = _streams.back().get();
+    }
+    t_streamCache.instanceId = _instanceId;
+    t_streamCache.stream = stream;
+    return stream;
+}
+
+void TelemetryManager::flushLoop() {
+    PROFILE_THREAD_NAME("telemetry");
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wake.wait_for(lock, std::chrono::milliseconds(_config.flushIntervalMs), [this]() {
+                return _flushRequested.load(std::memory_order_acquire) || _stopping.load();
+                });
+        }
+        _flushRequested.store(false, std::memory_order_relaxed);
+        bool stopping = _stopping.load();
+
+        flushStreams();
+        if (stopping) break;
+    }
+
+    if (_file) {
+        fclose(_file);
+        _file = nullptr;
+    }
+}
+
+/**
+ * @brief 取出所有缓冲中的事件，编码为一个批次追加到当前文件
+ *
+ * @details
+ * - 各线程缓冲中的事件按缓冲依次取出，同一线程的事件保持记录顺序
+ * - 写入失败时关闭当前文件，下一次写入换到下一个槽位
+ */
+void TelemetryManager::flushStreams() {
+    PROFILE_ZONE("TelemetryManager::flushStreams");
+
+    // ========== 步骤1：取出事件 ==========
+    _batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        for (const auto& stream : _streams) {
+            stream->queue.drain([this](const TelemetryEvent& event) { _batch.push_back(event); });
+        }
+    }
+    if (_batch.empty()) return;
+
+    // ========== 步骤2：编码为一个批次 ==========
+    _batchBytes.clear();
+    TelemetryCodec::encodeBatch(_batch.data(), _batch.size(), _batchBytes);
+
+    // ========== 步骤3：追加到当前文件，超过上限后换下一个槽位 ==========
+    if (!_file && !openNextFile()) {
+        _errors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    bool ok = fwrite(_batchBytes.data(), 1, _batchBytes.size(), _file) == _batchBytes.size();
+    if (ok) ok = fflush(_file) == 0;
+    if (!ok) {
+        _errors.fetch_add(1, std::memory_order_relaxed);
+        CORE_LOG("TelemetryManager: failed to write %s", slotPath(_slot).c_str());
+        fclose(_file);
+        _file = nullptr;
+        return;
+    }
+
+    _fileBytes += _batchBytes.size();
+    _written.fetch_add(_batch.size(), std::memory_order_relaxed);
+    _batches.fetch_add(1, std::memory_order_relaxed);
+    _bytesWritten.fetch_add(_batchBytes.size(), std::memory_order_relaxed);
+
+    if (_fileBytes >= _config.maxFileBytes) {
+        fclose(_file);
+        _file = nullptr;
+        _rotations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool TelemetryManager::openNextFile() {
+    std::string indexPath = _config.directory + kIndexFileName;
+
+    // 第一次打开：从上次运行写到的槽位之后开始
+    if (_slot == kNoSlot) {
+        _slot = _config.maxFiles - 1;
+        FILE* index = fopen(indexPath.c_str(), "rb");
+        if (index) {
+            unsigned int last = 0;
+            if (fscanf(index, "%u", &last) == 1 && last < _config.maxFiles) _slot = last;
+            fclose(index);
+        }
+    }
+
+    _slot = (_slot + 1) % _config.maxFiles;
+    _fileBytes = 0;
+    _file = fopen(slotPath(_slot).c_str(), "wb");
+    if (!_file) {
+        CORE_LOG("TelemetryManager: failed to open %s", slotPath(_slot).c_str());
+        return false;
+    }
+
+    FILE* index = fopen(indexPath.c_str(), "wb");
+    if (index) {
+        fprintf(index, "%u\n", _slot);
+        fclose(index);
+    }
+    return true;
+}
+
+std::string TelemetryManager::slotPath(uint32_t slot) const {
+    return _config.directory + "telemetry_" + std::to_string(slot) + ".bin";
+}
@@ -0,0 +1,133 @@
+#ifndef TELEMETRY_MANAGER_H
+#define TELEMETRY_MANAGER_H
+
+#include "models/TelemetryEvent.h"
+#include "utils/SpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 遥测管理器（不依赖引擎）
+ * 职责：记录定长的分析事件（出牌类型、操作间隔、撤销、关卡结果），由后台线程批量写入轮转的二进制文件
+ *
+ * @details
+ * - 记录：每个线程第一次记录时分配自己的环形缓冲（SpscQueue），之后的记录只做一次拷贝入队，
+ *   不加锁、不分配内存、不触发系统调用；缓冲满时丢弃事件并计数
+ * - 写入：后台线程每 flushIntervalMs（或 requestFlush 时）取出所有缓冲中的事件，
+ *   编码为一个批次（TelemetryCodec 格式）追加到当前文件
+ * - 轮转：文件超过 maxFileBytes 后换到下一个槽位 telemetry_<n>.bin（n 在 0 ~ maxFiles-1 之间循环，
+ *   覆盖最旧的文件）；当前槽位记在 telemetry.idx 中，每次启动从下一个槽位开始写
+ * - 遥测数据丢失可以接受，不做 fsync
+ *
+ * @note 与其它管理器一样由 AppDelegate 创建并注入使用者，不设单例；目录需要事先创建
+ */
+class TelemetryManager {
+public:
+    struct Config {
+        std::string directory;              // 文件目录（以 / 结尾）
+        uint32_t flushIntervalMs = 1000;    // 后台线程写入间隔
+        size_t maxFileBytes = 256 * 1024;   // 单个文件的大小上限
+        uint32_t maxFiles = 8;              // 轮转的文件个数
+        size_t ringCapacity = 1024;         // 每个线程的缓冲事件数
+    };
+
+    struct Stats {
+        uint64_t recorded = 0;      // 进入缓冲的事件数
+        uint64_t dropped = 0;       // 缓冲满被丢弃的事件数
+        uint64_t written = 0;       // 写入文件的事件数
+        uint64_t batches = 0;       // 写入的批次数
+        uint64_t bytesWritten = 0;  // 写入的字节数
+        uint64_t rotations = 0;     // 换文件的次数
+        uint64_t errors = 0;        // 打开 / 写入失败的次数
+    };
+
+    explicit TelemetryManager(const Config& config);
+    ~TelemetryManager();
+
+    // 为新的一局分配ID（主线程）
+    uint32_t newPlayId();
+
+    // ========== 类型化记录接口（任意线程）==========
+    bool recordLevelStart(const TelemetryPlay& play, bool restored);
+    bool recordMove(const TelemetryPlay& play, InputCommandType type, int32_t cardId, uint32_t sinceLastMoveMs);
+    bool recordLevelEnd(const TelemetryPlay& play, LevelOutcome outcome, int32_t cardsLeft, uint32_t durationMs);
+
+    /**
+     * @brief 记录一条事件（任意线程）
+     * @details timestampMs 为 0 时填入当前系统时间
+     * @return 缓冲已满或已经 shutdown 时返回 false
+     */
+    bool record(const TelemetryEvent& event);
+
+    // 立即唤醒后台线程写入（不等待写完），例如应用切到后台时
+    void requestFlush();
+
+    // 写完所有缓冲中的事件后结束后台线程；可以重复调用
+    void shutdown();
+
+    // 统计（任意线程，各计数单独读取，彼此之间不保证一致）
+    Stats getStats() const;
+
+    // 当前系统时间（Unix 毫秒）
+    static uint64_t nowMs();
+
+private:
+    struct Stream;
+
+    TelemetryManager(const TelemetryManager&) = delete;
+    TelemetryManager& operator=(const TelemetryManager&) = delete;
+
+    // 当前线程的缓冲，第一次调用时创建并登记
+    Stream* threadStream();
+
+    void flushLoop();
+
+    // 后台线程：取出所有缓冲中的事件并写入一个批次
+    void flushStreams();
+
+    // 后台线程：打开下一个槽位的文件（截断），并更新 telemetry.idx
+    bool openNextFile();
+
+    std::string slotPath(uint32_t slot) const;
+
+    Config _config;
+    const uint64_t _instanceId;     // 区分先后创建的实例（线程缓存中的指针可能指向已销毁的实例）
+
+    // 已登记的线程缓冲，由 _streamsMutex 保护（登记、后台写入和统计时加锁，记录本身不加锁）
+    mutable std::mutex _streamsMutex;
+    std::vector<std::unique_ptr<Stream>> _streams;
+
+    uint32_t _playSeed;
+    uint32_t _playCounter;
+
+    std::thread _thread;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::atomic<bool> _flushRequested;
+    std::atomic<bool> _stopping;
+    bool _stopped;
+
+    // 后台线程
+    FILE* _file;
+    uint32_t _slot;
+    size_t _fileBytes;
+    std::vector<TelemetryEvent> _batch;
+    std::vector<uint8_t> _batchBytes;
+
+    std::atomic<uint64_t> _dropped;
+    std::atomic<uint64_t> _written;
+    std::atomic<uint64_t> _batches;
+    std::atomic<uint64_t> _bytesWritten;
+    std::atomic<uint64_t> _rotations;
+    std::atomic<uint64_t> _errors;
+};
+
+#endif // TELEMETRY_MANAGER_H
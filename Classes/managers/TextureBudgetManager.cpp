@@ -0,0 +1,145 @@
+#include "managers/TextureBudgetManager.h"
+#include <algorithm>
+
+using namespace cocos2d;
+
+namespace {
+    const char* kOwnerNames[] = { "card_atlas", "ui", "thumbnail", "unknown" };
+
+    // 淘汰优先级：数值越小越先被淘汰
+    int getEvictionRank(TextureOwner owner) {
+        switch (owner) {
+        case TextureOwner::THUMBNAIL:  return 0;
+        case TextureOwner::UNKNOWN:    return 1;
+        case TextureOwner::UI:         return 2;
+        case TextureOwner::CARD_ATLAS: return 3;
+        default: return 1;
+        }
+    }
+}
+
+TextureBudgetManager::TextureBudgetManager(size_t budgetBytes)
+    : _budgetBytes(budgetBytes)
+{
+    // 默认规则：与 CardView 使用的资源目录保持一致
+    addOwnerRule("card_general", TextureOwner::CARD_ATLAS);
+    addOwnerRule("number/", TextureOwner::CARD_ATLAS);
+    addOwnerRule("suits/", TextureOwner::CARD_ATLAS);
+    addOwnerRule("thumbnails/", TextureOwner::THUMBNAIL);
+}
+
+void TextureBudgetManager::addOwnerRule(const std::string& pathPattern, TextureOwner owner) {
+    _ownerRules.push_back(std::make_pair(pathPattern, owner));
+}
+
+void TextureBudgetManager::trackSceneTextures(Node* root) {
+    if (!root) return;
+
+    auto sprite = dynamic_cast<Sprite*>(root);
+    if (sprite && sprite->getTexture()) {
+        std::string path = Director::getInstance()->getTextureCache()->getTextureFilePath(sprite->getTexture());
+        // 没有文件路径的贴图（例如程序生成的）不在 TextureCache 的管理范围内
+        if (!path.empty()) {
+            trackTexture(path, resolveOwner(path));
+        }
+    }
+
+    for (auto child : root->getChildren()) {
+        trackSceneTextures(child);
+    }
+}
+
+void TextureBudgetManager::trackTexture(const std::string& path, TextureOwner owner) {
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
+    if (fullPath.empty()) return;
+    _trackedTextures[fullPath] = owner;
+}
+
+size_t TextureBudgetManager::getLiveBytes() const {
+    size_t total = 0;
+    auto cache = Director::getInstance()->getTextureCache();
+    for (const auto& entry : _trackedTextures) {
+        total += getTextureBytes(cache->getTextureForKey(entry.first));
+    }
+    return total;
+}
+
+size_t TextureBudgetManager::getLiveBytes(TextureOwner owner) const {
+    size_t total = 0;
+    auto cache = Director::getInstance()->getTextureCache();
+    for (const auto& entry : _trackedTextures) {
+        if (entry.second == owner) {
+            total += getTextureBytes(cache->getTextureForKey(entry.first));
+        }
+    }
+    return total;
+}
+
+size_t TextureBudgetManager::enforceBudget() {
+    auto cache = Director::getInstance()->getTextureCache();
+
+    struct Candidate {
+        std::string key;
+        TextureOwner owner;
+        size_t bytes;
+    };
+    std::vector<Candidate> candidates;
+    size_t liveBytes = 0;
+
+    for (auto it = _trackedTextures.begin(); it != _trackedTextures.end();) {
+        Texture2D* texture = cache->getTextureForKey(it->first);
+        if (!texture) {
+            // 已被其他途径移出缓存，不再跟踪
+            it = _trackedTextures.erase(it);
+            continue;
+        }
+        size_t bytes = getTextureBytes(texture);
+        liveBytes += bytes;
+        // 引用计数为 1 表示只有 TextureCache 自己持有，可以安全淘汰
+        if (texture->getReferenceCount() == 1) {
+            candidates.push_back({ it->first, it->second, bytes });
+        }
+        ++it;
+    }
+
+    if (liveBytes <= _budgetBytes) return 0;
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        int rankA = getEvictionRank(a.owner);
+        int rankB = getEvictionRank(b.owner);
+        if (rankA != rankB) return rankA < rankB;
+        return a.bytes > b.bytes;
+        });
+
+    size_t evictedBytes = 0;
+    for (const auto& candidate : candidates) {
+        if (liveBytes - evictedBytes <= _budgetBytes) break;
+        cache->removeTextureForKey(candidate.key);
+        _trackedTextures.erase(candidate.key);
+        evictedBytes += candidate.bytes;
+    }
+
+    CCLOG("TextureBudgetManager: evicted %.1f KB, live %.1f KB / budget %.1f KB",
+        evictedBytes / 1024.0f, (liveBytes - evictedBytes) / 1024.0f, _budgetBytes / 1024.0f);
+    return evictedBytes;
+}
+
+void TextureBudgetManager::logReport(const std::string& reason) const {
+    CCLOG("TextureBudgetManager [%s]: live %.1f KB / budget %.1f KB",
+        reason.c_str(), getLiveBytes() / 1024.0f, _budgetBytes / 1024.0f);
+    for (int i = 0; i < (int)TextureOwner::NUM_TEXTURE_OWNERS; ++i) {
+        CCLOG("  %-10s %.1f KB", kOwnerNames[i], getLiveBytes(static_cast<TextureOwner>(i)) / 1024.0f);
+    }
+}
+
+TextureOwner TextureBudgetManager::resolveOwner(const std::string& path) const {
+    for (const auto& rule : _ownerRules) {
+        if (path.find(rule.first) != std::string::npos) return rule.second;
+    }
+    return TextureOwner::UNKNOWN;
+}
+
+size_t TextureBudgetManager::getTextureBytes(Texture2D* texture) {
+    if (!texture) return 0;
+    return (size_t)texture->getPixelsWide() * texture->getPixelsHigh() * texture->getBitsPerPixelForFormat() / 8;
+}
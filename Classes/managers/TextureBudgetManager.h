@@ -0,0 +1,77 @@
+#ifndef TEXTURE_BUDGET_MANAGER_H
+#define TEXTURE_BUDGET_MANAGER_H
+
+#include "cocos2d.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 贴图归属分类
+ * 用于统计各模块占用的显存，以及超出预算时决定淘汰顺序
+ */
+enum class TextureOwner {
+    CARD_ATLAS = 0,     // 卡牌底板、数字、花色
+    UI = 1,             // 按钮、背景等界面贴图
+    THUMBNAIL = 2,      // 关卡缩略图
+    UNKNOWN = 3,        // 未匹配任何规则
+    NUM_TEXTURE_OWNERS
+};
+
+/**
+ * @brief 贴图显存预算管理器
+ * 职责：
+ * 1. 记录 TextureCache 中贴图的归属（按路径前缀规则打标签）
+ * 2. 统计当前存活贴图的显存占用（总量 / 按归属）
+ * 3. 超出预算时，从 TextureCache 中淘汰没有被任何节点引用的贴图
+ *
+ * @note 跨关卡共享（由 AppDelegate 创建），以便统计场景切换后残留的贴图
+ */
+class TextureBudgetManager {
+public:
+    /**
+     * @param budgetBytes 显存预算（字节）
+     */
+    explicit TextureBudgetManager(size_t budgetBytes);
+
+    void setBudget(size_t budgetBytes) { _budgetBytes = budgetBytes; }
+    size_t getBudget() const { return _budgetBytes; }
+
+    // 添加归属规则：贴图路径包含 pathPattern 即归为 owner（先添加的规则优先）
+    void addOwnerRule(const std::string& pathPattern, TextureOwner owner);
+
+    // 遍历节点树，记录所有 Sprite 使用的贴图
+    void trackSceneTextures(cocos2d::Node* root);
+
+    // 手动记录一张贴图（path 可以是相对路径或完整路径）
+    void trackTexture(const std::string& path, TextureOwner owner);
+
+    // 当前存活贴图占用的显存（字节）
+    size_t getLiveBytes() const;
+    size_t getLiveBytes(TextureOwner owner) const;
+
+    /**
+     * 超出预算时淘汰未被引用的贴图
+     * 淘汰顺序：THUMBNAIL -> UNKNOWN -> UI -> CARD_ATLAS，同类中先淘汰大贴图
+     * @return 释放的显存字节数
+     */
+    size_t enforceBudget();
+
+    // 打印当前显存占用报告
+    void logReport(const std::string& reason) const;
+
+private:
+    TextureOwner resolveOwner(const std::string& path) const;
+
+    // 根据像素尺寸与像素格式估算显存占用
+    static size_t getTextureBytes(cocos2d::Texture2D* texture);
+
+    size_t _budgetBytes;
+    std::vector<std::pair<std::string, TextureOwner>> _ownerRules;
+
+    // 完整路径 -> 归属
+    std::unordered_map<std::string, TextureOwner> _trackedTextures;
+};
+
+#endif // TEXTURE_BUDGET_MANAGER_H
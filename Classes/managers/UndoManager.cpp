@@ -1,4 +1,5 @@
 #include "managers/UndoManager.h"
+#include "utils/CoreLog.h"
 
 UndoManager::UndoManager() {
     // 构造函数：初始化时栈是空的，无需特殊操作
@@ -9,7 +10,7 @@ UndoManager::~UndoManager() {
 }
 
 void UndoManager::pushCommand(const UndoCommand& cmd) {
-    _history.push(cmd);
+    _history.push_back(cmd);
 }
 
 bool UndoManager::canUndo() const {
@@ -20,10 +21,17 @@ UndoCommand UndoManager::popCommand() {
     if (_history.empty()) {
         // 如果栈空了，返回一个无效的默认命令
         // (实际上 Controller 调用前应该先检查 canUndo)
+        CORE_LOG("UndoManager: popCommand called on empty history");
         return UndoCommand();
     }
     
-    UndoCommand cmd = _history.top();
-    _history.pop();
+    UndoCommand cmd = _history.back();
+    _history.pop_back();
     return cmd;
+}
+
+void UndoManager::remapPositions(const std::function<Vector2(const Vector2&)>& mapper) {
+    for (auto& cmd : _history) {
+        cmd.fromPos = mapper(cmd.fromPos);
+    }
 }
\ No newline at end of file
@@ -2,8 +2,9 @@
 #define UNDO_MANAGER_H
 
 #include "models/UndoModel.h"
-#include <stack>
+#include <functional>
 #include <memory>
+#include <vector>
 
 /**
  * @brief 回退管理器
@@ -20,11 +21,30 @@ public:
     // 检查是否有可回退的操作
     bool canUndo() const;
 
+    // 历史记录中的操作数
+    size_t size() const { return _history.size(); }
+
+    // 历史记录已分配的容量（内存统计使用）
+    size_t capacity() const { return _history.capacity(); }
+
     // 取出并移除最近的一步操作
     UndoCommand popCommand();
 
+    // 清空历史记录（保留容量）
+    void clear() { _history.clear(); }
+
+    // 完整的历史记录（从旧到新），存档时读取
+    const std::vector<UndoCommand>& getHistory() const { return _history; }
+
+    // 用存档中的历史记录替换当前历史
+    void setHistory(const std::vector<UndoCommand>& history) { _history = history; }
+
+    // 按给定的映射改写所有历史记录中的位置（屏幕尺寸变化、重新布局时调用）
+    void remapPositions(const std::function<Vector2(const Vector2&)>& mapper);
+
 private:
-    std::stack<UndoCommand> _history;
+    // 用 vector 代替 stack：栈顶在末尾，同时允许遍历改写历史记录
+    std::vector<UndoCommand> _history;
 };
 
 #endif // UNDO_MANAGER_H
\ No newline at end of file
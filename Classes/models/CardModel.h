@@ -2,11 +2,11 @@
 #define CARD_MODEL_H
 
 #include "configs/GameConsts.h"
-#include "cocos2d.h"
+#include "utils/Vector2.h"
 
 class CardModel {
 public:
-    // ҲҪ CST_NONE / CFT_NONE
+    // 【修正】这里也要改用 CST_NONE / CFT_NONE
     CardModel()
         : _id(-1)
         , _face(CardFaceType::CFT_NONE)
@@ -16,7 +16,7 @@ public:
     {
     }
 
-    void init(int id, CardFaceType face, CardSuitType suit, const cocos2d::Vec2& pos) {
+    void init(int id, CardFaceType face, CardSuitType suit, const Vector2& pos) {
         _id = id;
         _face = face;
         _suit = suit;
@@ -28,12 +28,12 @@ public:
     int getId() const { return _id; }
     CardFaceType getFace() const { return _face; }
     CardSuitType getSuit() const { return _suit; }
-    const cocos2d::Vec2& getPosition() const { return _position; }
-    const cocos2d::Vec2& getOriginPosition() const { return _originPosition; }
+    const Vector2& getPosition() const { return _position; }
+    const Vector2& getOriginPosition() const { return _originPosition; }
     CardState getState() const { return _state; }
     int getZIndex() const { return _zIndex; }
 
-    void setPosition(const cocos2d::Vec2& pos) { _position = pos; }
+    void setPosition(const Vector2& pos) { _position = pos; }
     void setState(CardState state) { _state = state; }
     void setZIndex(int z) { _zIndex = z; }
 
@@ -41,8 +41,8 @@ private:
     int _id;
     CardFaceType _face;
     CardSuitType _suit;
-    cocos2d::Vec2 _position;
-    cocos2d::Vec2 _originPosition;
+    Vector2 _position;
+    Vector2 _originPosition;
     CardState _state;
     int _zIndex;
 };
@@ -3,34 +3,69 @@
 
 #include "models/CardModel.h"
 #include <vector>
-#include <memory> // ʹָ Model 
+#include <memory> // 使用智能指针管理 Model 生命周期
 
 class GameModel {
 public:
-    // **ʱƳ**
-    // άǰؿдϷеĿʵⲿͨ shared_ptr ȡò״̬
+    // **运行时卡牌池**
+    // 集合中维护当前关卡所有处于游戏中的卡牌实例，外部可以通过 shared_ptr 获取引用并操作状态。
     std::vector<std::shared_ptr<CardModel>> allCards;
 
-    // ** ID ҿ**
-    // @param id ҪҵĿΨһʶ
-    // @return ҵظÿƵ shared_ptr򷵻 nullptr
-    std::shared_ptr<CardModel> getCardById(int id) {
+    // **底牌堆顶部的卡牌 ID**
+    // 匹配规则都以这张牌为准；-1 表示底牌堆为空。由 MoveService 维护，控制器只读取
+    int topCardId = -1;
+
+    // **备用堆的顺序（卡牌 ID，从底到顶，不含初始底牌）**
+    // 由 MoveService::dealStack 在发牌时确定；被抽走的牌仍保留在列表中（回退时要回到原来的位置）
+    std::vector<int> stockCardIds;
+
+    // **按 ID 查找卡牌**
+    // @param id 要查找的卡牌唯一标识
+    // @return 如果找到返回该卡牌的 shared_ptr，否则返回 nullptr
+    // @note 生成器按 0,1,2... 顺序分配 ID，命中时直接按下标取，否则退回线性查找
+    std::shared_ptr<CardModel> getCardById(int id) const {
+        if (id >= 0 && id < (int)allCards.size() && allCards[id]->getId() == id) return allCards[id];
         for (auto& card : allCards) {
             if (card->getId() == id) return card;
         }
         return nullptr;
     }
 
-    // **ע¿**
-    // ɵ CardModel ʵӵݼУϵͳʹá
+    // **获取底牌堆顶部的卡牌**
+    std::shared_ptr<CardModel> getTopCard() const {
+        return topCardId >= 0 ? getCardById(topCardId) : nullptr;
+    }
+
+    // **从另一个模型复制全部状态**
+    // 卡牌数量相同时逐张按值覆盖，不重新分配内存（回放校验时每局复用同一个模型）
+    void copyStateFrom(const GameModel& other) {
+        if (allCards.size() != other.allCards.size()) {
+            allCards.clear();
+            for (const auto& card : other.allCards) {
+                allCards.push_back(std::make_shared<CardModel>(*card));
+            }
+        }
+        else {
+            for (size_t i = 0; i < allCards.size(); ++i) {
+                *allCards[i] = *other.allCards[i];
+            }
+        }
+        topCardId = other.topCardId;
+        stockCardIds = other.stockCardIds;
+    }
+
+    // **注册新卡牌**
+    // 将生成的 CardModel 实例添加到主数据集合中，供所有系统共享使用。
     void addCard(std::shared_ptr<CardModel> card) {
         allCards.push_back(card);
     }
 
-    // **յǰؿ**
-    // ͨ¼عؿ˳Ϸʱãȷûá
+    // **清空当前关卡数据**
+    // 通常在重新加载关卡或退出游戏时调用，确保没有悬挂引用。
     void clear() {
         allCards.clear();
+        topCardId = -1;
+        stockCardIds.clear();
     }
 };
 
@@ -0,0 +1,42 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include "models/UndoModel.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 单张卡牌的存档数据 (CardSnapshot)
+ * @note 牌面、花色、原始位置来自关卡配置，读档时由关卡重新生成，不写入存档
+ */
+struct CardSnapshot {
+    int32_t id = -1;                        // 卡牌ID
+    CardState state = CardState::FACE_DOWN; // 翻开 / 覆盖
+    int32_t zIndex = 0;                     // 层级
+    Vector2 position;                       // 位置（存档时布局下的屏幕坐标）
+};
+
+/**
+ * @brief 进行中一局游戏的存档 (GameSnapshot)
+ * 职责：恢复一局游戏所需的全部可变状态，由 SnapshotService 采集 / 写回、SnapshotCodec 编解码
+ *
+ * @details
+ * - layoutWidth / layoutHeight：存档时的可见区域尺寸；读档时屏幕尺寸不同，
+ *   按两套布局换算卡牌位置和回退历史中的位置（与 GameController::relayout 相同）
+ * - sessionTimeMs：本局已进行的时间，读档后回放时间戳从这里继续
+ * - replay：本局录制到一半的回放（ReplayCodec 编码），读档后继续录制，为空表示没有录制
+ */
+struct GameSnapshot {
+    uint32_t levelId = 0;                   // 关卡ID
+    uint16_t ruleSet = 0;                   // 存档时的规则版本
+    float layoutWidth = 0.0f;               // 存档时的可见区域宽度
+    float layoutHeight = 0.0f;              // 存档时的可见区域高度
+    uint32_t sessionTimeMs = 0;             // 本局已进行的时间（毫秒）
+    int32_t topCardId = -1;                 // 底牌堆顶部的卡牌ID
+    std::vector<CardSnapshot> cards;        // 按 GameModel::allCards 顺序排列
+    std::vector<int32_t> stockCardIds;      // 备用堆的顺序（从底到顶）
+    std::vector<UndoCommand> undoHistory;   // 回退历史（从旧到新）
+    std::vector<uint8_t> replay;            // 录制中的回放
+};
+
+#endif // GAME_SNAPSHOT_H
@@ -0,0 +1,34 @@
+#ifndef INPUT_COMMAND_H
+#define INPUT_COMMAND_H
+
+#include <cstdint>
+
+/**
+ * @brief 输入命令类型
+ * 按点击来源区分，GameController 据此把命令交给对应的子控制器
+ */
+enum class InputCommandType : uint8_t {
+    PLAYFIELD_TAP,  // 点击主牌区的卡牌
+    STACK_TAP,      // 点击备用堆的卡牌
+    UNDO            // 点击 Undo 按钮
+};
+
+/**
+ * @brief 输入命令结构体 (InputCommand)
+ * 职责：记录一次用户输入的最小信息，由触摸回调生成、压入队列，在每帧开始时统一处理
+ * 特性：定长 12 字节的纯数据，不持有任何指针，便于批量拷贝和录制
+ */
+struct InputCommand {
+    InputCommandType type;      // 命令类型
+    int32_t cardId;             // 被点击的卡牌ID（UNDO 时为 -1）
+    uint32_t frame;             // 产生输入时的帧号
+
+    InputCommand()
+        : type(InputCommandType::UNDO), cardId(-1), frame(0) {}
+
+    InputCommand(InputCommandType t, int32_t id, uint32_t f)
+        : type(t), cardId(id), frame(f) {
+    }
+};
+
+#endif // INPUT_COMMAND_H
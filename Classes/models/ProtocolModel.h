@@ -0,0 +1,81 @@
+#ifndef PROTOCOL_MODEL_H
+#define PROTOCOL_MODEL_H
+
+#include "models/InputCommand.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 帧类型（每帧的第一个字节）
+ */
+enum class FrameType : uint8_t {
+    JOIN = 1,       // 客户端 -> 服务端：加入关卡
+    JOINED = 2,     // 服务端 -> 客户端：分配的会话
+    MOVE_BATCH = 3, // 客户端 -> 服务端：一帧内的所有操作
+    ACK_BATCH = 4   // 服务端 -> 客户端：对一批操作的权威结果
+};
+
+/**
+ * @brief 服务端对一步操作的判定
+ */
+enum class AckStatus : uint8_t {
+    ACCEPTED,   // 合法并已执行
+    REJECTED,   // 不符合规则，服务端状态未改变
+    NO_SESSION  // 会话不存在
+};
+
+/**
+ * @brief 加入关卡：客户端附带自己计算的初始状态哈希，服务端据此确认双方的关卡一致
+ */
+struct JoinFrame {
+    uint32_t levelId = 0;
+    uint16_t ruleSet = 0;
+    uint64_t initialHash = 0;
+};
+
+/**
+ * @brief 加入结果：sessionId 为 0 表示拒绝（关卡未知或规则版本不同）
+ */
+struct JoinedFrame {
+    uint64_t sessionId = 0;
+    uint64_t initialHash = 0;   // 服务端的初始状态哈希
+};
+
+/**
+ * @brief 协议中的一步操作
+ */
+struct ProtocolMove {
+    InputCommandType type = InputCommandType::UNDO;
+    int32_t cardId = -1;
+
+    ProtocolMove() {}
+    ProtocolMove(InputCommandType t, int32_t id) : type(t), cardId(id) {}
+};
+
+/**
+ * @brief 一批操作：序号从 firstSeq 开始连续递增
+ */
+struct MoveBatchFrame {
+    uint64_t sessionId = 0;
+    uint32_t firstSeq = 0;
+    std::vector<ProtocolMove> moves;
+};
+
+/**
+ * @brief 服务端对一步操作的确认
+ */
+struct MoveAck {
+    AckStatus status = AckStatus::NO_SESSION;
+    uint32_t stateHash = 0;     // 执行后的状态哈希（GameStateHasher 结果的低 32 位）
+};
+
+/**
+ * @brief 一批确认，与 MoveBatchFrame 一一对应
+ */
+struct AckBatchFrame {
+    uint64_t sessionId = 0;
+    uint32_t firstSeq = 0;
+    std::vector<MoveAck> acks;
+};
+
+#endif // PROTOCOL_MODEL_H
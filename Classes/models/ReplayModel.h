@@ -0,0 +1,44 @@
+#ifndef REPLAY_MODEL_H
+#define REPLAY_MODEL_H
+
+#include "models/InputCommand.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 回放中的一步操作 (ReplayMove)
+ * 职责：记录一条被游戏逻辑接受的输入命令，以及执行后的状态哈希
+ */
+struct ReplayMove {
+    InputCommandType type;      // 命令类型
+    int32_t cardId;             // 被点击的卡牌ID（UNDO 时为 -1）
+    uint32_t timeMs;            // 距录制开始的时间（毫秒）
+    uint32_t stateHash;         // 执行后的状态哈希（GameStateHasher 结果的低 32 位）
+
+    ReplayMove()
+        : type(InputCommandType::UNDO), cardId(-1), timeMs(0), stateHash(0) {}
+
+    ReplayMove(InputCommandType t, int32_t id, uint32_t time, uint32_t hash)
+        : type(t), cardId(id), timeMs(time), stateHash(hash) {
+    }
+};
+
+/**
+ * @brief 一局游戏的完整回放 (ReplayData)
+ * 职责：重现一局游戏所需的全部信息，由 ReplayRecorder 生成、ReplayCodec 编解码
+ *
+ * @note 
+ * - seed：关卡生成目前是确定性的，不使用随机数，固定为 0，为随机发牌预留
+ * - ruleSet：录制时的规则版本（GameLogicService::RULE_SET_VERSION），版本不同的回放不能播放
+ * - initialHash：关卡初始化完成后的状态哈希，关卡文件被修改时回放在第一步之前就会被拒绝
+ */
+struct ReplayData {
+    uint32_t levelId = 0;               // 关卡ID
+    uint32_t seed = 0;                  // 随机种子（预留）
+    uint16_t ruleSet = 0;               // 规则版本
+    uint64_t initialHash = 0;           // 初始状态哈希
+    std::vector<ReplayMove> moves;      // 按时间顺序排列的操作
+    uint64_t finalHash = 0;             // 最后一步之后的完整状态哈希
+};
+
+#endif // REPLAY_MODEL_H
@@ -0,0 +1,56 @@
+#ifndef TELEMETRY_EVENT_H
+#define TELEMETRY_EVENT_H
+
+#include "models/InputCommand.h"
+#include <cstdint>
+
+/**
+ * @brief 遥测事件类型
+ */
+enum class TelemetryEventType : uint8_t {
+    LEVEL_START,    // 开始一局（detail：1 表示从存档恢复）
+    MOVE,           // 一次被接受的出牌 / 抽牌（detail：InputCommandType）
+    UNDO,           // 一次被接受的撤销
+    LEVEL_END       // 一局结束（detail：LevelOutcome）
+};
+
+/**
+ * @brief 一局的结果
+ */
+enum class LevelOutcome : uint8_t {
+    ABANDONED,      // 主牌区还有牌时离开关卡
+    CLEARED         // 主牌区的牌全部移到了底牌堆
+};
+
+/**
+ * @brief 遥测事件 (TelemetryEvent)
+ * 职责：一条分析事件的全部信息，由主线程写入环形缓冲，后台线程批量写入文件
+ * 特性：定长 32 字节的纯数据，不持有字符串和指针；各字段的含义随 type 变化：
+ * - elapsedMs：MOVE / UNDO 为距上一次操作（或开局）的毫秒数，LEVEL_END 为本局时长
+ * - value：MOVE 为卡牌ID，LEVEL_END 为主牌区剩余张数，其它为 0
+ */
+struct TelemetryEvent {
+    uint64_t timestampMs = 0;   // 系统时间（Unix 毫秒）
+    uint32_t playId = 0;        // 一局的ID，同一局的事件相同
+    uint16_t levelId = 0;       // 关卡ID
+    TelemetryEventType type = TelemetryEventType::MOVE;
+    uint8_t detail = 0;
+    uint32_t elapsedMs = 0;
+    int32_t value = 0;
+    uint16_t moveCount = 0;     // 本局到这条事件为止被接受的操作数（含撤销）
+    uint16_t undoCount = 0;     // 本局到这条事件为止的撤销次数
+    uint32_t reserved = 0;
+};
+
+/**
+ * @brief 一局的遥测上下文
+ * 职责：GameController 为当前一局维护的计数，每条事件从这里取 playId / 关卡 / 计数
+ */
+struct TelemetryPlay {
+    uint32_t playId = 0;
+    uint16_t levelId = 0;
+    uint16_t moveCount = 0;
+    uint16_t undoCount = 0;
+};
+
+#endif // TELEMETRY_EVENT_H
@@ -0,0 +1,49 @@
+#ifndef TELEMETRY_SUMMARY_H
+#define TELEMETRY_SUMMARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+/**
+ * @brief 一个关卡的遥测汇总 (TelemetryLevelSummary)
+ * 职责：离线统计一个关卡的漏斗、撤销率和流失点
+ * 特性：只有计数和累加值，两份汇总逐项相加即可合并，与事件的处理顺序和分组无关
+ */
+struct TelemetryLevelSummary {
+    // 流失点直方图的桶数：第 n 个桶为结束时有 n 次操作的局数，最后一个桶包含更多次的
+    static const size_t DROPOFF_BUCKETS = 128;
+
+    // ========== 漏斗 ==========
+    uint64_t starts = 0;            // 新开的局（LEVEL_START，不含从存档恢复）
+    uint64_t resumes = 0;           // 从存档恢复的局
+    uint64_t ends = 0;              // 有 LEVEL_END 的局
+    uint64_t cleared = 0;
+    uint64_t abandoned = 0;
+
+    // ========== 操作 ==========
+    uint64_t moves = 0;             // MOVE 事件数
+    uint64_t undos = 0;             // UNDO 事件数
+    uint64_t thinkMsTotal = 0;      // MOVE / UNDO 距上一次操作的毫秒数之和
+
+    // ========== 结束时 ==========
+    uint64_t durationMsTotal = 0;       // 各局时长之和
+    uint64_t endMovesTotal = 0;         // 各局结束时的操作数之和
+    uint64_t endUndosTotal = 0;         // 各局结束时的撤销数之和
+    uint64_t cardsLeftTotal = 0;        // 放弃的局剩余主牌区张数之和
+
+    uint64_t abandonedAtMoves[DROPOFF_BUCKETS] = {};
+    uint64_t clearedAtMoves[DROPOFF_BUCKETS] = {};
+};
+
+/**
+ * @brief 一组遥测文件的汇总 (TelemetrySummary)
+ * 职责：按关卡ID排列的各关卡汇总，以及输入数据本身的计数
+ */
+struct TelemetrySummary {
+    uint64_t events = 0;            // 处理过的事件数
+    uint64_t unknownEvents = 0;     // 类型无法识别的事件数（新版本写入的类型），不计入关卡
+    std::map<uint16_t, TelemetryLevelSummary> levels;
+};
+
+#endif // TELEMETRY_SUMMARY_H
@@ -1,7 +1,7 @@
 #ifndef UNDO_MODEL_H
 #define UNDO_MODEL_H
 
-#include "cocos2d.h"
+#include "utils/Vector2.h"
 #include "configs/GameConsts.h"
 
 /**
@@ -10,17 +10,17 @@
  */
 struct UndoCommand {
     int cardId;                 // 被操作的卡牌ID
-    cocos2d::Vec2 fromPos;      // 移动前的位置
+    Vector2 fromPos;            // 移动前的位置
     int prevTopCardId;          // 操作前，堆牌区顶部的卡牌ID (用于恢复 StackController 的状态)
     CardState prevState;        // 操作前的状态 (比如在备用堆是背面的)
     int prevZIndex;             // 操作前的层级
 
     // 默认构造函数
     UndoCommand() 
-        : cardId(-1), fromPos(cocos2d::Vec2::ZERO), prevTopCardId(-1), prevState(CardState::FACE_DOWN), prevZIndex(0) {}
+        : cardId(-1), fromPos(Vector2::ZERO), prevTopCardId(-1), prevState(CardState::FACE_DOWN), prevZIndex(0) {}
 
     // 带参构造函数 (方便快速赋值)
-    UndoCommand(int id, cocos2d::Vec2 pos, int topId, CardState state, int z)
+    UndoCommand(int id, Vector2 pos, int topId, CardState state, int z)
         : cardId(id), fromPos(pos), prevTopCardId(topId), prevState(state), prevZIndex(z) {
     }
 };
@@ -0,0 +1,31 @@
+#ifndef WORKER_RESULT_H
+#define WORKER_RESULT_H
+
+#include <cstdint>
+
+/**
+ * @brief 后台任务结果类型
+ */
+enum class WorkerResultType : uint8_t {
+    SAVE_WRITTEN,       // 存档已写入
+    SAVE_QUEUED,        // 存档已交给 AsyncFileWriter，由 IO 线程落盘
+    SAVE_STALE,         // 编码前又发布了新状态，本次存档放弃
+    SAVE_FAILED,        // 存档写入失败
+    REPLAY_WRITTEN,     // 回放文件已写入
+    REPLAY_FAILED       // 回放文件写入失败
+};
+
+/**
+ * @brief 后台任务结果记录 (WorkerResult)
+ * 职责：工作线程把结果交给主线程的最小信息，经无锁队列传递，每帧由 GameController 统一处理
+ * 特性：定长纯数据，不持有字符串和指针；入队时只做一次拷贝，不分配内存
+ */
+struct WorkerResult {
+    WorkerResultType type = WorkerResultType::SAVE_WRITTEN;
+    int32_t levelId = 0;        // 关卡ID
+    uint32_t bytes = 0;         // 写入的字节数
+    uint32_t moves = 0;         // 回放中的操作数
+    uint64_t stateVersion = 0;  // 存档对应的发布版本（GameStatePublisher）
+};
+
+#endif // WORKER_RESULT_H
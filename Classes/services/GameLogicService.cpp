@@ -3,23 +3,25 @@
 #include "services/GameLogicService.h"
 #include <cmath>
 
+const uint16_t GameLogicService::RULE_SET_VERSION;
+
 bool GameLogicService::canMatch(const CardModel* handCard, const CardModel* fieldCard) {
     if (!handCard || !fieldCard) return false;
 
-    // ȡƵĵ (int)
+    // 获取两个牌的点数 (int)
     int faceA = (int)handCard->getFace();
     int faceB = (int)fieldCard->getFace();
 
-    //  1: ƥ
-    //  1 (: 34910)
+    // 规则 1: 常规匹配
+    // 点数相差 1 (例如: 3和4，9和10)
     int diff = std::abs(faceA - faceB);
     if (diff == 1) {
         return true;
     }
 
-    //  2: K  A ѭƥ (߼)
-    // ڵ 0-based УAce0King12
-    // ֻҪжһ Ace(0) һ King(12) ɡ
+    // 规则 2: K 和 A 循环匹配 (新增逻辑)
+    // 在我们现在的 0-based 定义中：Ace是0，King是12。
+    // 所以只要判断一张是 Ace(0) 且另一张是 King(12) 即可。
     if ((faceA == (int)CardFaceType::CFT_ACE && faceB == (int)CardFaceType::CFT_KING) ||
         (faceA == (int)CardFaceType::CFT_KING && faceB == (int)CardFaceType::CFT_ACE)) {
         return true;
@@ -28,7 +30,7 @@ bool GameLogicService::canMatch(const CardModel* handCard, const CardModel* fiel
     return false;
 }
 
-void GameLogicService::applyMove(CardModel* card, const cocos2d::Vec2& targetPos, int newZIndex) {
+void GameLogicService::applyMove(CardModel* card, const Vector2& targetPos, int newZIndex) {
     if (card) {
         card->setPosition(targetPos);
         card->setZIndex(newZIndex);
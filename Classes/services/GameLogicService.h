@@ -4,18 +4,22 @@
 #define GAME_LOGIC_SERVICE_H
 
 #include "models/CardModel.h"
+#include <cstdint>
 
 class GameLogicService {
 public:
-    // [ֻ߼] жǷƥ
+    // 规则版本：修改匹配或移动规则时递增，录制的回放只能在相同版本下播放
+    static const uint16_t RULE_SET_VERSION = 1;
+
+    // [只读逻辑] 判断是否匹配
     static bool canMatch(const CardModel* handCard, const CardModel* fieldCard);
 
-    // [д߼] ִпƶݱ
-    // ݲ޸λá޸Ĳ㼶
-    static void applyMove(CardModel* card, const cocos2d::Vec2& targetPos, int newZIndex);
+    // [写逻辑] 执行卡牌移动的数据变更
+    // 纯粹的数据操作：修改位置、修改层级
+    static void applyMove(CardModel* card, const Vector2& targetPos, int newZIndex);
 
-    // [д߼] ִп״̬
-    // ݲ
+    // [写逻辑] 执行卡牌状态变更
+    // 纯粹的数据操作：翻面
     static void applyStateChange(CardModel* card, CardState newState);
 };
 
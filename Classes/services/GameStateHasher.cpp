@@ -0,0 +1,29 @@
+#include "services/GameStateHasher.h"
+
+namespace {
+    const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+    const uint64_t kFnvPrime = 1099511628211ULL;
+
+    // 按小端字节序逐字节混入
+    void mix(uint64_t& h, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            h ^= (value >> (i * 8)) & 0xFF;
+            h *= kFnvPrime;
+        }
+    }
+}
+
+uint64_t GameStateHasher::hash(const GameModel& model, size_t undoDepth) {
+    uint64_t h = kFnvOffsetBasis;
+
+    mix(h, (uint32_t)model.allCards.size());
+    for (const auto& card : model.allCards) {
+        mix(h, (uint32_t)card->getId());
+        mix(h, (uint32_t)card->getState());
+        mix(h, (uint32_t)card->getZIndex());
+    }
+
+    mix(h, (uint32_t)model.topCardId);
+    mix(h, (uint32_t)undoDepth);
+    return h;
+}
@@ -0,0 +1,25 @@
+#ifndef GAME_STATE_HASHER_H
+#define GAME_STATE_HASHER_H
+
+#include "models/GameModel.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 游戏状态哈希服务
+ * 职责：把一局游戏的逻辑状态压缩为 64 位 FNV-1a 哈希，用于回放校验
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details 参与哈希的字段（按 allCards 顺序逐张写入，整数统一按小端字节序展开，结果与平台无关）：
+ * - 卡牌：ID、状态、层级
+ * - 底牌堆顶部卡牌ID（GameModel::topCardId）、回退历史深度
+ *
+ * @note 卡牌位置是屏幕坐标，随屏幕尺寸和布局变化，不参与哈希；
+ *       在现有规则下位置完全由层级和底牌堆顶部决定，不会漏掉状态差异
+ */
+class GameStateHasher {
+public:
+    static uint64_t hash(const GameModel& model, size_t undoDepth);
+};
+
+#endif // GAME_STATE_HASHER_H
@@ -0,0 +1,91 @@
+// Classes/services/LayoutService.cpp
+
+#include "services/LayoutService.h"
+#include <algorithm>
+
+using namespace cocos2d;
+
+// 底部操作区（备用堆 / 底牌堆 / Undo）的高度
+static const float kBottomAreaHeight = 580.0f;
+
+// 关卡编辑约定：主牌区坐标整体上移 250 像素后正好位于底部操作区之上
+static const float kPlayfieldOffsetY = 250.0f;
+
+// 卡牌尺寸（card_general.png），用于把卡牌中心点扩展为包围盒
+static const Size kCardSize = Size(182, 282);
+
+// 主牌区允许的最小缩放，防止极端窗口尺寸下缩成一个点
+static const float kMinPlayfieldScale = 0.1f;
+
+Rect LayoutService::computePlayfieldBounds(const LevelConfig& config) {
+    if (config.playFieldCards.empty()) return Rect::ZERO;
+
+    float minX = config.playFieldCards[0].position.x;
+    float maxX = minX;
+    float minY = config.playFieldCards[0].position.y;
+    float maxY = minY;
+    for (const auto& cardData : config.playFieldCards) {
+        minX = std::min(minX, cardData.position.x);
+        maxX = std::max(maxX, cardData.position.x);
+        minY = std::min(minY, cardData.position.y);
+        maxY = std::max(maxY, cardData.position.y);
+    }
+
+    // 中心点范围向外扩半张牌
+    return Rect(minX - kCardSize.width / 2, minY - kCardSize.height / 2,
+        maxX - minX + kCardSize.width, maxY - minY + kCardSize.height);
+}
+
+ScreenLayout LayoutService::computeLayout(const Size& visibleSize, const Rect& playfieldBounds) {
+    ScreenLayout layout;
+    layout.visibleSize = visibleSize;
+    layout.bottomAreaHeight = kBottomAreaHeight;
+
+    // ========== 1. 主牌区：优先保持关卡原始坐标，放不下时等比缩小并居中 ==========
+    Rect area(0, kBottomAreaHeight, visibleSize.width, visibleSize.height - kBottomAreaHeight);
+    layout.playfieldScale = 1.0f;
+    layout.playfieldOffset = Vec2(0, kPlayfieldOffsetY);
+
+    if (playfieldBounds.size.width > 0 && playfieldBounds.size.height > 0) {
+        float minX = playfieldBounds.getMinX();
+        float maxX = playfieldBounds.getMaxX();
+        float minY = playfieldBounds.getMinY() + kPlayfieldOffsetY;
+        float maxY = playfieldBounds.getMaxY() + kPlayfieldOffsetY;
+        bool fits = minX >= area.getMinX() && maxX <= area.getMaxX()
+            && minY >= area.getMinY() && maxY <= area.getMaxY();
+
+        if (!fits) {
+            float scale = std::min(area.size.width / playfieldBounds.size.width,
+                area.size.height / playfieldBounds.size.height);
+            layout.playfieldScale = std::max(kMinPlayfieldScale, std::min(1.0f, scale));
+
+            Vec2 boundsCenter(playfieldBounds.getMidX(), playfieldBounds.getMidY());
+            Vec2 areaCenter(area.getMidX(), area.getMidY());
+            layout.playfieldOffset = areaCenter - boundsCenter * layout.playfieldScale;
+        }
+    }
+
+    layout.cardScale = layout.playfieldScale;
+
+    // ========== 2. 底部操作区：各锚点相对屏幕中线摆放，垂直居中 ==========
+    float centerY = kBottomAreaHeight / 2;
+    layout.stockPos = Vec2(visibleSize.width / 2 - 250, centerY);
+    layout.activePos = Vec2(visibleSize.width / 2 + 150, centerY);
+    layout.stockBadgePos = layout.stockPos + Vec2(0, -170);
+    layout.undoButtonPos = Vec2(visibleSize.width * 0.85f, centerY);
+
+    return layout;
+}
+
+Vec2 LayoutService::remapPosition(const ScreenLayout& from, const ScreenLayout& to, const Vec2& pos) {
+    if (pos.y < from.bottomAreaHeight) {
+        // 底部操作区：底牌堆右侧的点跟随底牌堆，其余（含扇形展开的备用牌）跟随备用堆
+        if (pos.x >= from.activePos.x - kCardSize.width / 2) {
+            return to.activePos + (pos - from.activePos);
+        }
+        return to.stockPos + (pos - from.stockPos);
+    }
+
+    // 主牌区：先还原为关卡坐标，再按新布局变换
+    return to.toScreen(from.toLevel(pos));
+}
@@ -0,0 +1,58 @@
+// Classes/services/LayoutService.h
+
+#ifndef LAYOUT_SERVICE_H
+#define LAYOUT_SERVICE_H
+
+#include "cocos2d.h"
+#include "configs/models/LevelConfig.h"
+
+/**
+ * @brief 屏幕布局结果（纯数据）
+ *
+ * @details 由 LayoutService 针对"关卡 + 屏幕尺寸"计算一次，之后所有子系统只读取它：
+ * - GameView：上下背景分界线、Undo 按钮位置
+ * - PlayFieldController：关卡坐标 -> 屏幕坐标的缩放平移
+ * - StackController：备用堆、底牌堆、角标位置
+ */
+struct ScreenLayout {
+    cocos2d::Size visibleSize;          // 可见区域尺寸
+    float bottomAreaHeight = 0.0f;      // 底部操作区高度（上下背景分界线）
+
+    float playfieldScale = 1.0f;        // 主牌区缩放（关卡坐标 -> 屏幕坐标）
+    cocos2d::Vec2 playfieldOffset;      // 主牌区平移（缩放之后叠加）
+    float cardScale = 1.0f;             // 卡牌视图缩放，与主牌区缩放一致，保证牌飞到底牌堆后大小不变
+
+    cocos2d::Vec2 stockPos;             // 备用堆（左侧）起始位置
+    cocos2d::Vec2 activePos;            // 底牌堆（右侧）位置
+    cocos2d::Vec2 stockBadgePos;        // 备用堆剩余张数角标位置
+    cocos2d::Vec2 undoButtonPos;        // Undo 按钮位置
+
+    // 关卡配置中的坐标 -> 屏幕坐标
+    cocos2d::Vec2 toScreen(const cocos2d::Vec2& levelPos) const {
+        return levelPos * playfieldScale + playfieldOffset;
+    }
+
+    // 屏幕坐标 -> 关卡配置中的坐标
+    cocos2d::Vec2 toLevel(const cocos2d::Vec2& screenPos) const {
+        return (screenPos - playfieldOffset) / playfieldScale;
+    }
+};
+
+/**
+ * @brief 布局服务（无状态）
+ * 职责：根据关卡主牌区范围和屏幕尺寸计算 ScreenLayout，并在两套布局之间换算坐标
+ */
+class LayoutService {
+public:
+    // [只读逻辑] 计算关卡主牌区的包围盒（关卡坐标，已包含卡牌尺寸），每个关卡只需计算一次
+    static cocos2d::Rect computePlayfieldBounds(const LevelConfig& config);
+
+    // [只读逻辑] 计算主牌区在屏幕上的缩放平移，以及各区域的锚点
+    static ScreenLayout computeLayout(const cocos2d::Size& visibleSize, const cocos2d::Rect& playfieldBounds);
+
+    // [只读逻辑] 把按 from 布局摆放的屏幕坐标换算到 to 布局
+    // 底部操作区内的点跟随备用堆/底牌堆锚点平移，主牌区内的点按主牌区变换换算
+    static cocos2d::Vec2 remapPosition(const ScreenLayout& from, const ScreenLayout& to, const cocos2d::Vec2& pos);
+};
+
+#endif // LAYOUT_SERVICE_H
@@ -0,0 +1,121 @@
+#include "services/MoveProtocol.h"
+#include "utils/BinaryIO.h"
+
+const uint8_t MoveProtocol::PROTOCOL_VERSION;
+
+namespace {
+    // 读取并检查帧类型
+    bool readType(BinaryReader& reader, FrameType expected) {
+        return reader.readU8() == (uint8_t)expected && reader.ok();
+    }
+}
+
+bool MoveProtocol::peekType(const uint8_t* data, size_t size, FrameType& type) {
+    if (!data || size == 0) return false;
+    type = (FrameType)data[0];
+    return true;
+}
+
+// ========== JOIN ==========
+
+void MoveProtocol::encode(const JoinFrame& frame, std::vector<uint8_t>& out) {
+    BinaryWriter writer(out);
+    writer.writeU8((uint8_t)FrameType::JOIN);
+    writer.writeU8(PROTOCOL_VERSION);
+    writer.writeVarint(frame.levelId);
+    writer.writeVarint(frame.ruleSet);
+    writer.writeFixed(frame.initialHash, 8);
+}
+
+bool MoveProtocol::decode(const uint8_t* data, size_t size, JoinFrame& frame) {
+    BinaryReader reader(data, size);
+    if (!readType(reader, FrameType::JOIN)) return false;
+    if (reader.readU8() != PROTOCOL_VERSION) return false;
+    frame.levelId = (uint32_t)reader.readVarint();
+    frame.ruleSet = (uint16_t)reader.readVarint();
+    frame.initialHash = reader.readFixed(8);
+    return reader.ok() && reader.atEnd();
+}
+
+// ========== JOINED ==========
+
+void MoveProtocol::encode(const JoinedFrame& frame, std::vector<uint8_t>& out) {
+    BinaryWriter writer(out);
+    writer.writeU8((uint8_t)FrameType::JOINED);
+    writer.writeVarint(frame.sessionId);
+    writer.writeFixed(frame.initialHash, 8);
+}
+
+bool MoveProtocol::decode(const uint8_t* data, size_t size, JoinedFrame& frame) {
+    BinaryReader reader(data, size);
+    if (!readType(reader, FrameType::JOINED)) return false;
+    frame.sessionId = reader.readVarint();
+    frame.initialHash = reader.readFixed(8);
+    return reader.ok() && reader.atEnd();
+}
+
+// ========== MOVE_BATCH ==========
+
+void MoveProtocol::encode(const MoveBatchFrame& frame, std::vector<uint8_t>& out) {
+    BinaryWriter writer(out);
+    writer.writeU8((uint8_t)FrameType::MOVE_BATCH);
+    writer.writeVarint(frame.sessionId);
+    writer.writeVarint(frame.firstSeq);
+    writer.writeVarint(frame.moves.size());
+    for (const auto& move : frame.moves) {
+        writer.writeU8((uint8_t)move.type);
+        writer.writeSignedVarint(move.cardId);
+    }
+}
+
+bool MoveProtocol::decode(const uint8_t* data, size_t size, MoveBatchFrame& frame) {
+    BinaryReader reader(data, size);
+    if (!readType(reader, FrameType::MOVE_BATCH)) return false;
+    frame.sessionId = reader.readVarint();
+    frame.firstSeq = (uint32_t)reader.readVarint();
+
+    // 每步至少 2 字节，用剩余长度限制预分配
+    uint64_t count = reader.readVarint();
+    if (!reader.ok() || count > reader.remaining() / 2) return false;
+    frame.moves.resize((size_t)count);
+    for (auto& move : frame.moves) {
+        uint8_t type = reader.readU8();
+        if (type > (uint8_t)InputCommandType::UNDO) return false;
+        move.type = (InputCommandType)type;
+        move.cardId = reader.readSignedVarint();
+    }
+    return reader.ok() && reader.atEnd();
+}
+
+// ========== ACK_BATCH ==========
+
+void MoveProtocol::encode(const AckBatchFrame& frame, std::vector<uint8_t>& out) {
+    BinaryWriter writer(out);
+    writer.writeU8((uint8_t)FrameType::ACK_BATCH);
+    writer.writeVarint(frame.sessionId);
+    writer.writeVarint(frame.firstSeq);
+    writer.writeVarint(frame.acks.size());
+    for (const auto& ack : frame.acks) {
+        writer.writeU8((uint8_t)ack.status);
+        writer.writeFixed(ack.stateHash, 4);
+    }
+}
+
+bool MoveProtocol::decode(const uint8_t* data, size_t size, AckBatchFrame& frame) {
+    BinaryReader reader(data, size);
+    if (!readType(reader, FrameType::ACK_BATCH)) return false;
+    frame.sessionId = reader.readVarint();
+    frame.firstSeq = (uint32_t)reader.readVarint();
+
+    // 每步固定 5 字节
+    uint64_t count = reader.readVarint();
+    if (!reader.ok() || count > reader.remaining() / 5) return false;
+    frame.acks.resize((size_t)count);
+    for (auto& ack : frame.acks) {
+        uint8_t status = reader.readU8();
+        if (status > (uint8_t)AckStatus::NO_SESSION) return false;
+        ack.status = (AckStatus)status;
+        ack.stateHash = (uint32_t)reader.readFixed(4);
+    }
+    return reader.ok() && reader.atEnd();
+}
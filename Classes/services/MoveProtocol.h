@@ -0,0 +1,45 @@
+#ifndef MOVE_PROTOCOL_H
+#define MOVE_PROTOCOL_H
+
+#include "models/ProtocolModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 服务端权威模式的帧编解码服务
+ * 职责：客户端与服务端之间各类帧与紧凑二进制之间的互相转换
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details 二进制格式（整数均为小端，帧的边界由传输层负责）：
+ * ```
+ * JOIN        类型(u8)  协议版本(u8)  关卡ID(varint)  规则版本(varint)  初始哈希(u64)
+ * JOINED      类型(u8)  会话(varint)  初始哈希(u64)
+ * MOVE_BATCH  类型(u8)  会话(varint)  起始序号(varint)  操作数(varint)  每步：类型(u8)  卡牌ID(zigzag varint)
+ * ACK_BATCH   类型(u8)  会话(varint)  起始序号(varint)  确认数(varint)  每步：结果(u8)  状态哈希(u32)
+ * ```
+ * 一步操作 2~3 字节，一步确认 5 字节；一帧内的多次点击合并为一个 MOVE_BATCH
+ */
+class MoveProtocol {
+public:
+    // 协议版本，修改格式时递增
+    static const uint8_t PROTOCOL_VERSION = 1;
+
+    // 读取帧类型，数据为空时返回 false
+    static bool peekType(const uint8_t* data, size_t size, FrameType& type);
+
+    // 编码，结果追加到 out 末尾
+    static void encode(const JoinFrame& frame, std::vector<uint8_t>& out);
+    static void encode(const JoinedFrame& frame, std::vector<uint8_t>& out);
+    static void encode(const MoveBatchFrame& frame, std::vector<uint8_t>& out);
+    static void encode(const AckBatchFrame& frame, std::vector<uint8_t>& out);
+
+    // 解码，类型不符、数据损坏或截断时返回 false
+    // 批量帧中 vector 的已有容量会被复用
+    static bool decode(const uint8_t* data, size_t size, JoinFrame& frame);
+    static bool decode(const uint8_t* data, size_t size, JoinedFrame& frame);
+    static bool decode(const uint8_t* data, size_t size, MoveBatchFrame& frame);
+    static bool decode(const uint8_t* data, size_t size, AckBatchFrame& frame);
+};
+
+#endif // MOVE_PROTOCOL_H
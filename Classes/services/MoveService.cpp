@@ -0,0 +1,104 @@
+#include "services/MoveService.h"
+#include "services/GameLogicService.h"
+
+// 底牌堆为空时第一张牌的层级
+static const int kBaseTopZIndex = 100;
+
+bool MoveService::canMovePlayFieldCard(const GameModel& model, int cardId) {
+    auto card = model.getCardById(cardId);
+    auto topCard = model.getTopCard();
+    if (!card || !topCard || isStackCard(*card)) return false;
+    return GameLogicService::canMatch(topCard.get(), card.get());
+}
+
+bool MoveService::canMoveStackCard(const GameModel& model, int cardId) {
+    auto card = model.getCardById(cardId);
+    if (!card || !isStackCard(*card)) return false;
+    // 只看位置，不看正反面：无论是否翻开，只要不是当前底牌就可以抽
+    return model.topCardId >= 0 && cardId != model.topCardId;
+}
+
+int MoveService::countPlayFieldCardsLeft(const GameModel& model) {
+    auto topCard = model.getTopCard();
+    int count = 0;
+    for (const auto& card : model.allCards) {
+        if (isStackCard(*card)) continue;
+        // 移到底牌堆的牌与底牌位置相同
+        if (topCard && card->getPosition().equals(topCard->getPosition())) continue;
+        count++;
+    }
+    return count;
+}
+
+int MoveService::moveToTop(GameModel& model, UndoManager& undoManager, CardModel* card, const Vector2& targetPos) {
+    // 1. 记录撤销命令（移动前的位置、状态、层级，以及当前的底牌）
+    undoManager.pushCommand(UndoCommand(card->getId(), card->getPosition(), model.topCardId, card->getState(), card->getZIndex()));
+
+    // 2. 新飞来的牌必须盖在旧底牌上面
+    auto topCard = model.getTopCard();
+    int newZ = topCard ? topCard->getZIndex() + 1 : kBaseTopZIndex;
+
+    // 3. 翻到正面、更新位置与层级，成为新的底牌
+    GameLogicService::applyStateChange(card, CardState::FACE_UP);
+    GameLogicService::applyMove(card, targetPos, newZ);
+    model.topCardId = card->getId();
+    return newZ;
+}
+
+bool MoveService::undo(GameModel& model, UndoManager& undoManager, UndoCommand& out) {
+    if (!undoManager.canUndo()) return false;
+    out = undoManager.popCommand();
+
+    auto currentCard = model.getCardById(out.cardId);
+    auto prevTopCard = model.getCardById(out.prevTopCardId);
+    if (currentCard && prevTopCard) {
+        GameLogicService::applyMove(currentCard.get(), out.fromPos, out.prevZIndex);
+        GameLogicService::applyStateChange(currentCard.get(), out.prevState);
+        model.topCardId = out.prevTopCardId;
+    }
+    return true;
+}
+
+bool MoveService::applyCommand(GameModel& model, UndoManager& undoManager, InputCommandType type, int cardId) {
+    switch (type) {
+    case InputCommandType::PLAYFIELD_TAP:
+        if (!canMovePlayFieldCard(model, cardId)) return false;
+        break;
+    case InputCommandType::STACK_TAP:
+        if (!canMoveStackCard(model, cardId)) return false;
+        break;
+    case InputCommandType::UNDO: {
+        UndoCommand cmd;
+        return undo(model, undoManager, cmd);
+    }
+    default:
+        return false;
+    }
+
+    auto card = model.getCardById(cardId);
+    moveToTop(model, undoManager, card.get(), model.getTopCard()->getPosition());
+    return true;
+}
+
+void MoveService::dealStack(GameModel& model, std::vector<std::shared_ptr<CardModel>>& stockCards) {
+    stockCards.clear();
+    model.stockCardIds.clear();
+    for (auto& card : model.allCards) {
+        if (isStackCard(*card)) stockCards.push_back(card);
+    }
+    if (stockCards.empty()) return;
+
+    // 初始底牌：最后一张，翻开
+    auto activeCard = stockCards.back();
+    stockCards.pop_back();
+    GameLogicService::applyMove(activeCard.get(), activeCard->getPosition(), kBaseTopZIndex);
+    GameLogicService::applyStateChange(activeCard.get(), CardState::FACE_UP);
+    model.topCardId = activeCard->getId();
+
+    // 备用牌：按顺序叠放，并记录顺序（存档 / 读档时据此重建备用堆）
+    for (int i = 0; i < (int)stockCards.size(); ++i) {
+        model.stockCardIds.push_back(stockCards[i]->getId());
+        GameLogicService::applyMove(stockCards[i].get(), stockCards[i]->getPosition(), i);
+        GameLogicService::applyStateChange(stockCards[i].get(), CardState::FACE_UP);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef MOVE_SERVICE_H
+#define MOVE_SERVICE_H
+
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/InputCommand.h"
+#include <vector>
+
+/**
+ * @brief 移动规则服务
+ * 职责：游戏规则的唯一实现——判定一步操作是否合法，并执行对应的数据变更（含回退记录）
+ * 特性：无状态服务 (Stateless Service)，只依赖核心库
+ *
+ * @details 
+ * - 客户端：控制器在判定和执行后负责播放动画
+ * - 回放校验 / 服务端：直接调用 applyCommand，没有任何视图
+ * 两边走同一套代码，保证同一串命令得到完全相同的状态
+ */
+class MoveService {
+public:
+    // [只读逻辑] 主牌区的卡牌能否移到底牌堆：属于主牌组，且与顶部卡牌点数相邻（K 和 A 循环）
+    static bool canMovePlayFieldCard(const GameModel& model, int cardId);
+
+    // [只读逻辑] 备用堆的卡牌能否移到底牌堆：属于备用牌组，且不是当前顶部卡牌
+    static bool canMoveStackCard(const GameModel& model, int cardId);
+
+    // [写逻辑] 把卡牌移到底牌堆顶部：记录回退、翻到正面、更新位置与层级，并成为新的顶部卡牌
+    // @return 卡牌的新层级
+    static int moveToTop(GameModel& model, UndoManager& undoManager, CardModel* card, const Vector2& targetPos);
+
+    // [写逻辑] 回退最近的一步操作，out 返回被回退的命令（供视图播放反向动画）
+    // @return 历史为空时返回 false
+    static bool undo(GameModel& model, UndoManager& undoManager, UndoCommand& out);
+
+    // [写逻辑] 判定并执行一条输入命令，目标位置取当前顶部卡牌的位置（无视图场景使用）
+    // @return 命令是否合法并已执行
+    static bool applyCommand(GameModel& model, UndoManager& undoManager, InputCommandType type, int cardId);
+
+    // [写逻辑] 初始发牌：备用牌组的最后一张翻开作为底牌（层级 100），其余依次叠入备用堆（层级 0,1,2...）
+    // @param stockCards 输出备用堆中的牌，从底到顶排列（会被清空后填充），同时记录到 GameModel::stockCardIds
+    // @note 只设置状态和层级，位置由调用方按屏幕布局决定
+    static void dealStack(GameModel& model, std::vector<std::shared_ptr<CardModel>>& stockCards);
+
+    // [读逻辑] 主牌区还没有移到底牌堆的张数（为 0 表示清空了主牌区）
+    static int countPlayFieldCardsLeft(const GameModel& model);
+
+    // 备用牌组的判定：关卡配置中没有位置（原点）的牌
+    static bool isStackCard(const CardModel& card) { return card.getOriginPosition().equals(Vector2::ZERO); }
+};
+
+#endif // MOVE_SERVICE_H
@@ -0,0 +1,74 @@
+#include "services/ReplayCodec.h"
+#include "utils/BinaryIO.h"
+
+const uint8_t ReplayCodec::FORMAT_VERSION;
+
+namespace {
+    const uint8_t kMagic[4] = { 'C', 'G', 'R', 'P' };
+}
+
+void ReplayCodec::encode(const ReplayData& replay, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + 32 + replay.moves.size() * 8);
+
+    BinaryWriter writer(out);
+
+    // ========== 头部 ==========
+    writer.writeBytes(kMagic, 4);
+    writer.writeU8(FORMAT_VERSION);
+    writer.writeVarint(replay.levelId);
+    writer.writeVarint(replay.seed);
+    writer.writeVarint(replay.ruleSet);
+    writer.writeFixed(replay.initialHash, 8);
+
+    // ========== 操作序列 ==========
+    // 时间戳按差值存储，连续点击的间隔通常一两个字节即可表示
+    writer.writeVarint(replay.moves.size());
+    uint32_t lastTimeMs = 0;
+    for (const auto& move : replay.moves) {
+        writer.writeU8((uint8_t)move.type);
+        writer.writeSignedVarint(move.cardId);
+        writer.writeVarint(move.timeMs - lastTimeMs);
+        writer.writeFixed(move.stateHash, 4);
+        lastTimeMs = move.timeMs;
+    }
+
+    writer.writeFixed(replay.finalHash, 8);
+}
+
+bool ReplayCodec::decode(const uint8_t* data, size_t size, ReplayData& replay) {
+    BinaryReader reader(data, size);
+
+    // ========== 头部 ==========
+    for (int i = 0; i < 4; ++i) {
+        if (reader.readU8() != kMagic[i]) return false;
+    }
+    if (reader.readU8() != FORMAT_VERSION) return false;
+
+    // 逐字段复位而不是整体赋值，保留 moves 的容量（校验服务对每局复用同一个 ReplayData）
+    replay.moves.clear();
+    replay.finalHash = 0;
+    replay.levelId = (uint32_t)reader.readVarint();
+    replay.seed = (uint32_t)reader.readVarint();
+    replay.ruleSet = (uint16_t)reader.readVarint();
+    replay.initialHash = reader.readFixed(8);
+
+    // ========== 操作序列 ==========
+    // 每步至少 7 字节，用剩余长度限制预分配，避免损坏的计数触发超大分配
+    uint64_t count = reader.readVarint();
+    if (!reader.ok() || count > reader.remaining() / 7) return false;
+    replay.moves.reserve((size_t)count);
+
+    uint32_t timeMs = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint8_t type = reader.readU8();
+        if (type > (uint8_t)InputCommandType::UNDO) return false;
+        int32_t cardId = reader.readSignedVarint();
+        timeMs += (uint32_t)reader.readVarint();
+        uint32_t hash = (uint32_t)reader.readFixed(4);
+        if (!reader.ok()) return false;
+        replay.moves.push_back(ReplayMove((InputCommandType)type, cardId, timeMs, hash));
+    }
+
+    replay.finalHash = reader.readFixed(8);
+    return reader.ok() && reader.atEnd();
+}
@@ -0,0 +1,36 @@
+#ifndef REPLAY_CODEC_H
+#define REPLAY_CODEC_H
+
+#include "models/ReplayModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 回放编解码服务
+ * 职责：ReplayData 与紧凑二进制格式之间的互相转换
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details 二进制格式（整数均为小端）：
+ * ```
+ * "CGRP"  版本(u8)  关卡ID(varint)  种子(varint)  规则版本(varint)  初始哈希(u64)
+ * 操作数(varint)
+ * 每步操作：类型(u8)  卡牌ID(zigzag varint)  与上一步的时间差毫秒(varint)  状态哈希(u32)
+ * 最终哈希(u64)
+ * ```
+ * 一步操作通常只占 7~9 字节，数百步的一局只有几 KB
+ */
+class ReplayCodec {
+public:
+    // 当前格式版本，修改格式时递增
+    static const uint8_t FORMAT_VERSION = 1;
+
+    // 编码，结果追加到 out 末尾
+    static void encode(const ReplayData& replay, std::vector<uint8_t>& out);
+
+    // 解码，数据损坏、截断或版本不支持时返回 false
+    // replay.moves 的已有容量会被复用，容量足够时不分配内存
+    static bool decode(const uint8_t* data, size_t size, ReplayData& replay);
+};
+
+#endif // REPLAY_CODEC_H
@@ -0,0 +1,132 @@
+#include "services/SnapshotCodec.h"
+#include "utils/BinaryIO.h"
+
+const uint8_t SnapshotCodec::FORMAT_VERSION;
+
+namespace {
+    const uint8_t kMagic[4] = { 'C', 'G', 'S', 'V' };
+
+    // 各段每个元素至少占用的字节数，用剩余长度限制预分配，避免损坏的计数触发超大分配
+    const size_t kMinCardBytes = 11;
+    const size_t kMinUndoBytes = 12;
+
+    void writePosition(BinaryWriter& writer, const Vector2& pos) {
+        writer.writeFloat(pos.x);
+        writer.writeFloat(pos.y);
+    }
+
+    Vector2 readPosition(BinaryReader& reader) {
+        float x = reader.readFloat();
+        float y = reader.readFloat();
+        return Vector2(x, y);
+    }
+
+    bool readState(BinaryReader& reader, CardState& state) {
+        uint8_t value = reader.readU8();
+        if (value > (uint8_t)CardState::REMOVED) return false;
+        state = (CardState)value;
+        return reader.ok();
+    }
+}
+
+void SnapshotCodec::encode(const GameSnapshot& snapshot, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + 64 + snapshot.cards.size() * 16 + snapshot.undoHistory.size() * 16 + snapshot.replay.size());
+
+    BinaryWriter writer(out);
+
+    // ========== 头部 ==========
+    writer.writeBytes(kMagic, 4);
+    writer.writeU8(FORMAT_VERSION);
+    writer.writeVarint(snapshot.levelId);
+    writer.writeVarint(snapshot.ruleSet);
+    writer.writeFloat(snapshot.layoutWidth);
+    writer.writeFloat(snapshot.layoutHeight);
+    writer.writeVarint(snapshot.sessionTimeMs);
+    writer.writeSignedVarint(snapshot.topCardId);
+
+    // ========== 卡牌 ==========
+    writer.writeVarint(snapshot.cards.size());
+    for (const auto& card : snapshot.cards) {
+        writer.writeSignedVarint(card.id);
+        writer.writeU8((uint8_t)card.state);
+        writer.writeSignedVarint(card.zIndex);
+        writePosition(writer, card.position);
+    }
+
+    // ========== 备用堆顺序 ==========
+    writer.writeVarint(snapshot.stockCardIds.size());
+    for (int32_t id : snapshot.stockCardIds) {
+        writer.writeSignedVarint(id);
+    }
+
+    // ========== 回退历史 ==========
+    writer.writeVarint(snapshot.undoHistory.size());
+    for (const auto& cmd : snapshot.undoHistory) {
+        writer.writeSignedVarint(cmd.cardId);
+        writePosition(writer, cmd.fromPos);
+        writer.writeSignedVarint(cmd.prevTopCardId);
+        writer.writeU8((uint8_t)cmd.prevState);
+        writer.writeSignedVarint(cmd.prevZIndex);
+    }
+
+    // ========== 录制中的回放 ==========
+    writer.writeVarint(snapshot.replay.size());
+    writer.writeBytes(snapshot.replay.data(), snapshot.replay.size());
+}
+
+bool SnapshotCodec::decode(const uint8_t* data, size_t size, GameSnapshot& snapshot) {
+    BinaryReader reader(data, size);
+
+    // ========== 头部 ==========
+    for (int i = 0; i < 4; ++i) {
+        if (reader.readU8() != kMagic[i]) return false;
+    }
+    if (reader.readU8() != FORMAT_VERSION) return false;
+
+    snapshot = GameSnapshot();
+    snapshot.levelId = (uint32_t)reader.readVarint();
+    snapshot.ruleSet = (uint16_t)reader.readVarint();
+    snapshot.layoutWidth = reader.readFloat();
+    snapshot.layoutHeight = reader.readFloat();
+    snapshot.sessionTimeMs = (uint32_t)reader.readVarint();
+    snapshot.topCardId = reader.readSignedVarint();
+
+    // ========== 卡牌 ==========
+    uint64_t cardCount = reader.readVarint();
+    if (!reader.ok() || cardCount > reader.remaining() / kMinCardBytes) return false;
+    snapshot.cards.resize((size_t)cardCount);
+    for (auto& card : snapshot.cards) {
+        card.id = reader.readSignedVarint();
+        if (!readState(reader, card.state)) return false;
+        card.zIndex = reader.readSignedVarint();
+        card.position = readPosition(reader);
+    }
+
+    // ========== 备用堆顺序 ==========
+    uint64_t stockCount = reader.readVarint();
+    if (!reader.ok() || stockCount > reader.remaining()) return false;
+    snapshot.stockCardIds.resize((size_t)stockCount);
+    for (auto& id : snapshot.stockCardIds) {
+        id = reader.readSignedVarint();
+    }
+
+    // ========== 回退历史 ==========
+    uint64_t undoCount = reader.readVarint();
+    if (!reader.ok() || undoCount > reader.remaining() / kMinUndoBytes) return false;
+    snapshot.undoHistory.resize((size_t)undoCount);
+    for (auto& cmd : snapshot.undoHistory) {
+        cmd.cardId = reader.readSignedVarint();
+        cmd.fromPos = readPosition(reader);
+        cmd.prevTopCardId = reader.readSignedVarint();
+        if (!readState(reader, cmd.prevState)) return false;
+        cmd.prevZIndex = reader.readSignedVarint();
+    }
+
+    // ========== 录制中的回放 ==========
+    uint64_t replaySize = reader.readVarint();
+    if (!reader.ok() || replaySize > reader.remaining()) return false;
+    const uint8_t* replay = reader.readBytes((size_t)replaySize);
+    snapshot.replay.assign(replay, replay + replaySize);
+
+    return reader.ok() && reader.atEnd();
+}
@@ -0,0 +1,37 @@
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include "models/GameSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 存档编解码服务
+ * 职责：GameSnapshot 与紧凑二进制格式之间的互相转换
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details 二进制格式（整数均为小端，坐标为 IEEE 754 单精度位模式）：
+ * ```
+ * "CGSV"  版本(u8)  关卡ID(varint)  规则版本(varint)  布局宽高(f32 x2)  已用时间毫秒(varint)
+ * 顶部卡牌ID(zigzag varint)
+ * 卡牌数(varint)，每张：ID(zigzag varint)  状态(u8)  层级(zigzag varint)  位置(f32 x2)
+ * 备用堆张数(varint)，每张：ID(zigzag varint)
+ * 回退步数(varint)，每步：卡牌ID  位置(f32 x2)  之前的顶部卡牌ID  之前的状态(u8)  之前的层级
+ * 回放长度(varint)  回放数据（ReplayCodec 格式）
+ * ```
+ * 一局 50 张牌、几十步回退的存档约 1~2 KB
+ */
+class SnapshotCodec {
+public:
+    // 当前格式版本，修改格式时递增
+    static const uint8_t FORMAT_VERSION = 1;
+
+    // 编码，结果追加到 out 末尾
+    static void encode(const GameSnapshot& snapshot, std::vector<uint8_t>& out);
+
+    // 解码，数据损坏、截断或版本不支持时返回 false
+    static bool decode(const uint8_t* data, size_t size, GameSnapshot& snapshot);
+};
+
+#endif // SNAPSHOT_CODEC_H
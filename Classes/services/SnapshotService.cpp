@@ -0,0 +1,44 @@
+#include "services/SnapshotService.h"
+#include "services/GameLogicService.h"
+
+void SnapshotService::capture(const GameModel& model, const UndoManager& undoManager, GameSnapshot& snapshot) {
+    snapshot.topCardId = model.topCardId;
+    snapshot.stockCardIds.assign(model.stockCardIds.begin(), model.stockCardIds.end());
+    snapshot.undoHistory = undoManager.getHistory();
+
+    snapshot.cards.resize(model.allCards.size());
+    for (size_t i = 0; i < model.allCards.size(); ++i) {
+        const CardModel& card = *model.allCards[i];
+        CardSnapshot& out = snapshot.cards[i];
+        out.id = card.getId();
+        out.state = card.getState();
+        out.zIndex = card.getZIndex();
+        out.position = card.getPosition();
+    }
+}
+
+bool SnapshotService::restore(const GameSnapshot& snapshot, GameModel& model, UndoManager& undoManager) {
+    // ========== 校验：先检查全部引用，再写入，失败时模型保持原样 ==========
+    if (snapshot.cards.size() != model.allCards.size()) return false;
+    for (const auto& card : snapshot.cards) {
+        if (!model.getCardById(card.id)) return false;
+    }
+    for (int32_t id : snapshot.stockCardIds) {
+        if (!model.getCardById(id)) return false;
+    }
+    for (const auto& cmd : snapshot.undoHistory) {
+        if (!model.getCardById(cmd.cardId)) return false;
+    }
+    if (snapshot.topCardId >= 0 && !model.getCardById(snapshot.topCardId)) return false;
+
+    // ========== 写入 ==========
+    for (const auto& card : snapshot.cards) {
+        CardModel* target = model.getCardById(card.id).get();
+        GameLogicService::applyMove(target, card.position, card.zIndex);
+        GameLogicService::applyStateChange(target, card.state);
+    }
+    model.topCardId = snapshot.topCardId;
+    model.stockCardIds.assign(snapshot.stockCardIds.begin(), snapshot.stockCardIds.end());
+    undoManager.setHistory(snapshot.undoHistory);
+    return true;
+}
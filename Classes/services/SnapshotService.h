@@ -0,0 +1,29 @@
+#ifndef SNAPSHOT_SERVICE_H
+#define SNAPSHOT_SERVICE_H
+
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/GameSnapshot.h"
+
+/**
+ * @brief 存档服务
+ * 职责：在 GameModel + UndoManager 与 GameSnapshot 之间采集 / 写回一局游戏的可变状态
+ * 特性：无状态服务 (Stateless Service)，只依赖核心库
+ *
+ * @details
+ * - capture：只采集卡牌状态、层级、位置、底牌堆顶部、备用堆顺序和回退历史；
+ *   关卡ID、布局尺寸、时间、回放等会话信息由调用方填写
+ * - restore：直接把存档写进由同一关卡重新生成的模型，不重放任何操作，
+ *   耗时只与卡牌数和回退步数成正比
+ */
+class SnapshotService {
+public:
+    // [只读逻辑] 采集模型和回退历史到 snapshot（覆盖对应字段）
+    static void capture(const GameModel& model, const UndoManager& undoManager, GameSnapshot& snapshot);
+
+    // [写逻辑] 把存档写回模型和回退管理器
+    // @return 存档与模型不对应（卡牌数不同、ID 不存在）时返回 false，此时模型不被修改
+    static bool restore(const GameSnapshot& snapshot, GameModel& model, UndoManager& undoManager);
+};
+
+#endif // SNAPSHOT_SERVICE_H
@@ -0,0 +1,152 @@
+#include "services/TelemetryAggregator.h"
+#include "services/TelemetryCodec.h"
+#include <cstdio>
+
+const size_t TelemetryLevelSummary::DROPOFF_BUCKETS;
+
+namespace {
+    bool isKnownType(TelemetryEventType type) {
+        return type == TelemetryEventType::LEVEL_START || type == TelemetryEventType::MOVE
+            || type == TelemetryEventType::UNDO || type == TelemetryEventType::LEVEL_END;
+    }
+
+    // 累加到已经找到的关卡汇总（类型已检查）
+    void addEvent(const TelemetryEvent& event, TelemetryLevelSummary& level) {
+        switch (event.type) {
+        case TelemetryEventType::LEVEL_START:
+            if (event.detail) level.resumes++;
+            else level.starts++;
+            break;
+        case TelemetryEventType::MOVE:
+            level.moves++;
+            level.thinkMsTotal += event.elapsedMs;
+            break;
+        case TelemetryEventType::UNDO:
+            level.undos++;
+            level.thinkMsTotal += event.elapsedMs;
+            break;
+        case TelemetryEventType::LEVEL_END: {
+            size_t bucket = event.moveCount < TelemetryLevelSummary::DROPOFF_BUCKETS
+                ? event.moveCount : TelemetryLevelSummary::DROPOFF_BUCKETS - 1;
+            level.ends++;
+            level.durationMsTotal += event.elapsedMs;
+            level.endMovesTotal += event.moveCount;
+            level.endUndosTotal += event.undoCount;
+            if (event.detail == (uint8_t)LevelOutcome::CLEARED) {
+                level.cleared++;
+                level.clearedAtMoves[bucket]++;
+            }
+            else {
+                level.abandoned++;
+                level.abandonedAtMoves[bucket]++;
+                if (event.value > 0) level.cardsLeftTotal += (uint64_t)event.value;
+            }
+            break;
+        }
+        }
+    }
+
+    double ratio(uint64_t numerator, uint64_t denominator) {
+        return denominator ? (double)numerator / (double)denominator : 0.0;
+    }
+}
+
+void TelemetryAggregator::accumulate(const TelemetryEvent& event, TelemetrySummary& summary) {
+    summary.events++;
+    if (!isKnownType(event.type)) {
+        summary.unknownEvents++;
+        return;
+    }
+    addEvent(event, summary.levels[event.levelId]);
+}
+
+void TelemetryAggregator::accumulateEvents(const uint8_t* data, size_t count, TelemetrySummary& summary) {
+    // 同一局的事件连续出现，缓存上一条事件的关卡，省去大部分 map 查找（map 节点地址不会变化）
+    TelemetryLevelSummary* cachedLevel = nullptr;
+    uint16_t cachedLevelId = 0;
+
+    TelemetryEvent event;
+    for (size_t i = 0; i < count; ++i, data += TelemetryCodec::EVENT_SIZE) {
+        TelemetryCodec::decodeEvent(data, event);
+        summary.events++;
+        if (!isKnownType(event.type)) {
+            summary.unknownEvents++;
+            continue;
+        }
+        if (!cachedLevel || cachedLevelId != event.levelId) {
+            cachedLevel = &summary.levels[event.levelId];
+            cachedLevelId = event.levelId;
+        }
+        addEvent(event, *cachedLevel);
+    }
+}
+
+void TelemetryAggregator::merge(const TelemetrySummary& from, TelemetrySummary& into) {
+    into.events += from.events;
+    into.unknownEvents += from.unknownEvents;
+    for (const auto& entry : from.levels) {
+        const TelemetryLevelSummary& src = entry.second;
+        TelemetryLevelSummary& dst = into.levels[entry.first];
+        dst.starts += src.starts;
+        dst.resumes += src.resumes;
+        dst.ends += src.ends;
+        dst.cleared += src.cleared;
+        dst.abandoned += src.abandoned;
+        dst.moves += src.moves;
+        dst.undos += src.undos;
+        dst.thinkMsTotal += src.thinkMsTotal;
+        dst.durationMsTotal += src.durationMsTotal;
+        dst.endMovesTotal += src.endMovesTotal;
+        dst.endUndosTotal += src.endUndosTotal;
+        dst.cardsLeftTotal += src.cardsLeftTotal;
+        for (size_t i = 0; i < TelemetryLevelSummary::DROPOFF_BUCKETS; ++i) {
+            dst.abandonedAtMoves[i] += src.abandonedAtMoves[i];
+            dst.clearedAtMoves[i] += src.clearedAtMoves[i];
+        }
+    }
+}
+
+std::string TelemetryAggregator::levelsCsv(const TelemetrySummary& summary) {
+    std::string csv = "level,starts,resumes,ends,cleared,abandoned,unfinished,clear_rate,moves,undos,undo_rate,"
+        "avg_think_ms,avg_duration_ms,avg_moves_per_play,avg_undos_per_play,avg_cards_left_abandoned\n";
+    char line[384];
+    for (const auto& entry : summary.levels) {
+        const TelemetryLevelSummary& level = entry.second;
+        uint64_t opened = level.starts + level.resumes;
+        uint64_t unfinished = opened > level.ends ? opened - level.ends : 0;
+        snprintf(line, sizeof(line), "%u,%llu,%llu,%llu,%llu,%llu,%llu,%.4f,%llu,%llu,%.4f,%.1f,%.1f,%.2f,%.2f,%.2f\n",
+            (unsigned)entry.first,
+            (unsigned long long)level.starts, (unsigned long long)level.resumes, (unsigned long long)level.ends,
+            (unsigned long long)level.cleared, (unsigned long long)level.abandoned, (unsigned long long)unfinished,
+            ratio(level.cleared, level.ends),
+            (unsigned long long)level.moves, (unsigned long long)level.undos,
+            ratio(level.undos, level.moves + level.undos),
+            ratio(level.thinkMsTotal, level.moves + level.undos),
+            ratio(level.durationMsTotal, level.ends),
+            ratio(level.endMovesTotal, level.ends),
+            ratio(level.endUndosTotal, level.ends),
+            ratio(level.cardsLeftTotal, level.abandoned));
+        csv += line;
+    }
+    return csv;
+}
+
+std::string TelemetryAggregator::dropoffCsv(const TelemetrySummary& summary) {
+    std::string csv = "level,moves,abandoned,cleared,reached\n";
+    char line[128];
+    for (const auto& entry : summary.levels) {
+        const TelemetryLevelSummary& level = entry.second;
+        uint64_t reached = level.ends;
+        for (size_t i = 0; i < TelemetryLevelSummary::DROPOFF_BUCKETS; ++i) {
+            uint64_t endedHere = level.abandonedAtMoves[i] + level.clearedAtMoves[i];
+            if (endedHere) {
+                snprintf(line, sizeof(line), "%u,%u,%llu,%llu,%llu\n", (unsigned)entry.first, (unsigned)i,
+                    (unsigned long long)level.abandonedAtMoves[i], (unsigned long long)level.clearedAtMoves[i],
+                    (unsigned long long)reached);
+                csv += line;
+            }
+            reached -= endedHere;
+        }
+    }
+    return csv;
+}
@@ -0,0 +1,50 @@
+#ifndef TELEMETRY_AGGREGATOR_H
+#define TELEMETRY_AGGREGATOR_H
+
+#include "models/TelemetryEvent.h"
+#include "models/TelemetrySummary.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 遥测离线汇总服务
+ * 职责：把遥测事件累加到 TelemetrySummary（map），合并多份汇总（reduce），输出 CSV 汇总表
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details
+ * - 每条事件单独累加，不需要按局关联：LEVEL_END 自带本局的操作数、撤销数、时长和结果
+ * - 因此事件可以按任意方式分块，各线程累加到自己的汇总，最后合并，结果与顺序处理相同
+ */
+class TelemetryAggregator {
+public:
+    // 累加一条事件
+    static void accumulate(const TelemetryEvent& event, TelemetrySummary& summary);
+
+    /**
+     * @brief 累加一段连续的编码事件（批次头之后的部分）
+     * @param data 第一条事件的起始位置
+     * @param count 事件数（data 至少有 count * TelemetryCodec::EVENT_SIZE 字节）
+     */
+    static void accumulateEvents(const uint8_t* data, size_t count, TelemetrySummary& summary);
+
+    // 把 from 合并到 into
+    static void merge(const TelemetrySummary& from, TelemetrySummary& into);
+
+    /**
+     * @brief 每个关卡一行的汇总表
+     * @details 列：level, starts, resumes, ends, cleared, abandoned, unfinished（开局但没有结束事件）,
+     *          clear_rate, moves, undos, undo_rate（撤销占全部操作的比例）, avg_think_ms,
+     *          avg_duration_ms, avg_moves_per_play, avg_undos_per_play, avg_cards_left_abandoned
+     */
+    static std::string levelsCsv(const TelemetrySummary& summary);
+
+    /**
+     * @brief 流失点表：每个关卡按结束时的操作数一行（只输出有局结束的行）
+     * @details 列：level, moves, abandoned, cleared, reached（结束时操作数不少于 moves 的局数，即漏斗的这一级）；
+     *          最后一个桶的 moves 表示“不少于”
+     */
+    static std::string dropoffCsv(const TelemetrySummary& summary);
+};
+
+#endif // TELEMETRY_AGGREGATOR_H
@@ -0,0 +1,77 @@
+#include "services/TelemetryCodec.h"
+#include "utils/BinaryIO.h"
+
+const uint16_t TelemetryCodec::FORMAT_VERSION;
+const size_t TelemetryCodec::HEADER_SIZE;
+const size_t TelemetryCodec::EVENT_SIZE;
+
+namespace {
+    const uint8_t kMagic[4] = { 'C', 'G', 'T', 'B' };
+}
+
+void TelemetryCodec::encodeBatch(const TelemetryEvent* events, size_t count, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + HEADER_SIZE + count * EVENT_SIZE);
+    BinaryWriter writer(out);
+
+    // ========== 批次头 ==========
+    writer.writeBytes(kMagic, 4);
+    writer.writeFixed(FORMAT_VERSION, 2);
+    writer.writeFixed(EVENT_SIZE, 2);
+    writer.writeFixed(count, 4);
+
+    // ========== 定长事件 ==========
+    for (size_t i = 0; i < count; ++i) {
+        const TelemetryEvent& event = events[i];
+        writer.writeFixed(event.timestampMs, 8);
+        writer.writeFixed(event.playId, 4);
+        writer.writeFixed(event.levelId, 2);
+        writer.writeU8((uint8_t)event.type);
+        writer.writeU8(event.detail);
+        writer.writeFixed(event.elapsedMs, 4);
+        writer.writeFixed((uint32_t)event.value, 4);
+        writer.writeFixed(event.moveCount, 2);
+        writer.writeFixed(event.undoCount, 2);
+        writer.writeFixed(event.reserved, 4);
+    }
+}
+
+bool TelemetryCodec::readBatchHeader(const uint8_t* data, size_t size, uint32_t& count) {
+    BinaryReader reader(data, size);
+    const uint8_t* magic = reader.readBytes(4);
+    if (!magic || memcmp(magic, kMagic, 4) != 0) return false;
+    uint16_t version = (uint16_t)reader.readFixed(2);
+    uint16_t eventSize = (uint16_t)reader.readFixed(2);
+    count = (uint32_t)reader.readFixed(4);
+    if (!reader.ok() || version != FORMAT_VERSION || eventSize != EVENT_SIZE) return false;
+    // 批次不完整（写入中途退出）
+    return reader.remaining() / EVENT_SIZE >= count;
+}
+
+void TelemetryCodec::decodeEvent(const uint8_t* data, TelemetryEvent& event) {
+    BinaryReader reader(data, EVENT_SIZE);
+    event.timestampMs = reader.readFixed(8);
+    event.playId = (uint32_t)reader.readFixed(4);
+    event.levelId = (uint16_t)reader.readFixed(2);
+    event.type = (TelemetryEventType)reader.readU8();
+    event.detail = reader.readU8();
+    event.elapsedMs = (uint32_t)reader.readFixed(4);
+    event.value = (int32_t)(uint32_t)reader.readFixed(4);
+    event.moveCount = (uint16_t)reader.readFixed(2);
+    event.undoCount = (uint16_t)reader.readFixed(2);
+    event.reserved = (uint32_t)reader.readFixed(4);
+}
+
+size_t TelemetryCodec::decodeAll(const uint8_t* data, size_t size, std::vector<TelemetryEvent>& events) {
+    size_t offset = 0;
+    uint32_t count = 0;
+    while (readBatchHeader(data + offset, size - offset, count)) {
+        const uint8_t* p = data + offset + HEADER_SIZE;
+        for (uint32_t i = 0; i < count; ++i, p += EVENT_SIZE) {
+            TelemetryEvent event;
+            decodeEvent(p, event);
+            events.push_back(event);
+        }
+        offset += HEADER_SIZE + (size_t)count * EVENT_SIZE;
+    }
+    return offset;
+}
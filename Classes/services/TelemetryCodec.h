@@ -0,0 +1,55 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include "models/TelemetryEvent.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 遥测文件编解码服务
+ * 职责：TelemetryEvent 批次与二进制格式之间的互相转换
+ * 特性：无状态服务 (Stateless Service)
+ *
+ * @details 文件由若干批次首尾相接组成，每批（整数均为小端）：
+ * ```
+ * "CGTB"  版本(u16)  事件大小(u16)  事件数(u32)
+ * 事件 x 事件数，每条定长 32 字节：
+ *   时间戳(u64)  playId(u32)  关卡ID(u16)  类型(u8)  detail(u8)
+ *   elapsedMs(u32)  value(i32)  操作数(u16)  撤销数(u16)  保留(u32)
+ * ```
+ * - 事件定长，读取方可以直接按偏移访问（例如 mmap 后并行处理）
+ * - 进程在写入中途退出时，文件末尾可能留下不完整的批次，读取时忽略
+ */
+class TelemetryCodec {
+public:
+    // 当前格式版本，修改格式时递增
+    static const uint16_t FORMAT_VERSION = 1;
+
+    // 批次头与单条事件的字节数
+    static const size_t HEADER_SIZE = 12;
+    static const size_t EVENT_SIZE = 32;
+
+    // 编码一批事件，结果追加到 out 末尾
+    static void encodeBatch(const TelemetryEvent* events, size_t count, std::vector<uint8_t>& out);
+
+    /**
+     * @brief 读取批次头
+     * @param data 批次起始位置
+     * @param size 从 data 起的剩余字节数
+     * @param count 输出事件数
+     * @return 头部损坏、版本不支持或批次不完整时返回 false
+     */
+    static bool readBatchHeader(const uint8_t* data, size_t size, uint32_t& count);
+
+    // 解码一条事件（data 至少有 EVENT_SIZE 字节）
+    static void decodeEvent(const uint8_t* data, TelemetryEvent& event);
+
+    /**
+     * @brief 解码整段数据中的所有完整批次
+     * @return 读取到的字节数（之后的数据损坏或不完整）
+     */
+    static size_t decodeAll(const uint8_t* data, size_t size, std::vector<TelemetryEvent>& events);
+};
+
+#endif // TELEMETRY_CODEC_H
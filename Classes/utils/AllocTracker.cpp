@@ -0,0 +1,182 @@
+#include "utils/AllocTracker.h"
+#include "utils/CoreLog.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    const size_t kTagCount = (size_t)AllocTag::TAG_COUNT;
+
+    // 全局计数；operator new 中不能分配内存，只做原子加法
+    std::atomic<uint64_t> s_counts[kTagCount];
+    std::atomic<uint64_t> s_bytes[kTagCount];
+
+    thread_local AllocTag t_tag = AllocTag::UNTAGGED;
+
+    const char* const kTagNames[kTagCount] = { "untagged", "loader", "model_gen", "views", "tap" };
+}
+
+AllocCounters::AllocCounters() {
+    for (size_t i = 0; i < kTagCount; ++i) {
+        counts[i] = 0;
+        bytes[i] = 0;
+    }
+}
+
+uint64_t AllocCounters::totalCount() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kTagCount; ++i) total += counts[i];
+    return total;
+}
+
+uint64_t AllocCounters::totalBytes() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kTagCount; ++i) total += bytes[i];
+    return total;
+}
+
+AllocCounters AllocCounters::operator-(const AllocCounters& other) const {
+    AllocCounters result;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        result.counts[i] = counts[i] - other.counts[i];
+        result.bytes[i] = bytes[i] - other.bytes[i];
+    }
+    return result;
+}
+
+bool AllocTracker::isEnabled() {
+#if CARDGAME_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocCounters AllocTracker::snapshot() {
+    AllocCounters counters;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        counters.counts[i] = s_counts[i].load(std::memory_order_relaxed);
+        counters.bytes[i] = s_bytes[i].load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+AllocTag AllocTracker::setThreadTag(AllocTag tag) {
+    AllocTag previous = t_tag;
+    t_tag = tag;
+    return previous;
+}
+
+void AllocTracker::recordAllocation(size_t size) {
+    size_t tag = (size_t)t_tag;
+    s_counts[tag].fetch_add(1, std::memory_order_relaxed);
+    s_bytes[tag].fetch_add(size, std::memory_order_relaxed);
+}
+
+const char* AllocTracker::tagName(AllocTag tag) {
+    size_t index = (size_t)tag;
+    return index < kTagCount ? kTagNames[index] : "unknown";
+}
+
+std::string AllocTracker::format(const AllocCounters& counters) {
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), "%llu allocs, %llu bytes",
+        (unsigned long long)counters.totalCount(), (unsigned long long)counters.totalBytes());
+    std::string text = buffer;
+
+    bool first = true;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        if (counters.counts[i] == 0) continue;
+        snprintf(buffer, sizeof(buffer), "%s%s %llu/%llu", first ? " (" : ", ", kTagNames[i],
+            (unsigned long long)counters.counts[i], (unsigned long long)counters.bytes[i]);
+        text += buffer;
+        first = false;
+    }
+    if (!first) text += ")";
+    return text;
+}
+
+std::string AllocTracker::toJson(const AllocCounters& counters) {
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), "{\"allocs\":%llu,\"bytes\":%llu,\"tags\":{",
+        (unsigned long long)counters.totalCount(), (unsigned long long)counters.totalBytes());
+    std::string json = buffer;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        snprintf(buffer, sizeof(buffer), "%s\"%s\":{\"allocs\":%llu,\"bytes\":%llu}", i ? "," : "", kTagNames[i],
+            (unsigned long long)counters.counts[i], (unsigned long long)counters.bytes[i]);
+        json += buffer;
+    }
+    json += "}}";
+    return json;
+}
+
+bool AllocTracker::withinBudget(const AllocCounters& counters, const AllocBudget& budget, uint64_t divisor) {
+    if (divisor == 0) divisor = 1;
+    if (budget.maxCount > 0 && counters.totalCount() > budget.maxCount * divisor) return false;
+    if (budget.maxBytes > 0 && counters.totalBytes() > budget.maxBytes * divisor) return false;
+    return true;
+}
+
+AllocReport::AllocReport(const char* label)
+    : _label(label)
+    , _start(AllocTracker::snapshot())
+{
+}
+
+AllocReport::~AllocReport() {
+    AllocCounters delta = AllocTracker::snapshot() - _start;
+    CORE_LOG("AllocTracker: %s: %s", _label, AllocTracker::format(delta).c_str());
+}
+
+#if CARDGAME_ALLOC_TRACKING
+// ========== 替换全局 operator new / delete ==========
+// 与 AllocTracker 的其它函数放在同一个目标文件中：只要程序用到 AllocTracker，静态库中的这个文件就会被链接，替换随之生效
+
+void* operator new(size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    AllocTracker::recordAllocation(size);
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* p = std::malloc(size ? size : 1);
+    if (p) AllocTracker::recordAllocation(size);
+    return p;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+#endif
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file AllocTracker.h
+ * @brief 内存分配统计 - 按子系统统计 operator new 的次数和字节数
+ *
+ * @details
+ * - 定义 CARDGAME_ALLOC_TRACKING 时，AllocTracker.cpp 替换全局 operator new / delete，
+ *   每次分配按当前线程的标签计入对应的计数（次数、字节数）；不记录释放
+ * - ALLOC_SCOPE(tag) 在作用域内把当前线程的标签设为 tag，离开时恢复；嵌套时内层优先
+ * - ALLOC_REPORT(label) 在作用域结束时输出这段时间内各标签的分配次数（日志）
+ * - snapshot 取当前计数，两次快照相减得到一段时间内的分配，可与 AllocBudget 比较
+ * - 未定义 CARDGAME_ALLOC_TRACKING 时宏展开为空，snapshot 返回全 0，不替换 operator new
+ *
+ * @note 计数是全局的（所有线程合计），标签是每个线程各自的；其它线程在无标签作用域中的分配计入 UNTAGGED
+ * @note 替换 operator new 对整个进程生效（包括引擎），只用于诊断构建
+ *
+ * @example
+ * ```cpp
+ * AllocCounters before = AllocTracker::snapshot();
+ * {
+ *     ALLOC_SCOPE(AllocTag::LOADER);
+ *     config = LevelConfigLoader::loadLevelConfig(path);
+ * }
+ * AllocCounters delta = AllocTracker::snapshot() - before;
+ * CORE_LOG("%s", AllocTracker::format(delta).c_str());
+ * ```
+ */
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 分配归属的子系统
+ */
+enum class AllocTag : uint8_t {
+    UNTAGGED,       // 不在任何标签作用域内（引擎每帧的分配、其它线程等）
+    LOADER,         // 关卡配置加载与解析
+    MODEL_GEN,      // 配置生成运行时模型
+    VIEWS,          // 视图与动画的创建
+    TAP,            // 点击处理（不含其中视图部分）
+    TAG_COUNT
+};
+
+/**
+ * @brief 各标签的分配计数
+ */
+struct AllocCounters {
+    uint64_t counts[(size_t)AllocTag::TAG_COUNT];
+    uint64_t bytes[(size_t)AllocTag::TAG_COUNT];
+
+    AllocCounters();
+
+    uint64_t totalCount() const;
+    uint64_t totalBytes() const;
+
+    AllocCounters operator-(const AllocCounters& other) const;
+};
+
+/**
+ * @brief 分配预算（0 表示不限制）
+ */
+struct AllocBudget {
+    uint64_t maxCount = 0;
+    uint64_t maxBytes = 0;
+};
+
+class AllocTracker {
+public:
+    // 是否以 CARDGAME_ALLOC_TRACKING 编译
+    static bool isEnabled();
+
+    // 当前的累计计数
+    static AllocCounters snapshot();
+
+    // 设置当前线程的标签，返回原来的标签
+    static AllocTag setThreadTag(AllocTag tag);
+
+    // 记录一次分配（由替换的 operator new 调用）
+    static void recordAllocation(size_t size);
+
+    static const char* tagName(AllocTag tag);
+
+    // 单行文本："N allocs, B bytes (loader n/b, ...)"，只列出非 0 的标签
+    static std::string format(const AllocCounters& counters);
+
+    // JSON 对象：{"allocs":N,"bytes":B,"tags":{"loader":{"allocs":n,"bytes":b},...}}
+    static std::string toJson(const AllocCounters& counters);
+
+    /**
+     * @brief 检查分配是否在预算内
+     * @param counters 一段时间内的分配（两次快照之差）
+     * @param divisor 把总数平摊到 divisor 次操作后再比较（例如每次点击），0 按 1 处理
+     */
+    static bool withinBudget(const AllocCounters& counters, const AllocBudget& budget, uint64_t divisor = 1);
+};
+
+/**
+ * @brief 作用域标签：构造时设置当前线程的标签，析构时恢复
+ */
+class AllocTagScope {
+public:
+    explicit AllocTagScope(AllocTag tag)
+        : _previous(AllocTracker::setThreadTag(tag))
+    {
+    }
+
+    ~AllocTagScope() {
+        AllocTracker::setThreadTag(_previous);
+    }
+
+private:
+    AllocTagScope(const AllocTagScope&) = delete;
+    AllocTagScope& operator=(const AllocTagScope&) = delete;
+
+    AllocTag _previous;
+};
+
+/**
+ * @brief 作用域报告：析构时输出构造以来的分配
+ */
+class AllocReport {
+public:
+    explicit AllocReport(const char* label);
+    ~AllocReport();
+
+private:
+    AllocReport(const AllocReport&) = delete;
+    AllocReport& operator=(const AllocReport&) = delete;
+
+    const char* _label;
+    AllocCounters _start;
+};
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+
+#if CARDGAME_ALLOC_TRACKING
+#define ALLOC_SCOPE(tag) AllocTagScope ALLOC_CONCAT(_allocScope, __LINE__)(tag)
+#define ALLOC_REPORT(label) AllocReport ALLOC_CONCAT(_allocReport, __LINE__)(label)
+#else
+#define ALLOC_SCOPE(tag) ((void)0)
+#define ALLOC_REPORT(label) ((void)0)
+#endif
+
+#endif // ALLOC_TRACKER_H
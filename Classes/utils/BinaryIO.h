@@ -0,0 +1,125 @@
+/**
+ * @file BinaryIO.h
+ * @brief 紧凑二进制编码工具 - 回放、存档等二进制格式共用的读写器
+ *
+ * @details
+ * - 整数统一为小端字节序，与平台无关
+ * - varint：每字节 7 位有效数据，最高位表示后面还有字节；有符号数先做 zigzag 映射
+ * - float 按 IEEE 754 位模式原样存储，读回后逐位相同
+ */
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief 顺序写入器，数据追加到外部提供的 vector 末尾
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    void writeU8(uint8_t value) { _out.push_back(value); }
+
+    void writeBytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        _out.insert(_out.end(), bytes, bytes + size);
+    }
+
+    void writeFixed(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            _out.push_back((uint8_t)(value >> (i * 8)));
+        }
+    }
+
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            _out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        _out.push_back((uint8_t)value);
+    }
+
+    void writeSignedVarint(int32_t value) {
+        writeVarint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+    }
+
+    void writeFloat(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        writeFixed(bits, 4);
+    }
+
+private:
+    std::vector<uint8_t>& _out;
+};
+
+/**
+ * @brief 顺序读取器
+ * @details 任何越界或格式错误都会使 ok() 变为 false，之后的读取全部返回 0；
+ *          调用方在读完一段后检查一次 ok() 即可，不必每次读取都判断
+ */
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size)
+        : _data(data), _size(data ? size : 0), _pos(0), _ok(data != nullptr) {}
+
+    bool ok() const { return _ok; }
+    size_t position() const { return _pos; }
+    size_t remaining() const { return _size - _pos; }
+    bool atEnd() const { return _pos == _size; }
+
+    uint8_t readU8() { return (uint8_t)readFixed(1); }
+
+    // 返回指向内部数据的指针（不拷贝），长度不足时返回 nullptr
+    const uint8_t* readBytes(size_t size) {
+        if (!_ok || remaining() < size) { _ok = false; return nullptr; }
+        const uint8_t* bytes = _data + _pos;
+        _pos += size;
+        return bytes;
+    }
+
+    uint64_t readFixed(int bytes) {
+        if (!_ok || remaining() < (size_t)bytes) { _ok = false; return 0; }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= (uint64_t)_data[_pos++] << (i * 8);
+        }
+        return value;
+    }
+
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (!_ok || _pos >= _size) { _ok = false; return 0; }
+            uint8_t byte = _data[_pos++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        _ok = false;
+        return 0;
+    }
+
+    int32_t readSignedVarint() {
+        uint32_t value = (uint32_t)readVarint();
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+
+    float readFloat() {
+        uint32_t bits = (uint32_t)readFixed(4);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos;
+    bool _ok;
+};
+
+#endif // BINARY_IO_H
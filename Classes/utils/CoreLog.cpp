@@ -0,0 +1,32 @@
+#include "utils/CoreLog.h"
+#include <cstdarg>
+#include <cstdio>
+
+// 单行日志的最大长度，超出部分被截断
+static const int kMaxLogLength = 1024;
+
+static CoreLog::Hook& logHook() {
+    static CoreLog::Hook s_hook;
+    return s_hook;
+}
+
+void CoreLog::setHook(const Hook& hook) {
+    logHook() = hook;
+}
+
+void CoreLog::log(const char* format, ...) {
+    char buffer[kMaxLogLength];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    const Hook& hook = logHook();
+    if (hook) {
+        hook(buffer);
+    }
+    else {
+        fprintf(stderr, "%s\n", buffer);
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file CoreLog.h
+ * @brief 核心库日志钩子 - 核心代码通过 CORE_LOG 输出日志，不直接依赖 CCLOG
+ *
+ * @details 
+ * - 默认输出到 stderr，适用于命令行工具、基准测试和服务端
+ * - 客户端在启动时通过 CoreLog::setHook 转发到 cocos2d::log
+ *
+ * @example
+ * ```cpp
+ * CoreLog::setHook([](const char* message) { cocos2d::log("%s", message); });
+ * CORE_LOG("UndoManager: history size %d", (int)size);
+ * ```
+ */
+#ifndef CORE_LOG_H
+#define CORE_LOG_H
+
+#include <functional>
+
+class CoreLog {
+public:
+    // 日志输出函数，参数为已格式化好的一行文本（不含换行）
+    typedef std::function<void(const char*)> Hook;
+
+    // 设置输出钩子，传入空函数恢复默认的 stderr 输出
+    static void setHook(const Hook& hook);
+
+    // printf 风格格式化后交给钩子输出
+    static void log(const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 1, 2)))
+#endif
+        ;
+};
+
+#define CORE_LOG(format, ...) CoreLog::log(format, ##__VA_ARGS__)
+
+#endif // CORE_LOG_H
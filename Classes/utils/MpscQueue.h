@@ -0,0 +1,121 @@
+/**
+ * @file MpscQueue.h
+ * @brief 有界无锁多生产者单消费者队列 - 多个工作线程把结果记录交给主线程
+ *
+ * @details
+ * - 环形数组，每个槽位带一个序号：序号等于入队位置表示空闲，等于位置 + 1 表示已写入、可以出队
+ * - 生产者用一次 CAS 领取入队位置，再写入元素并发布序号；不同生产者写不同槽位，互不等待
+ * - 消费者只有一个，出队位置不需要原子操作；取走元素后把序号推进一圈，槽位归还给生产者
+ * - 容量在构造时固定（向上取整到 2 的幂），入队、出队都不分配内存、不加锁
+ * - 入队位置与出队位置之间用一条缓存行的填充隔开（与 SpscQueue 相同，不用 alignas，队列可以在堆上分配）
+ *
+ * @note 某个生产者领取位置后被挂起时，消费者会停在这个槽位，直到它写完（其它生产者不受影响）
+ */
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity)
+        : _enqueuePos(0)
+        , _dequeuePos(0)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        _cells.reset(new Cell[size]);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 入队（任意线程）
+     * @return 队列已满时返回 false，不阻塞
+     */
+    bool tryPush(const T& value) {
+        Cell* cell;
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                // 槽位空闲：领取这个位置（失败说明被其它生产者抢先，pos 已更新为最新值）
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                // 槽位还没被消费者取走：队列已满
+                return false;
+            }
+            else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队（消费者）
+     * @return 队列为空（或队首的生产者尚未写完）时返回 false
+     */
+    bool tryPop(T& out) {
+        Cell* cell = &_cells[_dequeuePos & _mask];
+        if (cell->sequence.load(std::memory_order_acquire) != _dequeuePos + 1) return false;
+        out = cell->value;
+        cell->sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+        _dequeuePos++;
+        return true;
+    }
+
+    /**
+     * @brief 依次取出并处理元素（消费者）
+     * @param handler 以 const T& 调用
+     * @param maxCount 最多处理的个数
+     * @return 处理的个数
+     */
+    template <typename Handler>
+    size_t drain(Handler&& handler, size_t maxCount = std::numeric_limits<size_t>::max()) {
+        size_t count = 0;
+        T value;
+        while (count < maxCount && tryPop(value)) {
+            handler(value);
+            ++count;
+        }
+        return count;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+
+    // 生产者共享
+    char _padding0[64];
+    std::atomic<size_t> _enqueuePos;
+
+    // 只由消费者访问
+    char _padding1[64];
+    size_t _dequeuePos;
+    char _padding2[64];
+};
+
+#endif // MPSC_QUEUE_H
@@ -0,0 +1,197 @@
+#include "utils/Profiler.h"
+#include "utils/CoreLog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const size_t Profiler::ZONES_PER_THREAD;
+
+namespace {
+    const size_t kZoneMask = Profiler::ZONES_PER_THREAD - 1;
+    static_assert((Profiler::ZONES_PER_THREAD & kZoneMask) == 0, "ZONES_PER_THREAD must be a power of two");
+
+    // 导出时写入 trace 的进程 ID（只有一个进程，固定值即可）
+    const int kTracePid = 1;
+
+    // 缓冲中的一条记录；导出线程可能与写入线程同时访问，字段都是原子变量（relaxed 读写与普通读写开销相同）
+    struct Zone {
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> startNs;
+        std::atomic<uint64_t> endNs;
+    };
+
+    /**
+     * @brief 一个线程的环形缓冲
+     * @details 写入方先推进 begin 再写记录，写完推进 end；导出方读取 [end - 容量, end) 之后再读 begin，
+     *          下标小于 begin - 容量 的记录在读取期间可能已被覆盖，丢弃
+     */
+    struct ThreadBuffer {
+        uint32_t threadId = 0;
+        std::string name;                   // 由注册表的锁保护
+        std::atomic<uint64_t> begin;        // 已开始写入的记录数
+        std::atomic<uint64_t> end;          // 已写完的记录数
+        Zone zones[Profiler::ZONES_PER_THREAD];
+
+        ThreadBuffer() : begin(0), end(0) {}
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    };
+
+    // 线程退出后缓冲仍然保留（记录还要导出）；注册表有意不释放，避免进程退出时与仍在运行的线程冲突
+    Registry& registry() {
+        static Registry* s_registry = new Registry();
+        return *s_registry;
+    }
+
+    thread_local ThreadBuffer* t_buffer = nullptr;
+
+    ThreadBuffer* threadBuffer() {
+        if (t_buffer) return t_buffer;
+
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->threadId = (uint32_t)reg.buffers.size() + 1;
+        t_buffer = buffer.get();
+        reg.buffers.push_back(std::move(buffer));
+        return t_buffer;
+    }
+
+    void appendEscaped(std::string& out, const char* text) {
+        for (const char* p = text; *p; ++p) {
+            char c = *p;
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            }
+            else if ((unsigned char)c < 0x20) {
+                out += ' ';
+            }
+            else {
+                out += c;
+            }
+        }
+    }
+
+    struct ZoneCopy {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+}
+
+uint64_t Profiler::nowNs() {
+    static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer* buffer = threadBuffer();
+    uint64_t index = buffer->begin.load(std::memory_order_relaxed);
+    buffer->begin.store(index + 1, std::memory_order_relaxed);
+    // 保证导出方读到本次写入的字段时，也能读到推进后的 begin
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Zone& zone = buffer->zones[index & kZoneMask];
+    zone.name.store(name, std::memory_order_relaxed);
+    zone.startNs.store(startNs, std::memory_order_relaxed);
+    zone.endNs.store(endNs, std::memory_order_relaxed);
+    buffer->end.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer->name = name;
+}
+
+/**
+ * @brief 生成 Chrome Trace Event 格式的 JSON
+ * @param lastSeconds 只导出结束时间在最近 lastSeconds 秒内的记录
+ * @return JSON 文本
+ *
+ * @details
+ * - 每个线程输出一条 thread_name 元数据，然后是该线程的完整事件（ph = "X"，时间单位微秒）
+ * - 嵌套关系由时间区间决定，查看器会按同一线程内的包含关系自动缩进
+ */
+std::string Profiler::buildChromeTrace(double lastSeconds) {
+    uint64_t now = nowNs();
+    uint64_t window = lastSeconds > 0.0 ? (uint64_t)(lastSeconds * 1e9) : now;
+    uint64_t cutoff = now > window ? now - window : 0;
+
+    std::string out;
+    out.reserve(1 << 16);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char line[128];
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<ZoneCopy> zones;
+    for (const auto& buffer : reg.buffers) {
+        // ========== 步骤1：复制环形缓冲中已写完的记录 ==========
+        uint64_t end = buffer->end.load(std::memory_order_acquire);
+        uint64_t from = end > ZONES_PER_THREAD ? end - ZONES_PER_THREAD : 0;
+        zones.clear();
+        for (uint64_t i = from; i < end; ++i) {
+            const Zone& zone = buffer->zones[i & kZoneMask];
+            ZoneCopy copy;
+            copy.name = zone.name.load(std::memory_order_relaxed);
+            copy.startNs = zone.startNs.load(std::memory_order_relaxed);
+            copy.endNs = zone.endNs.load(std::memory_order_relaxed);
+            zones.push_back(copy);
+        }
+
+        // ========== 步骤2：丢弃复制期间被覆盖的记录 ==========
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t begin = buffer->begin.load(std::memory_order_relaxed);
+        uint64_t valid = begin > ZONES_PER_THREAD ? begin - ZONES_PER_THREAD : 0;
+        size_t skip = valid > from ? (size_t)(valid - from) : 0;
+
+        // ========== 步骤3：输出线程名和时间窗口内的记录 ==========
+        out += first ? "\n" : ",\n";
+        first = false;
+        snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"",
+            kTracePid, buffer->threadId);
+        out += line;
+        if (buffer->name.empty()) {
+            snprintf(line, sizeof(line), "thread %u", buffer->threadId);
+            out += line;
+        }
+        else {
+            appendEscaped(out, buffer->name.c_str());
+        }
+        out += "\"}}";
+
+        for (size_t i = skip; i < zones.size(); ++i) {
+            const ZoneCopy& zone = zones[i];
+            if (zone.endNs < cutoff || !zone.name) continue;
+            out += ",\n{\"name\":\"";
+            appendEscaped(out, zone.name);
+            snprintf(line, sizeof(line), "\",\"cat\":\"cardgame\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                kTracePid, buffer->threadId, zone.startNs / 1000.0, (zone.endNs - zone.startNs) / 1000.0);
+            out += line;
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path, double lastSeconds) {
+    std::string trace = buildChromeTrace(lastSeconds);
+    FILE* file = fopen(path.c_str(), "wb");
+    bool ok = file != nullptr && fwrite(trace.data(), 1, trace.size(), file) == trace.size();
+    if (file && fclose(file) != 0) ok = false;
+    if (!ok) {
+        CORE_LOG("Profiler: failed to write %s", path.c_str());
+        return false;
+    }
+    CORE_LOG("Profiler: wrote %d bytes of trace to %s", (int)trace.size(), path.c_str());
+    return true;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file Profiler.h
+ * @brief 作用域计时器 - 记录代码段的耗时，导出为 Chrome / Perfetto 可以打开的 trace JSON
+ *
+ * @details
+ * - PROFILE_ZONE("名字") 在当前作用域开始时记时间，离开作用域时把 (名字, 开始, 结束) 写入本线程的缓冲
+ * - 每个线程一个固定大小的环形缓冲（线程第一次记录时分配），写入不加锁、不分配内存；
+ *   缓冲写满后覆盖最旧的记录，因此始终保留最近一段时间的数据
+ * - writeChromeTrace 可以在任意线程调用，导出所有线程最近 N 秒的记录（正在被覆盖的记录会被跳过）
+ * - 未定义 CARDGAME_PROFILER 时所有宏展开为空，不产生任何代码
+ *
+ * @note 名字必须是字符串字面量（或生命周期覆盖整个进程的字符串），缓冲中只保存指针
+ *
+ * @example
+ * ```cpp
+ * void GameController::performMoveCard(...) {
+ *     PROFILE_ZONE("GameController::performMoveCard");
+ *     ...
+ * }
+ * // 导出最近 5 秒，用 chrome://tracing 或 ui.perfetto.dev 打开
+ * Profiler::writeChromeTrace(path, 5.0);
+ * ```
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Profiler {
+public:
+    // 每个线程缓冲的记录数（每条 24 字节）
+    static const size_t ZONES_PER_THREAD = 16384;
+
+    // 单调时钟，进程内第一次调用时为 0（纳秒）
+    static uint64_t nowNs();
+
+    // 写入一条记录（当前线程）
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // 设置当前线程在 trace 中显示的名字
+    static void setThreadName(const char* name);
+
+    /**
+     * @brief 生成最近 lastSeconds 秒的 trace（Chrome Trace Event 格式）
+     * @param lastSeconds 小于等于 0 时导出缓冲中的全部记录
+     */
+    static std::string buildChromeTrace(double lastSeconds);
+
+    // 生成 trace 并写入文件，失败时返回 false
+    static bool writeChromeTrace(const std::string& path, double lastSeconds);
+};
+
+/**
+ * @brief 作用域计时：构造时记录开始时间，析构时写入一条记录
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : _name(name)
+        , _startNs(Profiler::nowNs())
+    {
+    }
+
+    ~ProfileScope() {
+        Profiler::record(_name, _startNs, Profiler::nowNs());
+    }
+
+private:
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    const char* _name;
+    uint64_t _startNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if CARDGAME_PROFILER
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,114 @@
+/**
+ * @file SpscQueue.h
+ * @brief 有界无锁单生产者单消费者队列 - 一个工作线程把结果记录交给主线程
+ *
+ * @details
+ * - 容量在构造时固定（向上取整到 2 的幂），之后入队、出队都不分配内存、不加锁
+ * - 生产者只写 _tail、消费者只写 _head，两者之间用一条缓存行的填充隔开
+ *   （队列可能在堆上分配，C++11 的 new 不保证 alignas(64)，因此不用 alignas）；
+ *   双方各自缓存对方的下标，只有看起来满 / 空时才重新读取，减少缓存行来回传递
+ * - 元素类型应为定长的结果记录（POD 或可廉价赋值的类型），槽位在出队后保留原值直到被覆盖
+ *
+ * @note 同一时刻只能有一个线程调用 tryPush，一个线程调用 tryPop / drain
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : _head(0)
+        , _cachedTail(0)
+        , _tail(0)
+        , _cachedHead(0)
+    {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        _buffer.resize(size);
+        _mask = size - 1;
+    }
+
+    /**
+     * @brief 入队（生产者）
+     * @return 队列已满时返回 false，不阻塞
+     */
+    bool tryPush(const T& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead > _mask) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead > _mask) return false;
+        }
+        _buffer[tail & _mask] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队（消费者）
+     * @return 队列为空时返回 false
+     */
+    bool tryPop(T& out) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) return false;
+        }
+        out = _buffer[head & _mask];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 依次取出并处理元素（消费者）
+     * @param handler 以 const T& 调用
+     * @param maxCount 最多处理的个数
+     * @return 处理的个数
+     */
+    template <typename Handler>
+    size_t drain(Handler&& handler, size_t maxCount = std::numeric_limits<size_t>::max()) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (head != _cachedTail && count < maxCount) {
+            handler(_buffer[head & _mask]);
+            ++head;
+            ++count;
+        }
+        // 处理完整批后才归还槽位，handler 中读取的元素不会被生产者覆盖
+        _head.store(head, std::memory_order_release);
+        return count;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // 当前元素个数的近似值（另一方可能正在修改）
+    size_t sizeApprox() const {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+private:
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::vector<T> _buffer;
+    size_t _mask;
+
+    // 消费者一侧
+    char _padding0[64];
+    std::atomic<size_t> _head;
+    size_t _cachedTail;
+
+    // 生产者一侧
+    char _padding1[64];
+    std::atomic<size_t> _tail;
+    size_t _cachedHead;
+    char _padding2[64];
+};
+
+#endif // SPSC_QUEUE_H
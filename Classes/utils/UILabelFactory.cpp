@@ -0,0 +1,44 @@
+#include "utils/UILabelFactory.h"
+
+using namespace cocos2d;
+
+// 构建时生成的位图字体，按分辨率档位通过搜索路径选择
+static const char* kUIFontFile = "fonts/ui.fnt";
+
+// 回退使用的系统字体
+static const char* kFallbackFontName = "Arial";
+
+bool UILabelFactory::hasBitmapFont() {
+    static const bool s_hasBitmapFont = FileUtils::getInstance()->isFileExist(kUIFontFile);
+    return s_hasBitmapFont;
+}
+
+Label* UILabelFactory::createLabel(const std::string& text, float fontSize) {
+    if (hasBitmapFont()) {
+        auto label = Label::createWithBMFont(kUIFontFile, text);
+        if (label) {
+            // 位图字体按固定字号生成，这里按目标字号整体缩放
+            label->setBMFontSize(fontSize);
+            return label;
+        }
+    }
+    return Label::createWithSystemFont(text, kFallbackFontName, fontSize);
+}
+
+void UILabelFactory::setButtonTitle(ui::Button* button, const std::string& text, float fontSize) {
+    if (!button) return;
+
+    if (hasBitmapFont()) {
+        // 先以空文字替换标题标签，再通过 setTitleText 设置文字，让按钮按标题尺寸更新自身大小
+        auto label = Label::createWithBMFont(kUIFontFile, "");
+        if (label) {
+            label->setBMFontSize(fontSize);
+            button->setTitleLabel(label);
+            button->setTitleText(text);
+            return;
+        }
+    }
+
+    button->setTitleText(text);
+    button->setTitleFontSize(fontSize);
+}
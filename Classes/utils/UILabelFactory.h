@@ -0,0 +1,42 @@
+/**
+ * @file UILabelFactory.h
+ * @brief UI 文字工厂 - 统一创建界面上的文字标签
+ *
+ * @details 
+ * - 优先使用构建时由 tools/gen_ui_font.py 预先生成的位图字体（fonts/ui.fnt），
+ *   所有字形在一张贴图里，运行时不经过平台字体栈光栅化，修改文字也只是更新顶点
+ * - 位图字体不存在时（例如构建机没有安装 Pillow）回退到系统字体，显示效果一致
+ */
+#ifndef UI_LABEL_FACTORY_H
+#define UI_LABEL_FACTORY_H
+
+#include "cocos2d.h"
+#include "ui/CocosGUI.h"
+#include <string>
+
+class UILabelFactory {
+public:
+    /**
+     * @brief 创建文字标签
+     * @param text 初始文字
+     * @param fontSize 字号（设计分辨率下的像素）
+     * @return cocos2d::Label* 自动释放的标签
+     */
+    static cocos2d::Label* createLabel(const std::string& text, float fontSize);
+
+    /**
+     * @brief 设置按钮标题
+     * @param button 目标按钮
+     * @param text 标题文字
+     * @param fontSize 字号
+     * @details 位图字体可用时替换按钮内部的标题标签，否则等同于 setTitleText + setTitleFontSize
+     */
+    static void setButtonTitle(cocos2d::ui::Button* button, const std::string& text, float fontSize);
+
+    /**
+     * @brief 位图字体是否可用（首次调用时检查一次）
+     */
+    static bool hasBitmapFont();
+};
+
+#endif // UI_LABEL_FACTORY_H
@@ -0,0 +1,3 @@
+#include "utils/Vector2.h"
+
+const Vector2 Vector2::ZERO;
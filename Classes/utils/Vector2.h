@@ -0,0 +1,36 @@
+/**
+ * @file Vector2.h
+ * @brief 核心库使用的二维向量 - 替代 cocos2d::Vec2，使 Model / Service / Manager 不依赖引擎
+ *
+ * @details 
+ * - 只提供核心逻辑用到的运算（加减、数乘、判等）
+ * - 与 cocos2d::Vec2 内存布局相同（两个 float），视图层通过 utils/VectorConvert.h 互相转换
+ */
+#ifndef VECTOR2_H
+#define VECTOR2_H
+
+struct Vector2 {
+    float x;
+    float y;
+
+    // constexpr 构造保证 ZERO 在静态初始化阶段就绪
+    constexpr Vector2() : x(0.0f), y(0.0f) {}
+    constexpr Vector2(float xx, float yy) : x(xx), y(yy) {}
+
+    // 精确判等（与 cocos2d::Vec2::equals 语义一致）
+    bool equals(const Vector2& other) const { return x == other.x && y == other.y; }
+
+    bool operator==(const Vector2& other) const { return equals(other); }
+    bool operator!=(const Vector2& other) const { return !equals(other); }
+
+    Vector2 operator+(const Vector2& other) const { return Vector2(x + other.x, y + other.y); }
+    Vector2 operator-(const Vector2& other) const { return Vector2(x - other.x, y - other.y); }
+    Vector2 operator*(float s) const { return Vector2(x * s, y * s); }
+
+    Vector2& operator+=(const Vector2& other) { x += other.x; y += other.y; return *this; }
+    Vector2& operator-=(const Vector2& other) { x -= other.x; y -= other.y; return *this; }
+
+    static const Vector2 ZERO;
+};
+
+#endif // VECTOR2_H
@@ -0,0 +1,21 @@
+/**
+ * @file VectorConvert.h
+ * @brief 核心库 Vector2 与 cocos2d::Vec2 的互相转换（仅客户端使用）
+ *
+ * @note 核心库本身不包含此文件，保持与引擎无关
+ */
+#ifndef VECTOR_CONVERT_H
+#define VECTOR_CONVERT_H
+
+#include "cocos2d.h"
+#include "utils/Vector2.h"
+
+inline cocos2d::Vec2 toVec2(const Vector2& v) {
+    return cocos2d::Vec2(v.x, v.y);
+}
+
+inline Vector2 toVector2(const cocos2d::Vec2& v) {
+    return Vector2(v.x, v.y);
+}
+
+#endif // VECTOR_CONVERT_H
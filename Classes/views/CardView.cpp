@@ -14,9 +14,25 @@
  */
 
 #include "views/CardView.h"
+#include "utils/AllocTracker.h"
+#include "utils/Profiler.h"
+#include "utils/VectorConvert.h"
+#include <algorithm>
 
 using namespace cocos2d;
 
+// 裁剪包围盒外扩比例：覆盖移动段中 1.2 倍的弹跳缩放
+static const float kCullBoundsScale = 1.25f;
+
+// 移动段动画的 Action 标签，只停止自己的动画，不影响其他 Action
+static const int kMoveActionTag = 0x4d4f5645;
+
+// 移动段的最短时长：排队再多，每段也至少播放这么久，避免看起来像瞬移
+static const float kMinSegmentDuration = 0.08f;
+
+// "吃牌"回弹的放大倍数
+static const float kBounceScale = 1.2f;
+
 /**
  * @brief 创建卡牌视图（静态工厂方法）
  * @param model 卡牌数据模型（只读）
@@ -67,6 +83,9 @@ bool CardView::init(const CardModel* model) {
         this->addChild(debugLayer);
     }
 
+    // 先记录卡牌尺寸，后续 setPosition 依赖它计算裁剪包围盒
+    _cardSize = bgSize;
+
     // ========== 坐标系计算 ==========
     // 坐标原点在卡牌中心 (0,0)
     // 左上角锚点位置：X 轴向右 12%，Y 轴向上 88%
@@ -113,7 +132,7 @@ bool CardView::init(const CardModel* model) {
     }
 
     // ========== 5. 设置初始位置与层级 ==========
-    this->setPosition(_model->getPosition());
+    this->setPosition(toVec2(_model->getPosition()));
     this->setLocalZOrder(_model->getZIndex());
 
     // ========== 6. 绑定触摸事件 ==========
@@ -134,6 +153,7 @@ bool CardView::init(const CardModel* model) {
         };
     // 触摸结束：触发回调
     listener->onTouchEnded = [this](Touch* touch, Event* event) {
+        PROFILE_ZONE("CardView::onTouchEnded");
         if (_onClickCallback) _onClickCallback(_modelId);
         };
     _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
@@ -159,9 +179,10 @@ void CardView::setClickCallback(std::function<void(int)> callback) {
  * - REMOVED: 隐藏整个节点
  */
 void CardView::updateView() {
+    PROFILE_ZONE("CardView::updateView");
     if (!_model) return;
 
-    this->setPosition(_model->getPosition());
+    this->setPosition(toVec2(_model->getPosition()));
     this->setLocalZOrder(_model->getZIndex());
 
     if (_model->getState() == CardState::FACE_UP) {
@@ -183,6 +204,140 @@ void CardView::updateView() {
     this->setVisible(_model->getState() != CardState::REMOVED);
 }
 
+/**
+ * @brief 追加一段移动动画
+ * @param target 目标位置
+ * @param zOrder 本段结束时的层级
+ * @param duration 标准时长（秒）
+ * @param bounce 是否叠加回弹效果
+ */
+void CardView::enqueueMove(const Vec2& target, int zOrder, float duration, bool bounce) {
+    PROFILE_ZONE("CardView::enqueueMove");
+    ALLOC_SCOPE(AllocTag::VIEWS);
+    MoveSegment segment;
+    segment.target = target;
+    segment.zOrder = zOrder;
+    segment.duration = duration;
+    segment.bounce = bounce;
+    _moveSegments.push_back(segment);
+
+    if (!_segmentRunning) startNextSegment();
+}
+
+/**
+ * @brief 取消所有移动段
+ */
+void CardView::cancelMoves() {
+    _moveSegments.clear();
+    _segmentRunning = false;
+    stopActionByTag(kMoveActionTag);
+    Node::setScale(_baseScale);
+}
+
+/**
+ * @brief 设置基础缩放
+ * @param scale 屏幕布局给出的卡牌缩放
+ */
+void CardView::setBaseScale(float scale) {
+    _baseScale = scale;
+    Node::setScale(scale);
+}
+
+/**
+ * @brief 播放下一段移动动画
+ *
+ * @details 
+ * - 实际时长 = 标准时长 / (1 + 剩余排队段数)，连续快速点击时后面的段自动加速
+ * - 段结束时设置层级，然后继续下一段
+ * - 队列播放完毕后调用 updateView()，以 Model 为准刷新位置、层级和正反面
+ */
+void CardView::startNextSegment() {
+    PROFILE_ZONE("CardView::startNextSegment");
+    ALLOC_SCOPE(AllocTag::VIEWS);
+    if (_moveSegments.empty()) {
+        _segmentRunning = false;
+        updateView();
+        return;
+    }
+
+    MoveSegment segment = _moveSegments.front();
+    _moveSegments.pop_front();
+    _segmentRunning = true;
+
+    float duration = std::max(kMinSegmentDuration, segment.duration / (1 + _moveSegments.size()));
+    FiniteTimeAction* motion = MoveTo::create(duration, segment.target);
+    if (segment.bounce) {
+        // Spawn: 同时执行移动 + 缩放弹跳效果（先放大再缩回，模拟"吃牌"的反馈）
+        motion = Spawn::create(motion, Sequence::create(
+            ScaleTo::create(duration / 2, _baseScale * kBounceScale),
+            ScaleTo::create(duration / 2, _baseScale), nullptr), nullptr);
+    }
+
+    int zOrder = segment.zOrder;
+    auto finished = CallFunc::create([this, zOrder]() {
+        this->setLocalZOrder(zOrder);
+        this->startNextSegment();
+        });
+
+    auto action = Sequence::create(motion, finished, nullptr);
+    action->setTag(kMoveActionTag);
+    runAction(action);
+}
+
+/**
+ * @brief 场景遍历，完全在屏幕外的卡牌直接跳过
+ * @param renderer 渲染器
+ * @param parentTransform 父节点变换
+ * @param parentFlags 父节点脏标记
+ *
+ * @note 跳过遍历时本节点的变换脏标记不会被消耗，
+ *       卡牌重新进入屏幕时 Node::visit 会照常刷新变换
+ */
+void CardView::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) {
+    if (!_visible || !isInsideVisibleRect()) return;
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
+/**
+ * @brief 设置位置，并刷新裁剪包围盒
+ * @param x 父节点坐标系下的新位置 x
+ * @param y 父节点坐标系下的新位置 y
+ */
+void CardView::setPosition(float x, float y) {
+    Node::setPosition(x, y);
+    updateCullBounds();
+}
+
+/**
+ * @brief 根据当前位置计算裁剪包围盒（锚点在卡牌中心）
+ */
+void CardView::updateCullBounds() {
+    float width = _cardSize.width * kCullBoundsScale;
+    float height = _cardSize.height * kCullBoundsScale;
+    _cullBounds = Rect(_position.x - width / 2, _position.y - height / 2, width, height);
+}
+
+/**
+ * @brief 包围盒是否与可见区域相交
+ * @return bool 相交返回 true
+ *
+ * @details GameView 铺满屏幕且位于原点，因此父节点坐标系即为可见区域所在的坐标系。
+ *          可见区域按帧缓存，同一帧内所有卡牌共享一次查询结果。
+ */
+bool CardView::isInsideVisibleRect() const {
+    static unsigned int s_cachedFrame = (unsigned int)-1;
+    static Rect s_visibleRect;
+
+    auto director = Director::getInstance();
+    if (director->getTotalFrames() != s_cachedFrame) {
+        s_cachedFrame = director->getTotalFrames();
+        Vec2 origin = director->getVisibleOrigin();
+        Size size = director->getVisibleSize();
+        s_visibleRect = Rect(origin.x, origin.y, size.width, size.height);
+    }
+    return s_visibleRect.intersectsRect(_cullBounds);
+}
+
 /**
  * @brief 获取花色图片路径
  * @param suit 花色枚举
@@ -19,6 +19,7 @@
 #include "cocos2d.h"
 #include "models/CardModel.h"
 #include "configs/GameConsts.h" // 确保包含枚举定义
+#include <deque>
 #include <functional>
 #include <string>
 
@@ -65,7 +66,67 @@ public:
      */
     int getCardId() const { return _modelId; }
 
+    /**
+     * @brief 场景遍历（重写 Node::visit）
+     * @details 卡牌包围盒完全位于屏幕可见区域之外时直接返回：
+     * - 不遍历子节点（底板、数字、花色精灵）
+     * - 不提交任何绘制命令
+     * 例如备用牌堆按 70 像素扇形展开时，超出 1080 宽设计区域的牌
+     */
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
+
+    /**
+     * @brief 设置位置（重写 Node::setPosition(float, float)）
+     * @details 其它 setPosition 重载和 setPosition3D（MoveTo / MoveBy 每一帧）最终都调用这个重载，
+     *          在这里同步刷新缓存的裁剪包围盒；重写它也不会隐藏 Node 的其它 setPosition 重载
+     */
+    using cocos2d::Node::setPosition;
+    virtual void setPosition(float x, float y) override;
+
+    /**
+     * @brief 追加一段移动动画
+     * @param target 目标位置（父节点坐标系）
+     * @param zOrder 本段结束时设置的层级
+     * @param duration 标准时长（秒），排队的段越多实际时长越短，让视图追上数据
+     * @param bounce 是否叠加"吃牌"的放大回弹效果
+     *
+     * @details 
+     * - 数据层已经提交了移动，这里只负责表现；正在播放的段不会被打断，新段排在其后
+     * - 全部段播放完毕后调用 updateView() 与 Model 对齐
+     */
+    void enqueueMove(const cocos2d::Vec2& target, int zOrder, float duration, bool bounce);
+
+    /**
+     * @brief 取消所有排队和正在播放的移动段（例如重新布局时），不刷新视图
+     */
+    void cancelMoves();
+
+    /**
+     * @brief 是否有移动动画正在播放或排队
+     */
+    bool isMoving() const { return _segmentRunning; }
+
+    /**
+     * @brief 设置基础缩放（由屏幕布局决定），回弹效果以它为基准
+     */
+    void setBaseScale(float scale);
+
 private:
+    /**
+     * @brief 单段移动动画
+     */
+    struct MoveSegment {
+        cocos2d::Vec2 target;
+        int zOrder;
+        float duration;
+        bool bounce;
+    };
+
+    /**
+     * @brief 开始播放下一段，没有待播放的段时与 Model 对齐
+     */
+    void startNextSegment();
+
     /**
      * @brief 初始化方法（私有）
      * @param model 卡牌数据模型
@@ -97,6 +158,19 @@ private:
      */
     std::string getNumberFilename(CardFaceType face, CardSuitType suit, bool isBig);
 
+    /**
+     * @brief 根据当前位置重新计算裁剪包围盒
+     * @details 包围盒位于父节点（GameView）坐标系，按卡牌尺寸外扩一定余量，
+     *          以覆盖"吃牌"时 1.2 倍的弹跳缩放
+     */
+    void updateCullBounds();
+
+    /**
+     * @brief 判断裁剪包围盒是否与屏幕可见区域相交
+     * @note 可见区域每帧只向 Director 查询一次
+     */
+    bool isInsideVisibleRect() const;
+
     // --- UI 组件 ---
     cocos2d::Sprite* _bgSprite;        // 背景精灵（牌背或牌面底板）
 
@@ -105,6 +179,15 @@ private:
     cocos2d::Sprite* _smallNumSprite;  // 左上角的小数字图片
     cocos2d::Sprite* _smallSuitSprite; // 左上角的小花色图片
 
+    // --- 裁剪 ---
+    cocos2d::Size _cardSize;           // 卡牌尺寸（底板贴图尺寸）
+    cocos2d::Rect _cullBounds;         // 缓存的包围盒（父节点坐标系），仅在位置变化时更新
+
+    // --- 移动动画 ---
+    std::deque<MoveSegment> _moveSegments; // 排队中的移动段（不含正在播放的段）
+    bool _segmentRunning = false;          // 是否有段正在播放
+    float _baseScale = 1.0f;               // 基础缩放
+
     // --- 数据引用 ---
     const CardModel* _model;// 持有 Model 的只读指针
     int _modelId;// 缓存 ID，方便快速访问
@@ -15,6 +15,8 @@
  */
 #include "views/GameView.h"
 #include "controllers/GameController.h" 
+#include "utils/Profiler.h"
+#include "utils/UILabelFactory.h"
 #include "ui/CocosGUI.h"
 
 using namespace cocos2d;
@@ -34,64 +36,89 @@ Scene* GameView::createScene() {
     return scene;
 }
 
+const std::string GameView::EVENT_SCREEN_RESIZED = "glview_window_resized";
+
 /**
  * @brief 初始化视图
  * @return bool 初始化是否成功
  * 
- * @details 布局逻辑：
- * 1. **获取屏幕尺寸**：适配不同分辨率设备
- * 2. **绘制背景**：
- *    - 底部区域（高度 580px）：放置备用牌堆和底牌堆
+ * @details 构建逻辑：
+ * 1. **绘制背景**：
+ *    - 底部区域：放置备用牌堆和底牌堆
  *    - 顶部区域（剩余高度）：放置主牌区金字塔
- * 3. **创建 UI**：
+ * 2. **创建 UI**：
  *    - Undo 按钮：放置在底部区域右侧
- *    - 绑定点击事件：通过 getUserObject() 获取 Controller 并调用 onUndoClicked
+ *    - 绑定点击事件：通过 getUserObject() 获取 Controller 并压入 UNDO 命令
+ * 3. **监听屏幕尺寸变化**：转发给 Controller 重新布局
+ *
+ * @note 这里只创建节点，尺寸与位置统一由 applyLayout 根据 LayoutService 的结果设置
  */
 bool GameView::init() {
     if (!Layer::init()) return false;
 
-    Size visibleSize = Director::getInstance()->getVisibleSize();
-
-    // 定义底部操作区的高度（像素）
-    // 这个高度决定了上下背景的分界线
-    float bottomAreaHeight = 580.0f;
-
     // ========== 1. 创建底部背景（紫色区域） ==========
     // Color4B(R, G, B, A) - 紫色 (146, 54, 147)
-    auto bottomBg = LayerColor::create(Color4B(146, 54, 147, 255));
-    bottomBg->setContentSize(Size(visibleSize.width, bottomAreaHeight));
-    this->addChild(bottomBg, -1);
+    _bottomBg = LayerColor::create(Color4B(146, 54, 147, 255));
+    this->addChild(_bottomBg, -1);
 
     // ========== 2. 创建顶部背景（土黄色区域） ==========
     // Color4B(R, G, B, A) - 土黄色 (173, 129, 80)
-    // 高度 = 总高度 - 底部高度
-    auto topBg = LayerColor::create(Color4B(173, 129, 80, 255));
-    topBg->setContentSize(Size(visibleSize.width, visibleSize.height - bottomAreaHeight));
-    topBg->setPosition(Vec2(0, bottomAreaHeight));
-    this->addChild(topBg, -1);
+    _topBg = LayerColor::create(Color4B(173, 129, 80, 255));
+    this->addChild(_topBg, -1);
 
     // ========== 3. 创建撤销按钮 (Undo) ==========
     auto undoBtn = Button::create();
-    undoBtn->setTitleText("Undo");
-    undoBtn->setTitleFontSize(40);
-
-    // 布局位置：屏幕宽度 85% 处，底部区域垂直居中
-    undoBtn->setPosition(Vec2(visibleSize.width * 0.85f, bottomAreaHeight / 2));
+    UILabelFactory::setButtonTitle(undoBtn, "Undo", 40);
 
     // 绑定点击事件
     undoBtn->addClickEventListener([this](Ref* sender) {
+        PROFILE_ZONE("GameView::onUndoButton");
         // 获取绑定的 Controller 对象（在 GameController::initView 中设置）
         // 使用 static_cast 进行类型转换
         auto controller = static_cast<GameController*>(this->getUserObject());
         if (controller) {
-            controller->onUndoClicked();
+            controller->enqueueInput(InputCommandType::UNDO);
         }
         });
 
     this->addChild(undoBtn, 100);// ZOrder 100 确保按钮在最上层，不被卡牌遮挡
+    _undoBtn = undoBtn;
+
+    // ========== 4. 监听屏幕尺寸变化 ==========
+    // 监听器绑定在本节点上，场景销毁时自动移除
+    auto resizeListener = EventListenerCustom::create(EVENT_SCREEN_RESIZED, [this](EventCustom*) {
+        auto controller = static_cast<GameController*>(this->getUserObject());
+        if (controller) {
+            controller->relayout();
+        }
+        });
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(resizeListener, this);
+
+    // 在 Controller 计算布局之前先按当前屏幕给出默认摆放
+    applyLayout(LayoutService::computeLayout(Director::getInstance()->getVisibleSize(), Rect::ZERO));
     return true;
 }
 
+/**
+ * @brief 按布局结果摆放背景与 Undo 按钮
+ * @param layout LayoutService 计算出的布局
+ *
+ * @details 
+ * - 底部背景：高度为 bottomAreaHeight
+ * - 顶部背景：从分界线铺到屏幕顶端
+ * - Undo 按钮：放在布局给出的锚点
+ */
+void GameView::applyLayout(const ScreenLayout& layout) {
+    const Size& visibleSize = layout.visibleSize;
+
+    _bottomBg->setContentSize(Size(visibleSize.width, layout.bottomAreaHeight));
+
+    _topBg->setContentSize(Size(visibleSize.width, visibleSize.height - layout.bottomAreaHeight));
+    _topBg->setPosition(Vec2(0, layout.bottomAreaHeight));
+
+    _undoBtn->setPosition(layout.undoButtonPos);
+}
+
 /**
  * @brief 添加卡牌视图到场景中
  * @param cardView 要添加的卡牌节点
@@ -103,5 +130,34 @@ bool GameView::init() {
 void GameView::addCardView(CardView* cardView) {
     if (cardView) {
         this->addChild(cardView);
+        _cardViews[cardView->getCardId()] = cardView;
+    }
+}
+
+/**
+ * @brief 按卡牌 ID 查找视图
+ * @param cardId 卡牌唯一标识
+ * @return CardView* 找不到时返回 nullptr
+ *
+ * @note 替代遍历 getChildren() + dynamic_cast 的查找方式
+ */
+CardView* GameView::getCardView(int cardId) const {
+    auto it = _cardViews.find(cardId);
+    return it != _cardViews.end() ? it->second : nullptr;
+}
+
+/**
+ * @brief 更新备用堆角标
+ * @param position 角标位置（通常位于备用堆下方）
+ * @param hiddenCount 尚未创建视图的备用牌数量
+ */
+void GameView::updateStockBadge(const Vec2& position, int hiddenCount) {
+    if (!_stockBadge) {
+        if (hiddenCount <= 0) return;
+        _stockBadge = UILabelFactory::createLabel("", 36);
+        this->addChild(_stockBadge, 1000);// 位于所有卡牌之上
     }
+    _stockBadge->setPosition(position);
+    _stockBadge->setString(StringUtils::format("+%d", hiddenCount));
+    _stockBadge->setVisible(hiddenCount > 0);
 }
\ No newline at end of file
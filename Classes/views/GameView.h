@@ -2,19 +2,46 @@
 #define GAME_VIEW_H
 
 #include "cocos2d.h"
-#include "views/CardView.h" // ֻ CardView Ǳ
+#include "views/CardView.h" // 只有 CardView 是必须包含的
+#include "services/LayoutService.h"
+#include <string>
+#include <unordered_map>
 #include <vector>
 
-// ע⡿ԲҪ include GameController.h
-// ҲҪǰ GameControllerΪ .h ûõ
+// 【注意】绝对不要在这里 include GameController.h
+// 也不需要前向声明 GameController，因为 .h 里没用到它
 
 class GameView : public cocos2d::Layer {
 public:
+    // 屏幕尺寸变化事件（与桌面端 GLViewImpl::EVENT_WINDOW_RESIZED 同名，移动端由 AppDelegate 派发）
+    static const std::string EVENT_SCREEN_RESIZED;
+
     static cocos2d::Scene* createScene();
     CREATE_FUNC(GameView);
 
     virtual bool init();
     void addCardView(CardView* cardView);
+
+    // 按卡牌 ID 查找视图，未创建视图的卡牌（例如备用堆底部的牌）返回 nullptr
+    CardView* getCardView(int cardId) const;
+
+    // 更新备用堆角标：显示尚未创建视图的牌数，hiddenCount 为 0 时隐藏
+    void updateStockBadge(const cocos2d::Vec2& position, int hiddenCount);
+
+    // 按布局结果摆放背景与 Undo 按钮（首次进入和屏幕尺寸变化时调用）
+    void applyLayout(const ScreenLayout& layout);
+
+private:
+    // 上下背景与 Undo 按钮，布局变化时需要重新摆放
+    cocos2d::LayerColor* _bottomBg = nullptr;
+    cocos2d::LayerColor* _topBg = nullptr;
+    cocos2d::Node* _undoBtn = nullptr;
+
+    // 卡牌 ID -> 视图（视图由场景树持有，这里只做索引）
+    std::unordered_map<int, CardView*> _cardViews;
+
+    // 备用堆剩余张数角标（首次需要时创建）
+    cocos2d::Label* _stockBadge = nullptr;
 };
 
-#endif // GAME_VIEW_H
\ No newline at end of file
+#endif // GAME_VIEW_H
@@ -1,83 +1,120 @@
 /**
  * @file LevelSelectView.cpp
- * @brief ؿѡ񳡾ʵ - Ϸڽ
+ * @brief 关卡选择场景实现 - 游戏的入口界面
  * 
- * @details ְ
- * 1. **չʾ**ΪϷĵһչʾؿб
- * 2. **û**ṩťѡؿ
- * 3. **ת**ѡ¼ GameController ؿ
+ * @details 职责：
+ * 1. **展示入口**：作为游戏启动后的第一个场景，展示关卡列表
+ * 2. **用户交互**：提供按钮供玩家选择关卡
+ * 3. **流程跳转**：捕获选择事件，调用 GameController 启动具体关卡
  * 
- * @note Ʒ
- * - üƣɫ + ɫ
- * - ʹ CocosGUI  Button ԴЧ
+ * @note 设计风格：
+ * - 采用极简设计：深灰色背景 + 白色文字
+ * - 使用 CocosGUI 的 Button 组件，自带点击效果
+ * - 文字统一通过 UILabelFactory 创建（预生成的位图字体，白色字形）
  */
 #include "views/LevelSelectView.h"
 #include "controllers/GameController.h"
+#include "controllers/GameServices.h"
+#include "utils/UILabelFactory.h"
 #include "ui/CocosGUI.h"
 
 using namespace cocos2d;
 using namespace cocos2d::ui;
 
 /**
- * @brief ʼ
- * @return bool ʼǷɹ
+ * @brief 创建场景
+ * @param services 跨关卡共享的服务
+ */
+LevelSelectView* LevelSelectView::create(const std::shared_ptr<GameServices>& services) {
+    LevelSelectView* pRet = new(std::nothrow) LevelSelectView();
+    if (pRet && pRet->init(services)) {
+        pRet->autorelease();
+        return pRet;
+    }
+    delete pRet;
+    pRet = nullptr;
+    return nullptr;
+}
+
+/**
+ * @brief 初始化场景
+ * @param services 跨关卡共享的服务
+ * @return bool 初始化是否成功
  * 
- * @details ߼
- * 1. ****ȫɫ LayerColor
- * 2. ****ĻϷ 70% ʾ "SELECT LEVEL"
- * 3. **ť**Ļʾ "Level 1" ť
- *    - ʹ Lambda ʽ󶨵¼
- *    -  onLevelSelected(1)
+ * @details 布局逻辑：
+ * 1. **背景**：创建全屏深灰色 LayerColor
+ * 2. **标题**：屏幕上方 70% 处显示 "SELECT LEVEL"
+ * 3. **按钮**：屏幕中央显示 "Level 1" 按钮
+ *    - 使用 Lambda 表达式绑定点击事件
+ *    - 点击后调用 onLevelSelected(1)
+ * 4. **继续**：存在存档时，在下方显示 "Resume" 按钮，点击后继续上次的一局
  */
-bool LevelSelectView::init() {
-    // ø Scene  init ȷ
+bool LevelSelectView::init(const std::shared_ptr<GameServices>& services) {
+    // 调用父类 Scene 的 init 方法，确保基础场景功能正常
     if (!Scene::init()) return false;
-    // ȡĻɼС䲼
+    _services = services;
+    // 获取屏幕可见区域大小，用于适配布局
     Size visibleSize = Director::getInstance()->getVisibleSize();
 
-        // ========== 1.  (ɫ) ==========
-    // Color4B(R, G, B, A) -  (50, 50, 50)
+        // ========== 1. 创建背景 (深灰色) ==========
+    // Color4B(R, G, B, A) - 深灰 (50, 50, 50)
     auto bg = LayerColor::create(Color4B(50, 50, 50, 255));
     this->addChild(bg);
 
-    // ========== 2. ı ==========
-    // ʹϵͳ Arialֺ 60
-    auto label = Label::createWithSystemFont("SELECT LEVEL", "Arial", 60);
+    // ========== 2. 创建标题文本 ==========
+    // 字号 60，优先使用预生成的位图字体
+    auto label = UILabelFactory::createLabel("SELECT LEVEL", 60);
     label->setPosition(Vec2(visibleSize.width / 2, visibleSize.height * 0.7));
     this->addChild(label);
 
-    // ========== 3. "1"ť ==========
-    // ʹ Cocos Դ Button ؼ
-    // create() һհťޱͼʾ
+    // ========== 3. 创建"第1关"按钮 ==========
+    // 这里使用 Cocos 自带的 Button 控件
+    // create() 创建一个空按钮（无背景图），仅显示文字
     auto btnLevel1 = Button::create();
-    btnLevel1->setTitleText("Level 1");
-    btnLevel1->setTitleFontSize(50);
-    btnLevel1->setTitleColor(Color3B::WHITE);
+    // 位图字体的字形本身就是白色，不再调用 setTitleColor（位图字体标签不支持 setTextColor）
+    UILabelFactory::setButtonTitle(btnLevel1, "Level 1", 50);
 
     btnLevel1->setScale(2.0f);
     btnLevel1->setPosition(Vec2(visibleSize.width / 2, visibleSize.height * 0.5));
 
     btnLevel1->addClickEventListener([this](Ref* sender) {
-        this->onLevelSelected(1); // Ӳ룺ѡؿ ID = 1
+        this->onLevelSelected(1); // 硬编码：选择关卡 ID = 1
         });
 
     this->addChild(btnLevel1);
 
+    // ========== 4. 创建"继续"按钮（仅在存在存档时显示） ==========
+    if (GameController::hasSavedGame()) {
+        auto btnResume = Button::create();
+        UILabelFactory::setButtonTitle(btnResume, "Resume", 50);
+
+        btnResume->setScale(2.0f);
+        btnResume->setPosition(Vec2(visibleSize.width / 2, visibleSize.height * 0.35));
+
+        btnResume->addClickEventListener([this](Ref* sender) {
+            CCLOG("UI: User selected Resume");
+            // 存档损坏或与关卡不对应时不切换场景，留在本界面
+            GameController::resumeGame(_services);
+            });
+
+        this->addChild(btnResume);
+    }
+
     return true;
 }
 
 /**
- * @brief ؿѡ¼
- * @param levelId ûѡĹؿID
+ * @brief 处理关卡选择事件
+ * @param levelId 用户选择的关卡ID
  * 
  * @details 
- * 1. ӡ־
- * 2. ί GameController Ϸ
- * 3. GameController::startGame Ḻ𴴽³л
+ * 1. 打印日志，方便调试
+ * 2. 委托 GameController 启动游戏流程
+ * 3. GameController::startGame 会负责创建新场景并切换，本场景将被销毁
  */
 void LevelSelectView::onLevelSelected(int levelId) {
     CCLOG("UI: User selected Level %d", levelId);
-    //  GameController ľ̬Ϸ
-    // GameController Զ level_1.json л
-    GameController::startGame(levelId);
+    // 调用 GameController 的静态工厂方法启动游戏
+    // GameController 会自动加载 level_1.json 并切换场景
+    GameController::startGame(_services, levelId);
 }
\ No newline at end of file
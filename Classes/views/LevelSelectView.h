@@ -2,18 +2,23 @@
 #define LEVEL_SELECT_VIEW_H
 
 #include "cocos2d.h"
+#include <memory>
 
+struct GameServices;
 
 class LevelSelectView : public cocos2d::Scene {
 public:
 
-    CREATE_FUNC(LevelSelectView);
+    // services：跨关卡共享的服务，选择关卡 / 继续时交给 GameController
+    static LevelSelectView* create(const std::shared_ptr<GameServices>& services);
 
-    virtual bool init();
+    bool init(const std::shared_ptr<GameServices>& services);
 
 private:
 
     void onLevelSelected(int levelId);
+
+    std::shared_ptr<GameServices> _services;
 };
 
-#endif // LEVEL_SELECT_VIEW_H
\ No newline at end of file
+#endif // LEVEL_SELECT_VIEW_H
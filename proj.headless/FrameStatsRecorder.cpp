@@ -0,0 +1,83 @@
+#include "FrameStatsRecorder.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace cocos2d;
+
+FrameStatsRecorder::FrameStatsRecorder()
+    : _afterDrawListener(nullptr)
+    , _inPhase(false)
+{
+    auto director = Director::getInstance();
+    _afterDrawListener = director->getEventDispatcher()->addCustomEventListener(
+        Director::EVENT_AFTER_DRAW, [this](EventCustom*) { onAfterDraw(); });
+}
+
+FrameStatsRecorder::~FrameStatsRecorder() {
+    if (_afterDrawListener) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterDrawListener);
+    }
+}
+
+void FrameStatsRecorder::beginPhase(const std::string& name) {
+    if (_inPhase) endPhase();
+    _current = PhaseStats();
+    _current.name = name;
+    _inPhase = true;
+}
+
+void FrameStatsRecorder::endPhase() {
+    if (!_inPhase) return;
+    _phases.push_back(_current);
+    _inPhase = false;
+}
+
+void FrameStatsRecorder::runFrames(int count) {
+    auto director = Director::getInstance();
+    for (int i = 0; i < count; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        director->mainLoop();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (_inPhase) {
+            _current.frames++;
+            _current.totalMs += ms;
+            _current.maxMs = std::max(_current.maxMs, ms);
+        }
+    }
+}
+
+int FrameStatsRecorder::runUntilIdle(int maxFrames) {
+    auto actionManager = Director::getInstance()->getActionManager();
+    int frames = 0;
+    while (frames < maxFrames) {
+        runFrames(1);
+        frames++;
+        if (actionManager->getNumberOfRunningActions() == 0) break;
+    }
+    return frames;
+}
+
+std::string FrameStatsRecorder::toJson() const {
+    std::string json;
+    for (const auto& phase : _phases) {
+        double avgMs = phase.frames > 0 ? phase.totalMs / phase.frames : 0.0;
+        double avgBatches = phase.frames > 0 ? (double)phase.batches / phase.frames : 0.0;
+        double avgVertices = phase.frames > 0 ? (double)phase.vertices / phase.frames : 0.0;
+        json += StringUtils::format(
+            "{\"phase\":\"%s\",\"frames\":%d,\"avg_frame_ms\":%.4f,\"max_frame_ms\":%.4f,"
+            "\"draw_batches\":%llu,\"vertices\":%llu,\"avg_batches_per_frame\":%.2f,\"avg_vertices_per_frame\":%.2f}\n",
+            phase.name.c_str(), phase.frames, avgMs, phase.maxMs,
+            (unsigned long long)phase.batches, (unsigned long long)phase.vertices, avgBatches, avgVertices);
+    }
+    return json;
+}
+
+void FrameStatsRecorder::onAfterDraw() {
+    auto renderer = Director::getInstance()->getRenderer();
+    if (_inPhase) {
+        _current.batches += renderer->getDrawnBatches();
+        _current.vertices += renderer->getDrawnVertices();
+    }
+    renderer->clearDrawStats();
+}
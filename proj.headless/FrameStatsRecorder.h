@@ -0,0 +1,58 @@
+/**
+ * @file FrameStatsRecorder.h
+ * @brief 帧统计 - 驱动 Director 主循环并记录每帧耗时、绘制批次与顶点数
+ *
+ * @details
+ * - 每次 runFrames 都调用完整的 Director::mainLoop()：
+ *   调度器更新（Action）-> 场景遍历 -> 渲染命令提交 -> 自动释放池清理
+ * - 绘制批次与顶点数取自 Renderer 的统计（与 Display Stats 同源），每帧读取后清零
+ * - 结果按阶段（idle / taps 等）汇总，输出为一行一个对象的 JSON，方便 CI 做回归对比
+ */
+#ifndef FRAME_STATS_RECORDER_H
+#define FRAME_STATS_RECORDER_H
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FrameStatsRecorder {
+public:
+    FrameStatsRecorder();
+    ~FrameStatsRecorder();
+
+    // 开始一个新的统计阶段（会结束上一个未结束的阶段）
+    void beginPhase(const std::string& name);
+
+    // 结束当前阶段并保存结果
+    void endPhase();
+
+    // 驱动主循环 count 帧
+    void runFrames(int count);
+
+    // 驱动主循环直到没有正在运行的 Action，最多 maxFrames 帧；返回实际运行的帧数
+    int runUntilIdle(int maxFrames);
+
+    // 所有已结束阶段的统计（JSON Lines）
+    std::string toJson() const;
+
+private:
+    struct PhaseStats {
+        std::string name;
+        int frames = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        uint64_t batches = 0;
+        uint64_t vertices = 0;
+    };
+
+    // EVENT_AFTER_DRAW 回调：累加本帧的绘制统计
+    void onAfterDraw();
+
+    cocos2d::EventListenerCustom* _afterDrawListener;
+    PhaseStats _current;
+    bool _inPhase;
+    std::vector<PhaseStats> _phases;
+};
+
+#endif // FRAME_STATS_RECORDER_H
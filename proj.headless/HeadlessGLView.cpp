@@ -0,0 +1,94 @@
+#include "HeadlessGLView.h"
+
+using namespace cocos2d;
+
+HeadlessGLView* HeadlessGLView::create(const std::string& viewName, const Size& frameSize) {
+    HeadlessGLView* ret = new (std::nothrow) HeadlessGLView();
+    if (ret && ret->init(viewName, frameSize)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+HeadlessGLView::HeadlessGLView()
+    : _display(EGL_NO_DISPLAY)
+    , _surface(EGL_NO_SURFACE)
+    , _context(EGL_NO_CONTEXT)
+    , _shouldClose(false)
+{
+}
+
+HeadlessGLView::~HeadlessGLView() {
+    if (_display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (_context != EGL_NO_CONTEXT) eglDestroyContext(_display, _context);
+        if (_surface != EGL_NO_SURFACE) eglDestroySurface(_display, _surface);
+        eglTerminate(_display);
+    }
+}
+
+bool HeadlessGLView::init(const std::string& viewName, const Size& frameSize) {
+    setViewName(viewName);
+    if (!initContext()) return false;
+
+    // 与真实设备一致：先设置帧尺寸，设计分辨率由 AppDelegate 设置
+    setFrameSize(frameSize.width, frameSize.height);
+    return true;
+}
+
+bool HeadlessGLView::initContext() {
+    _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (_display == EGL_NO_DISPLAY || !eglInitialize(_display, nullptr, nullptr)) {
+        CCLOG("HeadlessGLView: eglInitialize failed");
+        return false;
+    }
+
+    // 与 AppDelegate::initGLContextAttrs 保持一致：RGBA8888 + D24S8
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(_display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        CCLOG("HeadlessGLView: no pbuffer config available");
+        return false;
+    }
+
+    // 1x1 的离屏表面：画面永远不会被呈现，所有片元都被裁剪掉
+    const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    _surface = eglCreatePbufferSurface(_display, config, pbufferAttribs);
+    if (_surface == EGL_NO_SURFACE) {
+        CCLOG("HeadlessGLView: eglCreatePbufferSurface failed");
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    _context = eglCreateContext(_display, config, EGL_NO_CONTEXT, nullptr);
+    if (_context == EGL_NO_CONTEXT || !eglMakeCurrent(_display, _surface, _surface, _context)) {
+        CCLOG("HeadlessGLView: eglCreateContext failed");
+        return false;
+    }
+
+    // GLEW 在没有 X Display 时会返回 GLX 相关错误，但 GL 函数指针已经加载完成
+    glewExperimental = GL_TRUE;
+    GLenum glewError = glewInit();
+    if (glewError != GLEW_OK) {
+        CCLOG("HeadlessGLView: glewInit reported %s", (const char*)glewGetErrorString(glewError));
+    }
+    if (!glGenBuffers) {
+        CCLOG("HeadlessGLView: GL entry points not available");
+        return false;
+    }
+    return true;
+}
+
+void HeadlessGLView::end() {
+    _shouldClose = true;
+    release();
+}
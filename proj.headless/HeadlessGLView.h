@@ -0,0 +1,54 @@
+/**
+ * @file HeadlessGLView.h
+ * @brief 无窗口 GLView - 用于在无显卡的 Linux CI 上跑视图层基准测试
+ *
+ * @details
+ * - 不创建窗口，不处理系统事件，swapBuffers 为空操作
+ * - Cocos2d-x 3.17 在创建 Sprite / Texture2D / GLProgram 时就会调用 GL 接口，
+ *   因此仍需要一个 GL 上下文：这里用 EGL 创建 1x1 的 pbuffer 上下文，
+ *   在没有 GPU 的机器上由 Mesa 软件实现（llvmpipe）提供
+ * - 所有绘制都被裁剪到 1 个像素，光栅化开销可以忽略，测到的是场景遍历、
+ *   Action 更新与渲染命令提交的开销
+ */
+#ifndef HEADLESS_GL_VIEW_H
+#define HEADLESS_GL_VIEW_H
+
+#include "cocos2d.h"
+#include <EGL/egl.h>
+#include <string>
+
+class HeadlessGLView : public cocos2d::GLView {
+public:
+    /**
+     * @brief 创建无窗口 GLView
+     * @param viewName 视图名称（仅用于日志）
+     * @param frameSize 模拟的设备帧尺寸（像素），决定设计分辨率的缩放
+     * @return 自动释放的实例，EGL 初始化失败时返回 nullptr
+     */
+    static HeadlessGLView* create(const std::string& viewName, const cocos2d::Size& frameSize);
+
+    // ========== GLView 接口 ==========
+    virtual bool isOpenGLReady() override { return _context != EGL_NO_CONTEXT; }
+    virtual void end() override;
+    virtual void swapBuffers() override {}
+    virtual void setIMEKeyboardState(bool open) override {}
+    virtual bool windowShouldClose() override { return _shouldClose; }
+    virtual void pollEvents() override {}
+
+protected:
+    HeadlessGLView();
+    virtual ~HeadlessGLView();
+
+    bool init(const std::string& viewName, const cocos2d::Size& frameSize);
+
+private:
+    // 创建 1x1 pbuffer 上下文并加载 GL 函数指针
+    bool initContext();
+
+    EGLDisplay _display;
+    EGLSurface _surface;
+    EGLContext _context;
+    bool _shouldClose;
+};
+
+#endif // HEADLESS_GL_VIEW_H
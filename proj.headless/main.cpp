@@ -0,0 +1,243 @@
+/**
+ * @file main.cpp
+ * @brief 无窗口视图层基准测试入口
+ *
+ * @details 流程：
+ * 1. 创建 HeadlessGLView 并交给 Director，随后走正常的 AppDelegate 启动流程
+ * 2. 启动指定关卡，等待分帧构建结束、场景切换完成
+ * 3. idle 阶段：空跑若干帧，测量纯场景遍历与提交开销
+ * 4. taps 阶段：依次向每张卡牌注入触摸事件（与真实输入走同一条 GLView -> EventDispatcher 路径），
+ *    每次点击后跑到动画结束，测量"点击 -> 动画"整条链路
+ * 5. 以 JSON Lines 输出各阶段统计（stdout 或 --out 指定的文件）
+ *
+ * 回放模式（--replay）：加载回放中的关卡，尽快（或 --realtime 1 时按录制的时间戳）执行全部操作，
+ * 每一步校验状态哈希，输出 replay 阶段统计；校验失败时进程返回 2
+ *
+ * 服务端权威模式（--loopback N）：基准测试期间启用本地回环服务端，单程延迟 N 帧，
+ * 点击在本地预测执行，由回环服务端确认；预测与回滚统计在关卡退出时输出到日志
+ *
+ * 分配统计（CARDGAME_ALLOC_TRACKING 构建）：额外输出 allocs 一行，包含关卡加载和平均每次点击的分配次数 / 字节数；
+ * --alloc-budget-load / --alloc-budget-tap 给出分配次数上限，超出时进程返回 3
+ *
+ * 用法：CardGameHeadless [--level 1] [--frames 600] [--taps 20] [--loopback 3] [--out stats.json]
+ *                        [--alloc-budget-load 5000] [--alloc-budget-tap 200]
+ *       CardGameHeadless --replay replays/level_1.cgr [--realtime 1] [--out stats.json]
+ */
+#include "../Classes/AppDelegate.h"
+#include "controllers/GameController.h"
+#include "controllers/GameServices.h"
+#include "managers/LoopbackServer.h"
+#include "models/ReplayModel.h"
+#include "services/ReplayCodec.h"
+#include "utils/AllocTracker.h"
+#include "views/CardView.h"
+#include "views/GameView.h"
+#include "HeadlessGLView.h"
+#include "FrameStatsRecorder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+USING_NS_CC;
+
+namespace {
+    struct Options {
+        int levelId = 1;
+        int idleFrames = 600;
+        int taps = 20;
+        std::string outPath;
+        std::string replayPath;
+        bool realtime = false;
+        int loopbackLatency = -1;   // 小于 0 表示不启用回环服务端
+        AllocBudget loadAllocBudget;    // 关卡加载阶段的分配预算
+        AllocBudget tapAllocBudget;     // 平均每次点击的分配预算
+    };
+
+    // 基准测试各阶段的分配（两次快照之差）
+    struct AllocResults {
+        AllocCounters levelLoad;
+        AllocCounters taps;
+        int tapCount = 0;
+    };
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--level") == 0) options.levelId = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--frames") == 0) options.idleFrames = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--taps") == 0) options.taps = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--out") == 0) options.outPath = argv[i + 1];
+            else if (strcmp(argv[i], "--replay") == 0) options.replayPath = argv[i + 1];
+            else if (strcmp(argv[i], "--realtime") == 0) options.realtime = atoi(argv[i + 1]) != 0;
+            else if (strcmp(argv[i], "--loopback") == 0) options.loopbackLatency = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--alloc-budget-load") == 0) options.loadAllocBudget.maxCount = strtoull(argv[i + 1], nullptr, 10);
+            else if (strcmp(argv[i], "--alloc-budget-tap") == 0) options.tapAllocBudget.maxCount = strtoull(argv[i + 1], nullptr, 10);
+        }
+        return options;
+    }
+
+    // 在当前运行的场景中找到所有卡牌视图
+    std::vector<CardView*> findCardViews() {
+        std::vector<CardView*> cardViews;
+        auto scene = Director::getInstance()->getRunningScene();
+        if (!scene) return cardViews;
+        for (auto child : scene->getChildren()) {
+            auto gameView = dynamic_cast<GameView*>(child);
+            if (!gameView) continue;
+            for (auto node : gameView->getChildren()) {
+                auto cardView = dynamic_cast<CardView*>(node);
+                if (cardView && cardView->isVisible()) cardViews.push_back(cardView);
+            }
+        }
+        return cardViews;
+    }
+
+    // 驱动主循环直到游戏场景完成分帧构建并切换为当前场景，最多 maxFrames 帧
+    void waitForGameScene(FrameStatsRecorder& recorder, int maxFrames) {
+        for (int i = 0; i < maxFrames && findCardViews().empty(); ++i) {
+            recorder.runFrames(1);
+        }
+    }
+
+    // 向 GLView 注入一次完整的点击（按下 + 抬起），坐标换算为帧像素坐标（左上角为原点）
+    void injectTap(GLView* glview, Node* target) {
+        Vec2 world = target->getParent()->convertToWorldSpace(target->getPosition());
+        Vec2 ui = Director::getInstance()->convertToUI(world);
+        const Rect& viewport = glview->getViewPortRect();
+
+        intptr_t ids[1] = { 0 };
+        float xs[1] = { ui.x * glview->getScaleX() + viewport.origin.x };
+        float ys[1] = { ui.y * glview->getScaleY() + viewport.origin.y };
+        glview->handleTouchesBegin(1, ids, xs, ys);
+        glview->handleTouchesEnd(1, ids, xs, ys);
+    }
+
+    // 关卡加载 -> 空闲帧 -> 点击，三个阶段的基准测试
+    AllocResults runBenchmark(FrameStatsRecorder& recorder, GLView* glview, const std::shared_ptr<GameServices>& services,
+        const Options& options) {
+        AllocResults allocs;
+
+        // ========== 关卡加载 ==========
+        recorder.beginPhase("level_load");
+        AllocCounters start = AllocTracker::snapshot();
+        GameController::startGame(services, options.levelId);
+        waitForGameScene(recorder, 600);
+        recorder.runUntilIdle(120);
+        allocs.levelLoad = AllocTracker::snapshot() - start;
+        recorder.endPhase();
+
+        // ========== 空闲帧 ==========
+        recorder.beginPhase("idle");
+        recorder.runFrames(options.idleFrames);
+        recorder.endPhase();
+
+        // ========== 点击 -> 动画 ==========
+        // 被接受的点击会录制为回放，退出时写入可写目录的 replays/level_<id>.cgr
+        recorder.beginPhase("taps");
+        start = AllocTracker::snapshot();
+        for (int i = 0; i < options.taps; ++i) {
+            auto cardViews = findCardViews();
+            if (cardViews.empty()) break;
+            injectTap(glview, cardViews[i % cardViews.size()]);
+            recorder.runUntilIdle(120);
+            allocs.tapCount++;
+        }
+        allocs.taps = AllocTracker::snapshot() - start;
+        recorder.endPhase();
+        return allocs;
+    }
+
+    // 分配统计输出为一行 JSON（与帧统计同一格式），返回是否在预算内
+    bool reportAllocs(const AllocResults& allocs, const Options& options, std::string& json) {
+        double perTap = allocs.tapCount > 0 ? (double)allocs.taps.totalCount() / allocs.tapCount : 0.0;
+        json += StringUtils::format("{\"phase\":\"allocs\",\"level_load\":%s,\"taps\":%d,\"tap_total\":%s,\"avg_allocs_per_tap\":%.2f}\n",
+            AllocTracker::toJson(allocs.levelLoad).c_str(), allocs.tapCount, AllocTracker::toJson(allocs.taps).c_str(), perTap);
+
+        bool ok = true;
+        if (!AllocTracker::withinBudget(allocs.levelLoad, options.loadAllocBudget)) {
+            fprintf(stderr, "headless: level load allocations over budget: %s\n", AllocTracker::format(allocs.levelLoad).c_str());
+            ok = false;
+        }
+        if (!AllocTracker::withinBudget(allocs.taps, options.tapAllocBudget, (uint64_t)allocs.tapCount)) {
+            fprintf(stderr, "headless: tap allocations over budget (%.2f per tap): %s\n", perTap, AllocTracker::format(allocs.taps).c_str());
+            ok = false;
+        }
+        return ok;
+    }
+
+    // 播放回放直到结束，返回是否通过校验
+    bool runReplay(FrameStatsRecorder& recorder, const std::shared_ptr<GameServices>& services, const Options& options) {
+        Data file = FileUtils::getInstance()->getDataFromFile(options.replayPath);
+        ReplayData replay;
+        if (file.isNull() || !ReplayCodec::decode(file.getBytes(), (size_t)file.getSize(), replay)) {
+            fprintf(stderr, "headless: cannot read replay %s\n", options.replayPath.c_str());
+            return false;
+        }
+        if (!GameController::startReplay(services, replay, options.realtime)) return false;
+
+        recorder.beginPhase("replay");
+        waitForGameScene(recorder, 600);
+        // 实时模式按录制时长推进，另留 10 秒余量
+        int maxFrames = 600 + (replay.moves.empty() ? 0 : (int)(replay.moves.back().timeMs * 60 / 1000));
+        for (int i = 0; i < maxFrames && services->replayState == GameController::ReplayState::PLAYING; ++i) {
+            recorder.runFrames(1);
+        }
+        recorder.runUntilIdle(120);
+        recorder.endPhase();
+        return services->replayState == GameController::ReplayState::PASSED;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options = parseOptions(argc, argv);
+
+    AppDelegate app;
+    auto glview = HeadlessGLView::create("CardGameHeadless", Size(1080, 2080));
+    if (!glview) {
+        fprintf(stderr, "headless: failed to create offscreen GL context\n");
+        return 1;
+    }
+    auto director = Director::getInstance();
+    director->setOpenGLView(glview);
+
+    // AppDelegate 检测到已有 GLView 时不会再创建窗口
+    if (!app.applicationDidFinishLaunching()) return 1;
+
+    FrameStatsRecorder recorder;
+    recorder.runFrames(2);
+
+    int exitCode = 0;
+    AllocResults allocs;
+    const std::shared_ptr<GameServices>& services = app.getServices();
+    if (!options.replayPath.empty()) {
+        exitCode = runReplay(recorder, services, options) ? 0 : 2;
+    }
+    else {
+        if (options.loopbackLatency >= 0) {
+            services->loopbackServer = std::make_shared<LoopbackServer>((uint32_t)options.loopbackLatency);
+        }
+        allocs = runBenchmark(recorder, glview, services, options);
+    }
+
+    std::string json = recorder.toJson();
+    if (AllocTracker::isEnabled() && options.replayPath.empty()) {
+        if (!reportAllocs(allocs, options, json)) exitCode = 3;
+    }
+    else if (options.loadAllocBudget.maxCount > 0 || options.tapAllocBudget.maxCount > 0) {
+        fprintf(stderr, "headless: built without CARDGAME_ALLOC_TRACKING, allocation budgets ignored\n");
+    }
+    if (options.outPath.empty()) {
+        fputs(json.c_str(), stdout);
+    }
+    else {
+        FileUtils::getInstance()->writeStringToFile(json, options.outPath);
+    }
+
+    director->end();
+    director->mainLoop();
+    return exitCode;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file AsyncFileWriterTests.cpp
+ * @brief AsyncFileWriter：通道注册与拒绝规则，多线程写入时 REPLACE 落盘最后一次写入、APPEND 按顺序完整落盘
+ */
+#include "TestHarness.h"
+#include "managers/AsyncFileWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const uint32_t kReplaceWrites = 3000;
+    const uint32_t kAppendRecords = 20000;
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    bool fileExists(const std::string& path) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        return in.good();
+    }
+
+    // 短窗口、不 fsync：压力测试关注的是交接顺序，而不是磁盘
+    AsyncFileWriter::Config fastConfig() {
+        AsyncFileWriter::Config config;
+        config.coalesceWindowMs = 1;
+        config.syncIntervalMs = -1;
+        return config;
+    }
+
+    // 定长记录，文件内容可以逐条校验
+    std::string appendRecord(uint32_t index) {
+        char record[16];
+        snprintf(record, sizeof(record), "rec%08u\n", index);
+        return record;
+    }
+
+    // 写入线程：环形缓冲满时唤醒 IO 线程并重试，直到全部写入
+    void appendAll(AsyncFileWriter& writer, AsyncFileWriter::ChannelId channel, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string record = appendRecord(i);
+            while (!writer.write(channel, record.data(), record.size())) {
+                writer.requestFlush();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // 文件是否恰好为第 0 ~ count-1 条记录依次相接
+    bool isCompleteSequence(const std::string& content, uint32_t count) {
+        std::string expected;
+        expected.reserve((size_t)count * 12);
+        for (uint32_t i = 0; i < count; ++i) expected += appendRecord(i);
+        return content == expected;
+    }
+
+    std::string replacePayload(uint32_t version) {
+        // 长度随版本变化，截断或混入旧内容都会被发现
+        return "version " + std::to_string(version) + " " + std::string(version % 97, (char)('a' + version % 26));
+    }
+}
+
+CORE_TEST(async_file_writer, channel_rules) {
+    std::string path = CoreTest::tempDir() + "writer_rules.bin";
+    std::remove(path.c_str());
+
+    AsyncFileWriter writer(fastConfig());
+    AsyncFileWriter::ChannelId channel = writer.openChannel(path, FileWriteMode::REPLACE, 8);
+    REQUIRE(channel != AsyncFileWriter::INVALID_CHANNEL);
+    CHECK(writer.openChannel(path, FileWriteMode::REPLACE, 8) == channel);
+
+    CHECK(!writer.write(channel, "123456789", 9));
+    CHECK(!writer.write(channel + 1, "x", 1));
+    CHECK(writer.write(channel, "12345678", 8));
+
+    writer.shutdown();
+    CHECK(!writer.write(channel, "x", 1));
+    CHECK(writer.openChannel(path + ".other", FileWriteMode::APPEND, 64) == AsyncFileWriter::INVALID_CHANNEL);
+    CHECK(readFile(path) == "12345678");
+
+    auto stats = writer.getStats();
+    CHECK(stats.writes == 1);
+    CHECK(stats.rejected == 3);
+    CHECK(stats.errors == 0);
+}
+
+CORE_TEST(async_file_writer, stress_replace_keeps_last_write) {
+    std::string path = CoreTest::tempDir() + "writer_replace.bin";
+    std::remove(path.c_str());
+
+    AsyncFileWriter writer(fastConfig());
+    AsyncFileWriter::ChannelId channel = writer.openChannel(path, FileWriteMode::REPLACE, 256);
+    REQUIRE(channel != AsyncFileWriter::INVALID_CHANNEL);
+
+    std::thread producer([&writer, channel]() {
+        for (uint32_t version = 1; version <= kReplaceWrites; ++version) {
+            std::string payload = replacePayload(version);
+            writer.write(channel, payload.data(), payload.size());
+        }
+    });
+    producer.join();
+    writer.shutdown();
+
+    CHECK(readFile(path) == replacePayload(kReplaceWrites));
+    CHECK(!fileExists(path + ".tmp"));
+
+    auto stats = writer.getStats();
+    CHECK(stats.writes == kReplaceWrites);
+    CHECK(stats.fileWrites >= 1);
+    CHECK(stats.fileWrites <= kReplaceWrites);
+    CHECK(stats.errors == 0);
+}
+
+CORE_TEST(async_file_writer, stress_append_channels_in_parallel) {
+    // 两个 APPEND 通道各由一个线程写入，一个 REPLACE 通道由第三个线程写入；环形缓冲很小，频繁回绕和写满
+    std::string pathA = CoreTest::tempDir() + "writer_append_a.log";
+    std::string pathB = CoreTest::tempDir() + "writer_append_b.log";
+    std::string pathState = CoreTest::tempDir() + "writer_append_state.bin";
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+    std::remove(pathState.c_str());
+
+    AsyncFileWriter writer(fastConfig());
+    AsyncFileWriter::ChannelId channelA = writer.openChannel(pathA, FileWriteMode::APPEND, 200);
+    AsyncFileWriter::ChannelId channelB = writer.openChannel(pathB, FileWriteMode::APPEND, 4096);
+    AsyncFileWriter::ChannelId channelState = writer.openChannel(pathState, FileWriteMode::REPLACE, 256);
+    REQUIRE(channelA != AsyncFileWriter::INVALID_CHANNEL);
+    REQUIRE(channelB != AsyncFileWriter::INVALID_CHANNEL);
+    REQUIRE(channelState != AsyncFileWriter::INVALID_CHANNEL);
+
+    std::thread producerA([&writer, channelA]() { appendAll(writer, channelA, kAppendRecords); });
+    std::thread producerB([&writer, channelB]() { appendAll(writer, channelB, kAppendRecords / 2); });
+    std::thread producerState([&writer, channelState]() {
+        for (uint32_t version = 1; version <= kReplaceWrites; ++version) {
+            std::string payload = replacePayload(version);
+            writer.write(channelState, payload.data(), payload.size());
+        }
+    });
+    producerA.join();
+    producerB.join();
+    producerState.join();
+    writer.shutdown();
+
+    CHECK(isCompleteSequence(readFile(pathA), kAppendRecords));
+    CHECK(isCompleteSequence(readFile(pathB), kAppendRecords / 2));
+    CHECK(readFile(pathState) == replacePayload(kReplaceWrites));
+
+    auto stats = writer.getStats();
+    CHECK(stats.writes == kAppendRecords + kAppendRecords / 2 + kReplaceWrites);
+    CHECK(stats.errors == 0);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file GameStatePublisherTests.cpp
+ * @brief GameStatePublisher：读者槽位、版本号，以及并发读取时读到的版本完整且不倒退、旧版本被回收
+ */
+#include "TestHarness.h"
+#include "managers/GameStatePublisher.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    const uint64_t kPublishCount = 20000;
+    const size_t kReaderThreads = 3;
+
+    // 按发布序号填写全部字段：读者据此检查读到的是一个完整的版本，而不是正在被改写的缓冲
+    void fillState(PublishedGameState& state, uint64_t version) {
+        state.stateHash = version * 2654435761u;
+        state.snapshot.levelId = (uint32_t)version;
+        state.snapshot.cards.resize(1 + version % 7);
+        for (auto& card : state.snapshot.cards) card.id = (int32_t)version;
+        state.snapshot.stockCardIds.assign(version % 5, (int32_t)version);
+    }
+
+    bool isConsistent(const PublishedGameState& state) {
+        uint64_t version = state.version;
+        if (state.stateHash != version * 2654435761u) return false;
+        if (state.snapshot.levelId != (uint32_t)version) return false;
+        if (state.snapshot.cards.size() != 1 + version % 7) return false;
+        for (const auto& card : state.snapshot.cards) {
+            if (card.id != (int32_t)version) return false;
+        }
+        if (state.snapshot.stockCardIds.size() != version % 5) return false;
+        for (int32_t id : state.snapshot.stockCardIds) {
+            if (id != (int32_t)version) return false;
+        }
+        return true;
+    }
+}
+
+CORE_TEST(game_state_publisher, empty_until_first_publish) {
+    GameStatePublisher publisher;
+    CHECK(publisher.latestVersion() == 0);
+    {
+        GameStatePublisher::ReadGuard guard(publisher);
+        CHECK(!guard);
+    }
+
+    fillState(publisher.beginPublish(), 1);
+    publisher.commitPublish();
+    CHECK(publisher.latestVersion() == 1);
+
+    GameStatePublisher::ReadGuard guard(publisher);
+    REQUIRE(guard);
+    CHECK(guard->version == 1);
+    CHECK(isConsistent(*guard.get()));
+}
+
+CORE_TEST(game_state_publisher, reader_slots_exhaust_and_release) {
+    GameStatePublisher publisher;
+    fillState(publisher.beginPublish(), 1);
+    publisher.commitPublish();
+
+    std::vector<std::unique_ptr<GameStatePublisher::ReadGuard>> guards;
+    for (size_t i = 0; i < GameStatePublisher::MAX_READERS; ++i) {
+        guards.push_back(std::unique_ptr<GameStatePublisher::ReadGuard>(new GameStatePublisher::ReadGuard(publisher)));
+        CHECK(*guards.back());
+    }
+    {
+        GameStatePublisher::ReadGuard overflow(publisher);
+        CHECK(!overflow);
+    }
+    guards.pop_back();
+    GameStatePublisher::ReadGuard reused(publisher);
+    CHECK(reused);
+}
+
+CORE_TEST(game_state_publisher, held_guard_keeps_old_version) {
+    GameStatePublisher publisher;
+    fillState(publisher.beginPublish(), 1);
+    publisher.commitPublish();
+
+    GameStatePublisher::ReadGuard old(publisher);
+    REQUIRE(old);
+    for (uint64_t version = 2; version <= 10; ++version) {
+        fillState(publisher.beginPublish(), version);
+        publisher.commitPublish();
+    }
+    // 持有期间旧版本不能被回收或复用
+    CHECK(old->version == 1);
+    CHECK(isConsistent(*old.get()));
+
+    GameStatePublisher::ReadGuard latest(publisher);
+    REQUIRE(latest);
+    CHECK(latest->version == 10);
+}
+
+CORE_TEST(game_state_publisher, stress_concurrent_readers) {
+    GameStatePublisher publisher;
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> inconsistent(0);
+    std::atomic<uint64_t> wentBackwards(0);
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < kReaderThreads; ++r) {
+        readers.push_back(std::thread([&]() {
+            uint64_t lastVersion = 0;
+            while (!done.load()) {
+                GameStatePublisher::ReadGuard guard(publisher);
+                if (!guard) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (!isConsistent(*guard.get())) inconsistent++;
+                if (guard->version < lastVersion) wentBackwards++;
+                lastVersion = guard->version;
+                reads++;
+            }
+        }));
+    }
+
+    for (uint64_t version = 1; version <= kPublishCount; ++version) {
+        fillState(publisher.beginPublish(), version);
+        publisher.commitPublish();
+        if (version % 64 == 0) std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& reader : readers) reader.join();
+
+    CHECK(inconsistent.load() == 0);
+    CHECK(wentBackwards.load() == 0);
+    CHECK(publisher.latestVersion() == kPublishCount);
+
+    // 读者全部离开后再发布一次：除当前版本外的所有旧版本都已回收
+    fillState(publisher.beginPublish(), kPublishCount + 1);
+    publisher.commitPublish();
+    const auto& stats = publisher.getStats();
+    CHECK(stats.published == kPublishCount + 1);
+    CHECK(stats.reclaimed == stats.published - 1);
+    CHECK(stats.buffers <= stats.maxRetired + 2);
+
+    // 没有读者时只在已有缓冲之间复用，不再分配
+    size_t buffers = stats.buffers;
+    for (uint64_t version = kPublishCount + 2; version < kPublishCount + 100; ++version) {
+        fillState(publisher.beginPublish(), version);
+        publisher.commitPublish();
+    }
+    CHECK(publisher.getStats().buffers == buffers);
+}
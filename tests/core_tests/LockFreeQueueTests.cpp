@@ -0,0 +1,166 @@
+/**
+ * @file LockFreeQueueTests.cpp
+ * @brief SpscQueue / MpscQueue：容量、满 / 空边界，以及多线程压力下的顺序与完整性
+ */
+#include "TestHarness.h"
+#include "utils/MpscQueue.h"
+#include "utils/SpscQueue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+    // 多字段记录：字段之间互相校验，读到写了一半的槽位时能发现
+    struct Record {
+        uint64_t sequence;
+        uint64_t tripled;
+        uint64_t inverted;
+        uint32_t producer;
+    };
+
+    Record makeRecord(uint32_t producer, uint64_t sequence) {
+        Record record;
+        record.sequence = sequence;
+        record.tripled = sequence * 3 + 1;
+        record.inverted = ~sequence;
+        record.producer = producer;
+        return record;
+    }
+
+    bool isIntact(const Record& record) {
+        return record.tripled == record.sequence * 3 + 1 && record.inverted == ~record.sequence;
+    }
+
+    const uint64_t kSpscItems = 500000;
+    const uint32_t kMpscProducers = 4;
+    const uint64_t kMpscItemsPerProducer = 100000;
+}
+
+// ========== SpscQueue ==========
+
+CORE_TEST(spsc_queue, capacity_and_bounds) {
+    SpscQueue<int> queue(5);
+    CHECK(queue.capacity() == 8);
+
+    int value = 0;
+    CHECK(!queue.tryPop(value));
+    for (int i = 0; i < 8; ++i) CHECK(queue.tryPush(i));
+    CHECK(!queue.tryPush(8));
+    CHECK(queue.sizeApprox() == 8);
+
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.tryPop(value));
+        CHECK(value == i);
+    }
+    CHECK(!queue.tryPop(value));
+}
+
+CORE_TEST(spsc_queue, drain_respects_max_count) {
+    SpscQueue<int> queue(16);
+    for (int i = 0; i < 10; ++i) queue.tryPush(i);
+
+    std::vector<int> seen;
+    CHECK(queue.drain([&seen](const int& v) { seen.push_back(v); }, 4) == 4);
+    CHECK(queue.drain([&seen](const int& v) { seen.push_back(v); }) == 6);
+    REQUIRE(seen.size() == 10);
+    for (int i = 0; i < 10; ++i) CHECK(seen[i] == i);
+}
+
+CORE_TEST(spsc_queue, stress_preserves_order) {
+    // 小容量让生产者频繁遇到“满”，消费者交替使用 tryPop 和 drain
+    SpscQueue<Record> queue(64);
+    std::thread producer([&queue]() {
+        for (uint64_t i = 0; i < kSpscItems; ++i) {
+            Record record = makeRecord(0, i);
+            while (!queue.tryPush(record)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t torn = 0;
+    auto consume = [&](const Record& record) {
+        if (record.sequence != expected) outOfOrder++;
+        if (!isIntact(record)) torn++;
+        expected = record.sequence + 1;
+    };
+    while (expected < kSpscItems) {
+        Record record;
+        if (expected % 2 == 0 && queue.tryPop(record)) consume(record);
+        else if (queue.drain(consume, 17) == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    CHECK(outOfOrder == 0);
+    CHECK(torn == 0);
+    CHECK(expected == kSpscItems);
+    CHECK(queue.sizeApprox() == 0);
+}
+
+// ========== MpscQueue ==========
+
+CORE_TEST(mpsc_queue, capacity_and_bounds) {
+    MpscQueue<int> queue(3);
+    CHECK(queue.capacity() == 4);
+
+    int value = 0;
+    CHECK(!queue.tryPop(value));
+    for (int i = 0; i < 4; ++i) CHECK(queue.tryPush(i));
+    CHECK(!queue.tryPush(4));
+
+    // 环绕之后槽位可以重复使用
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            CHECK(queue.tryPop(value));
+            CHECK(value == round * 4 + i);
+        }
+        for (int i = 0; i < 4; ++i) CHECK(queue.tryPush((round + 1) * 4 + i));
+    }
+}
+
+CORE_TEST(mpsc_queue, stress_per_producer_order) {
+    MpscQueue<Record> queue(128);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kMpscProducers; ++p) {
+        producers.push_back(std::thread([&queue, &go, p]() {
+            while (!go.load()) std::this_thread::yield();
+            for (uint64_t i = 0; i < kMpscItemsPerProducer; ++i) {
+                Record record = makeRecord(p, i);
+                while (!queue.tryPush(record)) std::this_thread::yield();
+            }
+        }));
+    }
+    go.store(true);
+
+    // 同一生产者的记录必须按入队顺序出队；不同生产者之间的顺序不做要求
+    std::vector<uint64_t> next(kMpscProducers, 0);
+    uint64_t received = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t torn = 0;
+    uint64_t badProducer = 0;
+    const uint64_t total = kMpscProducers * kMpscItemsPerProducer;
+    while (received < total) {
+        size_t drained = queue.drain([&](const Record& record) {
+            received++;
+            if (!isIntact(record)) torn++;
+            if (record.producer >= kMpscProducers) {
+                badProducer++;
+                return;
+            }
+            if (record.sequence != next[record.producer]) outOfOrder++;
+            next[record.producer] = record.sequence + 1;
+        });
+        if (drained == 0) std::this_thread::yield();
+    }
+    for (auto& producer : producers) producer.join();
+
+    Record extra;
+    CHECK(!queue.tryPop(extra));
+    CHECK(torn == 0);
+    CHECK(badProducer == 0);
+    CHECK(outOfOrder == 0);
+    for (uint32_t p = 0; p < kMpscProducers; ++p) CHECK(next[p] == kMpscItemsPerProducer);
+}
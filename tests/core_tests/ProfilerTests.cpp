@@ -0,0 +1,119 @@
+/**
+ * @file ProfilerTests.cpp
+ * @brief Profiler：环形缓冲回绕后保留最近的记录，写入线程与导出线程并发时导出的记录字段完整、顺序正确
+ *
+ * @note 直接调用 Profiler::record，不依赖 CARDGAME_PROFILER（该开关只控制 PROFILE_ZONE 宏）
+ */
+#include "TestHarness.h"
+#include "utils/Profiler.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const size_t kWriters = 2;
+    const uint64_t kZonesPerWriter = Profiler::ZONES_PER_THREAD * 3;
+    const char* const kZoneNames[4] = { "test_zone_0", "test_zone_1", "test_zone_2", "test_zone_3" };
+
+    // 第 i 条记录：名字、开始时间和时长都由 i 决定，导出后可以互相校验（字段来自不同记录时会被发现）
+    uint64_t zoneStart(size_t writer, uint64_t i) {
+        return (uint64_t)(writer + 1) * 100000000000ull + i * 1000;
+    }
+
+    uint64_t zoneDuration(uint64_t i) {
+        return (i % 4) * 10 + 1;
+    }
+
+    void writeZones(size_t writer) {
+        Profiler::setThreadName("profiler test writer");
+        for (uint64_t i = 0; i < kZonesPerWriter; ++i) {
+            uint64_t start = zoneStart(writer, i);
+            Profiler::record(kZoneNames[i % 4], start, start + zoneDuration(i));
+        }
+    }
+
+    struct TraceCheck {
+        std::map<unsigned, uint64_t> zonesPerThread;    // 每个写入线程导出的记录数
+        uint64_t corrupt = 0;                           // 字段互相矛盾的记录数
+        uint64_t outOfOrder = 0;                        // 同一线程内开始时间没有递增的记录数
+        uint64_t oldest = UINT64_MAX;                   // 导出记录中最小的序号 i
+        bool wellFormed = false;
+    };
+
+    // 逐行解析 buildChromeTrace 的输出，只检查测试写入的记录
+    TraceCheck checkTrace(const std::string& trace) {
+        TraceCheck check;
+        const std::string head = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        const std::string tail = "\n]}\n";
+        check.wellFormed = trace.size() >= head.size() + tail.size()
+            && trace.compare(0, head.size(), head) == 0
+            && trace.compare(trace.size() - tail.size(), tail.size(), tail) == 0;
+
+        std::map<unsigned, uint64_t> lastStart;
+        std::istringstream lines(trace);
+        std::string line;
+        while (std::getline(lines, line)) {
+            int tag = -1;
+            int pid = 0;
+            unsigned tid = 0;
+            double ts = 0.0;
+            double dur = 0.0;
+            const char* text = line.c_str();
+            if (*text == ',') ++text;
+            if (sscanf(text, "{\"name\":\"test_zone_%d\",\"cat\":\"cardgame\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%lf,\"dur\":%lf}",
+                &tag, &pid, &tid, &ts, &dur) != 5) continue;
+
+            uint64_t start = (uint64_t)std::llround(ts * 1000.0);
+            uint64_t duration = (uint64_t)std::llround(dur * 1000.0);
+            uint64_t i = (start % 100000000000ull) / 1000;
+            if ((uint64_t)tag != i % 4 || duration != zoneDuration(i)) check.corrupt++;
+            if (lastStart.count(tid) && start <= lastStart[tid]) check.outOfOrder++;
+            lastStart[tid] = start;
+            if (i < check.oldest) check.oldest = i;
+            check.zonesPerThread[tid]++;
+        }
+        return check;
+    }
+}
+
+CORE_TEST(profiler, stress_export_while_recording) {
+    std::atomic<bool> writing(true);
+    std::vector<std::thread> writers;
+    for (size_t w = 0; w < kWriters; ++w) writers.push_back(std::thread(writeZones, w));
+
+    // 写入期间反复导出：每次导出的记录都必须完整、按时间递增，且每个线程不超过缓冲容量
+    uint64_t exports = 0;
+    uint64_t badExports = 0;
+    std::thread exporter([&writing, &exports, &badExports]() {
+        do {
+            TraceCheck check = checkTrace(Profiler::buildChromeTrace(0.0));
+            bool ok = check.wellFormed && check.corrupt == 0 && check.outOfOrder == 0;
+            for (const auto& entry : check.zonesPerThread) ok = ok && entry.second <= Profiler::ZONES_PER_THREAD;
+            exports++;
+            if (!ok) badExports++;
+        } while (writing.load());
+    });
+    for (auto& writer : writers) writer.join();
+    writing.store(false);
+    exporter.join();
+    CHECK(exports > 0);
+    CHECK(badExports == 0);
+
+    // 写完后导出：每个写入线程恰好保留最近 ZONES_PER_THREAD 条
+    std::string trace = Profiler::buildChromeTrace(0.0);
+    TraceCheck check = checkTrace(trace);
+    CHECK(check.wellFormed);
+    CHECK(check.corrupt == 0);
+    CHECK(check.outOfOrder == 0);
+    CHECK(check.zonesPerThread.size() == kWriters);
+    for (const auto& entry : check.zonesPerThread) CHECK(entry.second == Profiler::ZONES_PER_THREAD);
+    CHECK(check.oldest == kZonesPerWriter - Profiler::ZONES_PER_THREAD);
+    CHECK(trace.find("\"args\":{\"name\":\"profiler test writer\"}") != std::string::npos);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file ReplayCodecTests.cpp
+ * @brief ReplayCodec 编解码往返与损坏数据的拒绝，GameStateHasher 的确定性
+ */
+#include "TestHarness.h"
+#include "ReplayFixture.h"
+#include "services/ReplayCodec.h"
+#include "utils/BinaryIO.h"
+
+#include <vector>
+
+namespace {
+    ReplayData makeReplay() {
+        ReplayData replay;
+        replay.levelId = 300000;
+        replay.seed = 0xDEADBEEFu;
+        replay.ruleSet = 3;
+        replay.initialHash = 0x0123456789ABCDEFull;
+        replay.moves.push_back(ReplayMove(InputCommandType::PLAYFIELD_TAP, 0, 0, 0xFFFFFFFFu));
+        replay.moves.push_back(ReplayMove(InputCommandType::STACK_TAP, 4000, 120, 1));
+        replay.moves.push_back(ReplayMove(InputCommandType::UNDO, -1, 120, 0x80000000u));
+        replay.moves.push_back(ReplayMove(InputCommandType::PLAYFIELD_TAP, -70000, 3600000, 42));
+        replay.finalHash = 0xFEDCBA9876543210ull;
+        return replay;
+    }
+
+    bool sameReplay(const ReplayData& a, const ReplayData& b) {
+        if (a.levelId != b.levelId || a.seed != b.seed || a.ruleSet != b.ruleSet
+            || a.initialHash != b.initialHash || a.finalHash != b.finalHash || a.moves.size() != b.moves.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.moves.size(); ++i) {
+            const ReplayMove& x = a.moves[i];
+            const ReplayMove& y = b.moves[i];
+            if (x.type != y.type || x.cardId != y.cardId || x.timeMs != y.timeMs || x.stateHash != y.stateHash) return false;
+        }
+        return true;
+    }
+
+    // 只有头部和操作计数的数据：用来构造计数与实际长度不符的输入
+    std::vector<uint8_t> headerWithCount(uint64_t count) {
+        std::vector<uint8_t> bytes;
+        BinaryWriter writer(bytes);
+        writer.writeBytes("CGRP", 4);
+        writer.writeU8(ReplayCodec::FORMAT_VERSION);
+        writer.writeVarint(1);
+        writer.writeVarint(0);
+        writer.writeVarint(1);
+        writer.writeFixed(0, 8);
+        writer.writeVarint(count);
+        return bytes;
+    }
+}
+
+// ========== ReplayCodec ==========
+
+CORE_TEST(replay_codec, round_trip) {
+    ReplayData replay = makeReplay();
+
+    // 结果追加到已有内容之后
+    std::vector<uint8_t> bytes(3, 0xAB);
+    ReplayCodec::encode(replay, bytes);
+    CHECK(bytes[0] == 0xAB && bytes[2] == 0xAB);
+
+    // 解码到一个已有内容的 ReplayData：旧的操作被清掉
+    ReplayData decoded;
+    decoded.moves.push_back(ReplayMove());
+    REQUIRE(ReplayCodec::decode(bytes.data() + 3, bytes.size() - 3, decoded));
+    CHECK(sameReplay(decoded, replay));
+
+    ReplayData empty;
+    std::vector<uint8_t> emptyBytes;
+    ReplayCodec::encode(empty, emptyBytes);
+    CHECK(ReplayCodec::decode(emptyBytes.data(), emptyBytes.size(), decoded));
+    CHECK(sameReplay(decoded, empty));
+}
+
+CORE_TEST(replay_codec, rejects_truncated_and_trailing_bytes) {
+    std::vector<uint8_t> bytes;
+    ReplayCodec::encode(makeReplay(), bytes);
+
+    // 任何长度的前缀都不是完整的回放
+    ReplayData decoded;
+    size_t accepted = 0;
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        if (ReplayCodec::decode(bytes.data(), size, decoded)) accepted++;
+    }
+    CHECK(accepted == 0);
+
+    bytes.push_back(0);
+    CHECK(!ReplayCodec::decode(bytes.data(), bytes.size(), decoded));
+}
+
+CORE_TEST(replay_codec, rejects_bad_header_and_move_type) {
+    std::vector<uint8_t> bytes;
+    ReplayCodec::encode(makeReplay(), bytes);
+    ReplayData decoded;
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[3] = 'X';
+    CHECK(!ReplayCodec::decode(badMagic.data(), badMagic.size(), decoded));
+
+    std::vector<uint8_t> badVersion = bytes;
+    badVersion[4] = (uint8_t)(ReplayCodec::FORMAT_VERSION + 1);
+    CHECK(!ReplayCodec::decode(badVersion.data(), badVersion.size(), decoded));
+
+    // 一步操作：类型超出 InputCommandType 的范围
+    std::vector<uint8_t> badType = headerWithCount(1);
+    BinaryWriter writer(badType);
+    writer.writeU8((uint8_t)InputCommandType::UNDO + 1);
+    writer.writeSignedVarint(0);
+    writer.writeVarint(0);
+    writer.writeFixed(0, 4);
+    writer.writeFixed(0, 8);
+    CHECK(!ReplayCodec::decode(badType.data(), badType.size(), decoded));
+}
+
+CORE_TEST(replay_codec, rejects_oversized_count) {
+    ReplayData decoded;
+
+    // 计数超过剩余字节能容纳的步数（每步至少 7 字节）：在预分配之前拒绝
+    std::vector<uint8_t> huge = headerWithCount(0xFFFFFFFFFFull);
+    huge.resize(huge.size() + 64, 0);
+    CHECK(!ReplayCodec::decode(huge.data(), huge.size(), decoded));
+    CHECK(decoded.moves.capacity() < 64);
+
+    // 计数比实际多一步
+    ReplayData replay = makeReplay();
+    std::vector<uint8_t> overCount = headerWithCount(replay.moves.size() + 1);
+    std::vector<uint8_t> tail;
+    replay.levelId = 1;
+    replay.seed = 0;
+    replay.ruleSet = 1;
+    replay.initialHash = 0;
+    ReplayCodec::encode(replay, tail);
+    size_t headerSize = headerWithCount(replay.moves.size()).size();
+    overCount.insert(overCount.end(), tail.begin() + headerSize, tail.end());
+    CHECK(!ReplayCodec::decode(overCount.data(), overCount.size(), decoded));
+
+    // 同样拼接、计数正确时可以解码，说明上面的拒绝来自计数
+    std::vector<uint8_t> exactCount = headerWithCount(replay.moves.size());
+    exactCount.insert(exactCount.end(), tail.begin() + headerSize, tail.end());
+    CHECK(ReplayCodec::decode(exactCount.data(), exactCount.size(), decoded));
+    CHECK(sameReplay(decoded, replay));
+}
+
+// ========== GameStateHasher ==========
+
+CORE_TEST(game_state_hasher, deterministic_across_models) {
+    GameModel first;
+    GameModel second;
+    ReplayFixture::initModel(first);
+    ReplayFixture::initModel(second);
+    CHECK(GameStateHasher::hash(first, 0) == GameStateHasher::hash(second, 0));
+
+    GameModel copy;
+    copy.copyStateFrom(first);
+    CHECK(GameStateHasher::hash(copy, 0) == GameStateHasher::hash(first, 0));
+
+    // 位置不参与哈希
+    first.getCardById(0)->setPosition(Vector2(1.0f, 2.0f));
+    CHECK(GameStateHasher::hash(first, 0) == GameStateHasher::hash(second, 0));
+
+    // 回退历史深度参与哈希
+    CHECK(GameStateHasher::hash(first, 1) != GameStateHasher::hash(first, 0));
+
+    // 固定的 FNV-1a 结果：空模型、无顶部卡牌、无回退历史
+    GameModel empty;
+    CHECK(GameStateHasher::hash(empty, 0) == 0x3230F6BC0C8E41B1ull);
+}
+
+CORE_TEST(game_state_hasher, tracks_moves_and_undo) {
+    GameModel model;
+    ReplayFixture::initModel(model);
+    UndoManager undoManager;
+    uint64_t initial = GameStateHasher::hash(model, 0);
+
+    // 同样的操作序列在两个模型上得到同样的哈希序列，每一步都改变哈希
+    ReplayData first;
+    ReplayData second;
+    REQUIRE(ReplayFixture::record(ReplayFixture::legalMoves(), first));
+    REQUIRE(ReplayFixture::record(ReplayFixture::legalMoves(), second));
+    CHECK(first.initialHash == initial);
+    CHECK(sameReplay(first, second));
+    for (size_t i = 1; i < first.moves.size(); ++i) CHECK(first.moves[i].stateHash != first.moves[i - 1].stateHash);
+
+    // 移动再回退：回到移动前的哈希
+    REQUIRE(MoveService::applyCommand(model, undoManager, InputCommandType::PLAYFIELD_TAP, 0));
+    CHECK(GameStateHasher::hash(model, undoManager.size()) != initial);
+    REQUIRE(MoveService::applyCommand(model, undoManager, InputCommandType::UNDO, -1));
+    CHECK(GameStateHasher::hash(model, undoManager.size()) == initial);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ReplayFixture.h
+ * @brief 回放相关测试共用的小关卡：按客户端的方式初始化，可以逐步走出一局合法的操作
+ *
+ * @details 卡牌ID按配置顺序分配：
+ * - 主牌区：0 = 5，1 = 6，2 = K
+ * - 备用牌组：3 = A，4 = 4（发牌后 4 号成为底牌，3 号留在备用堆）
+ *
+ * 一局合法的操作：点 0（5 接 4）、点 1（6 接 5）、抽 3（A）、点 2（K 接 A，循环相邻）、回退
+ */
+#ifndef CORE_TEST_REPLAY_FIXTURE_H
+#define CORE_TEST_REPLAY_FIXTURE_H
+
+#include "configs/models/LevelConfig.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/ReplayModel.h"
+#include "services/GameLogicService.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameStateHasher.h"
+#include "services/MoveService.h"
+
+#include <vector>
+
+namespace ReplayFixture {
+    const uint32_t kLevelId = 7;
+
+    inline CardConfigData card(CardFaceType face, CardSuitType suit, const Vector2& position) {
+        CardConfigData data;
+        data.face = face;
+        data.suit = suit;
+        data.position = position;
+        return data;
+    }
+
+    inline LevelConfig makeLevelConfig() {
+        LevelConfig config;
+        config.playFieldCards.push_back(card(CardFaceType::CFT_FIVE, CardSuitType::CST_CLUBS, Vector2(200.0f, 1500.0f)));
+        config.playFieldCards.push_back(card(CardFaceType::CFT_SIX, CardSuitType::CST_HEARTS, Vector2(400.0f, 1500.0f)));
+        config.playFieldCards.push_back(card(CardFaceType::CFT_KING, CardSuitType::CST_SPADES, Vector2(600.0f, 1300.0f)));
+        // 备用牌组没有位置（原点）
+        config.stackCards.push_back(card(CardFaceType::CFT_ACE, CardSuitType::CST_DIAMONDS, Vector2::ZERO));
+        config.stackCards.push_back(card(CardFaceType::CFT_FOUR, CardSuitType::CST_CLUBS, Vector2::ZERO));
+        return config;
+    }
+
+    // 与 ReplayVerifier::addLevel 相同的初始化：配置 -> 运行时数据 -> 发牌
+    inline void initModel(GameModel& model) {
+        auto generated = GameModelFromLevelGenerator::generateGameModel(makeLevelConfig());
+        model.copyStateFrom(*generated);
+        std::vector<std::shared_ptr<CardModel>> stockCards;
+        MoveService::dealStack(model, stockCards);
+    }
+
+    inline std::vector<ReplayMove> legalMoves() {
+        std::vector<ReplayMove> moves;
+        moves.push_back(ReplayMove(InputCommandType::PLAYFIELD_TAP, 0, 900, 0));
+        moves.push_back(ReplayMove(InputCommandType::PLAYFIELD_TAP, 1, 1500, 0));
+        moves.push_back(ReplayMove(InputCommandType::STACK_TAP, 3, 2600, 0));
+        moves.push_back(ReplayMove(InputCommandType::PLAYFIELD_TAP, 2, 3100, 0));
+        moves.push_back(ReplayMove(InputCommandType::UNDO, -1, 4000, 0));
+        return moves;
+    }
+
+    // 在初始局面上依次执行 moves，按录制端的方式填写每步的状态哈希和最终哈希
+    // @return 全部操作都合法时返回 true
+    inline bool record(const std::vector<ReplayMove>& moves, ReplayData& replay) {
+        GameModel model;
+        initModel(model);
+        UndoManager undoManager;
+
+        replay.levelId = kLevelId;
+        replay.seed = 0;
+        replay.ruleSet = GameLogicService::RULE_SET_VERSION;
+        replay.initialHash = GameStateHasher::hash(model, 0);
+        replay.moves = moves;
+        uint64_t hash = replay.initialHash;
+        for (auto& move : replay.moves) {
+            if (!MoveService::applyCommand(model, undoManager, move.type, move.cardId)) return false;
+            hash = GameStateHasher::hash(model, undoManager.size());
+            move.stateHash = (uint32_t)hash;
+        }
+        replay.finalHash = hash;
+        return true;
+    }
+}
+
+#endif // CORE_TEST_REPLAY_FIXTURE_H
@@ -0,0 +1,133 @@
+/**
+ * @file ReplayVerifierTests.cpp
+ * @brief ReplayVerifier：每种判定结果各一个样例，以及多线程校验一批混合回放时结果与单线程一致
+ */
+#include "TestHarness.h"
+#include "ReplayFixture.h"
+#include "managers/ReplayVerifier.h"
+#include "services/ReplayCodec.h"
+
+#include <vector>
+
+namespace {
+    // 一批待校验的回放：持有编码后的数据，提交项指向这些数据
+    struct Batch {
+        std::vector<std::vector<uint8_t>> encoded;
+        std::vector<ReplayVerdict> expected;
+
+        void add(const ReplayData& replay, ReplayVerdict verdict) {
+            encoded.push_back(std::vector<uint8_t>());
+            ReplayCodec::encode(replay, encoded.back());
+            expected.push_back(verdict);
+        }
+
+        void addBytes(const std::vector<uint8_t>& bytes, ReplayVerdict verdict) {
+            encoded.push_back(bytes);
+            expected.push_back(verdict);
+        }
+
+        std::vector<ReplaySubmission> submissions() const {
+            std::vector<ReplaySubmission> result;
+            for (const auto& bytes : encoded) {
+                ReplaySubmission submission;
+                submission.data = bytes.data();
+                submission.size = bytes.size();
+                result.push_back(submission);
+            }
+            return result;
+        }
+    };
+
+    ReplayData validReplay() {
+        ReplayData replay;
+        ReplayFixture::record(ReplayFixture::legalMoves(), replay);
+        return replay;
+    }
+
+    // 每种判定结果一个样例，按 ReplayVerdict 的顺序
+    Batch makeFixtures() {
+        Batch batch;
+        batch.add(validReplay(), ReplayVerdict::VALID);
+
+        std::vector<uint8_t> corrupt;
+        ReplayCodec::encode(validReplay(), corrupt);
+        corrupt.pop_back();
+        batch.addBytes(corrupt, ReplayVerdict::CORRUPT);
+
+        ReplayData unknownLevel = validReplay();
+        unknownLevel.levelId = ReplayFixture::kLevelId + 1;
+        batch.add(unknownLevel, ReplayVerdict::UNKNOWN_LEVEL);
+
+        ReplayData ruleSet = validReplay();
+        ruleSet.ruleSet = GameLogicService::RULE_SET_VERSION + 1;
+        batch.add(ruleSet, ReplayVerdict::RULE_SET_MISMATCH);
+
+        ReplayData initialState = validReplay();
+        initialState.initialHash ^= 1;
+        batch.add(initialState, ReplayVerdict::INITIAL_STATE_MISMATCH);
+
+        // 第二步点 K：底牌是 5，不相邻
+        ReplayData illegal = validReplay();
+        illegal.moves[1].cardId = 2;
+        batch.add(illegal, ReplayVerdict::ILLEGAL_MOVE);
+
+        ReplayData hashMismatch = validReplay();
+        hashMismatch.moves[2].stateHash ^= 0x100;
+        batch.add(hashMismatch, ReplayVerdict::HASH_MISMATCH);
+
+        // 每步都对，只有声明的最终结果不对（例如客户端上报的分数被改过）
+        ReplayData finalMismatch = validReplay();
+        finalMismatch.finalHash ^= 1ull << 40;
+        batch.add(finalMismatch, ReplayVerdict::FINAL_HASH_MISMATCH);
+        return batch;
+    }
+}
+
+CORE_TEST(replay_verifier, one_fixture_per_verdict) {
+    ReplayData recorded;
+    REQUIRE(ReplayFixture::record(ReplayFixture::legalMoves(), recorded));
+
+    ReplayVerifier verifier(1);
+    REQUIRE(verifier.addLevel(ReplayFixture::kLevelId, ReplayFixture::makeLevelConfig()));
+    CHECK(!verifier.addLevel(ReplayFixture::kLevelId + 1, LevelConfig()));
+
+    Batch batch = makeFixtures();
+    REQUIRE(batch.expected.size() == (size_t)ReplayVerdict::VERDICT_COUNT);
+    std::vector<ReplaySubmission> submissions = batch.submissions();
+    std::vector<ReplayVerdict> verdicts(submissions.size(), ReplayVerdict::VERDICT_COUNT);
+    verifier.verify(submissions.data(), submissions.size(), verdicts.data());
+
+    for (size_t i = 0; i < verdicts.size(); ++i) CHECK(verdicts[i] == batch.expected[i]);
+
+    // 每种结果各计一次；ILLEGAL_MOVE 在第二步停下，HASH_MISMATCH 在第三步停下
+    const ReplayVerifier::Stats& stats = verifier.getStats();
+    CHECK(stats.replays == (uint64_t)ReplayVerdict::VERDICT_COUNT);
+    for (size_t i = 0; i < (size_t)ReplayVerdict::VERDICT_COUNT; ++i) CHECK(stats.verdicts[i] == 1);
+    CHECK(stats.moves == 2 * recorded.moves.size() + 1 + 3);
+}
+
+CORE_TEST(replay_verifier, threads_match_single_thread) {
+    // 同一批混合回放重复多份，多线程校验的结果逐项与预期一致
+    Batch fixtures = makeFixtures();
+    Batch batch;
+    for (int copy = 0; copy < 200; ++copy) {
+        for (size_t i = 0; i < fixtures.encoded.size(); ++i) batch.addBytes(fixtures.encoded[i], fixtures.expected[i]);
+    }
+    std::vector<ReplaySubmission> submissions = batch.submissions();
+
+    ReplayVerifier verifier(4);
+    REQUIRE(verifier.threadCount() == 4);
+    REQUIRE(verifier.addLevel(ReplayFixture::kLevelId, ReplayFixture::makeLevelConfig()));
+
+    // 同一个校验器连续校验两批，工作线程在批次之间复用
+    for (int round = 0; round < 2; ++round) {
+        std::vector<ReplayVerdict> verdicts(submissions.size(), ReplayVerdict::VERDICT_COUNT);
+        verifier.verify(submissions.data(), submissions.size(), verdicts.data());
+        size_t wrong = 0;
+        for (size_t i = 0; i < verdicts.size(); ++i) {
+            if (verdicts[i] != batch.expected[i]) wrong++;
+        }
+        CHECK(wrong == 0);
+    }
+    CHECK(verifier.getStats().replays == 2 * submissions.size());
+}
@@ -0,0 +1,150 @@
+/**
+ * @file SnapshotCodecTests.cpp
+ * @brief SnapshotCodec 编解码往返与损坏数据的拒绝，以及经过存档往返后的对局状态不变
+ */
+#include "TestHarness.h"
+#include "ReplayFixture.h"
+#include "services/SnapshotCodec.h"
+#include "services/SnapshotService.h"
+
+#include <vector>
+
+namespace {
+    CardSnapshot makeCard(int32_t id, CardState state, int32_t zIndex, const Vector2& position) {
+        CardSnapshot card;
+        card.id = id;
+        card.state = state;
+        card.zIndex = zIndex;
+        card.position = position;
+        return card;
+    }
+
+    GameSnapshot makeSnapshot() {
+        GameSnapshot snapshot;
+        snapshot.levelId = 300000;
+        snapshot.ruleSet = 2;
+        snapshot.layoutWidth = 1080.0f;
+        snapshot.layoutHeight = 2080.5f;
+        snapshot.sessionTimeMs = 3600000;
+        snapshot.topCardId = 4;
+        snapshot.cards.push_back(makeCard(0, CardState::FACE_UP, 101, Vector2(540.0f, 400.0f)));
+        snapshot.cards.push_back(makeCard(1, CardState::FACE_DOWN, 0, Vector2(-12.25f, 1500.0f)));
+        snapshot.cards.push_back(makeCard(2, CardState::REMOVED, -3, Vector2::ZERO));
+        snapshot.cards.push_back(makeCard(70000, CardState::FACE_UP, 100, Vector2(0.5f, 0.25f)));
+        snapshot.stockCardIds.push_back(3);
+        snapshot.stockCardIds.push_back(70000);
+        snapshot.undoHistory.push_back(UndoCommand(0, Vector2(200.0f, 1500.0f), 4, CardState::FACE_UP, 2));
+        snapshot.undoHistory.push_back(UndoCommand(3, Vector2::ZERO, -1, CardState::FACE_DOWN, 0));
+        for (int i = 0; i < 300; ++i) snapshot.replay.push_back((uint8_t)(i * 7));
+        return snapshot;
+    }
+
+    bool sameSnapshot(const GameSnapshot& a, const GameSnapshot& b) {
+        if (a.levelId != b.levelId || a.ruleSet != b.ruleSet || a.layoutWidth != b.layoutWidth
+            || a.layoutHeight != b.layoutHeight || a.sessionTimeMs != b.sessionTimeMs || a.topCardId != b.topCardId
+            || a.cards.size() != b.cards.size() || a.stockCardIds != b.stockCardIds
+            || a.undoHistory.size() != b.undoHistory.size() || a.replay != b.replay) {
+            return false;
+        }
+        for (size_t i = 0; i < a.cards.size(); ++i) {
+            const CardSnapshot& x = a.cards[i];
+            const CardSnapshot& y = b.cards[i];
+            if (x.id != y.id || x.state != y.state || x.zIndex != y.zIndex || !x.position.equals(y.position)) return false;
+        }
+        for (size_t i = 0; i < a.undoHistory.size(); ++i) {
+            const UndoCommand& x = a.undoHistory[i];
+            const UndoCommand& y = b.undoHistory[i];
+            if (x.cardId != y.cardId || !x.fromPos.equals(y.fromPos) || x.prevTopCardId != y.prevTopCardId
+                || x.prevState != y.prevState || x.prevZIndex != y.prevZIndex) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+CORE_TEST(snapshot_codec, round_trip) {
+    GameSnapshot snapshot = makeSnapshot();
+
+    // 结果追加到已有内容之后
+    std::vector<uint8_t> bytes(2, 0xCD);
+    SnapshotCodec::encode(snapshot, bytes);
+    CHECK(bytes[0] == 0xCD && bytes[1] == 0xCD);
+
+    // 解码到一个已有内容的 GameSnapshot：所有字段都被覆盖
+    GameSnapshot decoded = makeSnapshot();
+    decoded.cards.push_back(CardSnapshot());
+    decoded.replay.clear();
+    REQUIRE(SnapshotCodec::decode(bytes.data() + 2, bytes.size() - 2, decoded));
+    CHECK(sameSnapshot(decoded, snapshot));
+
+    GameSnapshot empty;
+    std::vector<uint8_t> emptyBytes;
+    SnapshotCodec::encode(empty, emptyBytes);
+    CHECK(SnapshotCodec::decode(emptyBytes.data(), emptyBytes.size(), decoded));
+    CHECK(sameSnapshot(decoded, empty));
+}
+
+CORE_TEST(snapshot_codec, rejects_truncated_and_bad_header) {
+    std::vector<uint8_t> bytes;
+    SnapshotCodec::encode(makeSnapshot(), bytes);
+
+    // 任何长度的前缀都不是完整的存档，多出的字节也不接受
+    GameSnapshot decoded;
+    size_t accepted = 0;
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        if (SnapshotCodec::decode(bytes.data(), size, decoded)) accepted++;
+    }
+    CHECK(accepted == 0);
+    std::vector<uint8_t> trailing = bytes;
+    trailing.push_back(0);
+    CHECK(!SnapshotCodec::decode(trailing.data(), trailing.size(), decoded));
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] = 'X';
+    CHECK(!SnapshotCodec::decode(badMagic.data(), badMagic.size(), decoded));
+
+    std::vector<uint8_t> badVersion = bytes;
+    badVersion[4] = (uint8_t)(SnapshotCodec::FORMAT_VERSION + 1);
+    CHECK(!SnapshotCodec::decode(badVersion.data(), badVersion.size(), decoded));
+
+    // 卡牌状态超出 CardState 的范围
+    GameSnapshot badState;
+    badState.cards.push_back(makeCard(0, (CardState)((int)CardState::REMOVED + 1), 0, Vector2::ZERO));
+    std::vector<uint8_t> badStateBytes;
+    SnapshotCodec::encode(badState, badStateBytes);
+    CHECK(!SnapshotCodec::decode(badStateBytes.data(), badStateBytes.size(), decoded));
+}
+
+CORE_TEST(snapshot_codec, restored_game_keeps_state) {
+    // 走几步后存档：capture -> encode -> decode -> restore 到新发牌的模型
+    GameModel model;
+    ReplayFixture::initModel(model);
+    UndoManager undoManager;
+    std::vector<ReplayMove> moves = ReplayFixture::legalMoves();
+    for (size_t i = 0; i + 1 < moves.size(); ++i) {
+        REQUIRE(MoveService::applyCommand(model, undoManager, moves[i].type, moves[i].cardId));
+    }
+
+    GameSnapshot snapshot;
+    SnapshotService::capture(model, undoManager, snapshot);
+    std::vector<uint8_t> bytes;
+    SnapshotCodec::encode(snapshot, bytes);
+
+    GameSnapshot decoded;
+    REQUIRE(SnapshotCodec::decode(bytes.data(), bytes.size(), decoded));
+    GameModel restored;
+    ReplayFixture::initModel(restored);
+    UndoManager restoredUndo;
+    REQUIRE(SnapshotService::restore(decoded, restored, restoredUndo));
+    CHECK(GameStateHasher::hash(restored, restoredUndo.size()) == GameStateHasher::hash(model, undoManager.size()));
+    CHECK(restored.stockCardIds == model.stockCardIds);
+
+    // 回退历史也一起恢复：两边各回退到底，状态仍然一致
+    UndoCommand undone;
+    while (MoveService::undo(model, undoManager, undone)) {
+        REQUIRE(MoveService::undo(restored, restoredUndo, undone));
+        CHECK(GameStateHasher::hash(restored, restoredUndo.size()) == GameStateHasher::hash(model, undoManager.size()));
+    }
+    CHECK(!restoredUndo.canUndo());
+}
@@ -0,0 +1,214 @@
+/**
+ * @file TelemetryTests.cpp
+ * @brief TelemetryCodec 批次格式，以及 TelemetryManager 多线程记录后的落盘完整性、顺序与文件轮转
+ */
+#include "TestHarness.h"
+#include "managers/TelemetryManager.h"
+#include "services/TelemetryCodec.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const uint32_t kMaxFiles = 4;
+    const uint32_t kThreads = 3;
+    const uint16_t kMovesPerThread = 3000;
+
+    std::string slotPath(uint32_t slot) {
+        return CoreTest::tempDir() + "telemetry_" + std::to_string(slot) + ".bin";
+    }
+
+    std::string indexPath() {
+        return CoreTest::tempDir() + "telemetry.idx";
+    }
+
+    void removeTelemetryFiles() {
+        for (uint32_t slot = 0; slot < kMaxFiles; ++slot) std::remove(slotPath(slot).c_str());
+        std::remove(indexPath().c_str());
+    }
+
+    std::vector<uint8_t> readBytes(const std::string& path) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    // 解码一个文件中的全部批次，返回是否整个文件都是完整批次
+    bool decodeFile(const std::string& path, std::vector<TelemetryEvent>& events) {
+        std::vector<uint8_t> bytes = readBytes(path);
+        return TelemetryCodec::decodeAll(bytes.data(), bytes.size(), events) == bytes.size();
+    }
+
+    TelemetryManager::Config testConfig(size_t maxFileBytes) {
+        TelemetryManager::Config config;
+        config.directory = CoreTest::tempDir();
+        config.flushIntervalMs = 2;
+        config.maxFileBytes = maxFileBytes;
+        config.maxFiles = kMaxFiles;
+        config.ringCapacity = 1u << 14;
+        return config;
+    }
+
+    TelemetryEvent makeEvent(uint32_t index) {
+        TelemetryEvent event;
+        event.timestampMs = 1700000000000ull + index;
+        event.playId = 0x80000000u + index;
+        event.levelId = (uint16_t)(index % 9);
+        event.type = (TelemetryEventType)(index % 4);
+        event.detail = (uint8_t)(index % 3);
+        event.elapsedMs = index * 7;
+        event.value = -(int32_t)index;
+        event.moveCount = (uint16_t)index;
+        event.undoCount = (uint16_t)(index / 2);
+        event.reserved = 0;
+        return event;
+    }
+
+    bool sameEvent(const TelemetryEvent& a, const TelemetryEvent& b) {
+        return a.timestampMs == b.timestampMs && a.playId == b.playId && a.levelId == b.levelId
+            && a.type == b.type && a.detail == b.detail && a.elapsedMs == b.elapsedMs && a.value == b.value
+            && a.moveCount == b.moveCount && a.undoCount == b.undoCount && a.reserved == b.reserved;
+    }
+}
+
+// ========== TelemetryCodec ==========
+
+CORE_TEST(telemetry, codec_round_trip) {
+    std::vector<TelemetryEvent> events;
+    for (uint32_t i = 0; i < 50; ++i) events.push_back(makeEvent(i));
+
+    std::vector<uint8_t> bytes;
+    TelemetryCodec::encodeBatch(events.data(), 20, bytes);
+    TelemetryCodec::encodeBatch(events.data() + 20, 30, bytes);
+    CHECK(bytes.size() == 2 * TelemetryCodec::HEADER_SIZE + 50 * TelemetryCodec::EVENT_SIZE);
+
+    std::vector<TelemetryEvent> decoded;
+    CHECK(TelemetryCodec::decodeAll(bytes.data(), bytes.size(), decoded) == bytes.size());
+    REQUIRE(decoded.size() == events.size());
+    for (size_t i = 0; i < events.size(); ++i) CHECK(sameEvent(decoded[i], events[i]));
+}
+
+CORE_TEST(telemetry, codec_rejects_truncated_and_bad_header) {
+    std::vector<TelemetryEvent> events;
+    for (uint32_t i = 0; i < 4; ++i) events.push_back(makeEvent(i));
+    std::vector<uint8_t> bytes;
+    TelemetryCodec::encodeBatch(events.data(), events.size(), bytes);
+    size_t firstBatch = bytes.size();
+    TelemetryCodec::encodeBatch(events.data(), events.size(), bytes);
+
+    // 第二个批次少一个字节：只读出第一个批次
+    std::vector<TelemetryEvent> decoded;
+    CHECK(TelemetryCodec::decodeAll(bytes.data(), bytes.size() - 1, decoded) == firstBatch);
+    CHECK(decoded.size() == events.size());
+
+    uint32_t count = 0;
+    CHECK(!TelemetryCodec::readBatchHeader(bytes.data(), TelemetryCodec::HEADER_SIZE - 1, count));
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] = 'X';
+    CHECK(!TelemetryCodec::readBatchHeader(badMagic.data(), badMagic.size(), count));
+
+    std::vector<uint8_t> badVersion = bytes;
+    badVersion[4] = (uint8_t)(TelemetryCodec::FORMAT_VERSION + 1);
+    CHECK(!TelemetryCodec::readBatchHeader(badVersion.data(), badVersion.size(), count));
+
+    std::vector<uint8_t> badSize = bytes;
+    badSize[6] = (uint8_t)(TelemetryCodec::EVENT_SIZE + 1);
+    CHECK(!TelemetryCodec::readBatchHeader(badSize.data(), badSize.size(), count));
+}
+
+// ========== TelemetryManager ==========
+
+CORE_TEST(telemetry, stress_threads_keep_order_and_rotate) {
+    removeTelemetryFiles();
+
+    TelemetryManager::Stats stats;
+    {
+        // 约 288 KB 的事件写入 100 KB 的文件：轮转两三次，但不会回绕覆盖第一个槽位
+        TelemetryManager manager(testConfig(100 * 1024));
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreads; ++t) {
+            threads.push_back(std::thread([&manager, t]() {
+                TelemetryPlay play;
+                play.playId = 1000 + t;
+                play.levelId = (uint16_t)t;
+                manager.recordLevelStart(play, false);
+                for (uint16_t i = 0; i < kMovesPerThread; ++i) {
+                    play.moveCount++;
+                    manager.recordMove(play, InputCommandType::PLAYFIELD_TAP, i, 5);
+                    if (i % 500 == 0) std::this_thread::yield();
+                }
+                manager.recordLevelEnd(play, LevelOutcome::ABANDONED, 3, 1234);
+            }));
+        }
+        for (auto& thread : threads) thread.join();
+        manager.shutdown();
+        CHECK(!manager.recordLevelStart(TelemetryPlay(), false));
+        stats = manager.getStats();
+    }
+
+    const uint64_t expected = (uint64_t)kThreads * (kMovesPerThread + 2);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.recorded == expected);
+    CHECK(stats.written == expected);
+    CHECK(stats.errors == 0);
+    CHECK(stats.rotations > 0);
+
+    // 按槽位顺序读回（从 0 开始写，轮转次数少于槽位数，不会覆盖）
+    REQUIRE(stats.rotations < kMaxFiles);
+    std::vector<TelemetryEvent> events;
+    for (uint32_t slot = 0; slot <= stats.rotations && slot < kMaxFiles; ++slot) {
+        CHECK(decodeFile(slotPath(slot), events));
+    }
+    CHECK(events.size() == expected);
+
+    // 同一线程（同一局）的事件保持记录顺序：LEVEL_START，依次递增的 MOVE，最后 LEVEL_END
+    std::map<uint32_t, uint16_t> lastMove;
+    std::map<uint32_t, bool> ended;
+    uint64_t outOfOrder = 0;
+    for (const auto& event : events) {
+        if (event.type == TelemetryEventType::LEVEL_START) {
+            if (lastMove.count(event.playId)) outOfOrder++;
+            lastMove[event.playId] = 0;
+        }
+        else if (event.type == TelemetryEventType::MOVE) {
+            if (!lastMove.count(event.playId) || ended[event.playId] || event.moveCount != lastMove[event.playId] + 1) outOfOrder++;
+            lastMove[event.playId] = event.moveCount;
+        }
+        else if (event.type == TelemetryEventType::LEVEL_END) {
+            if (lastMove[event.playId] != kMovesPerThread) outOfOrder++;
+            ended[event.playId] = true;
+        }
+    }
+    CHECK(outOfOrder == 0);
+    CHECK(ended.size() == kThreads);
+}
+
+CORE_TEST(telemetry, next_run_starts_on_next_slot) {
+    removeTelemetryFiles();
+
+    for (uint32_t run = 0; run < 2; ++run) {
+        TelemetryManager manager(testConfig(256 * 1024));
+        TelemetryPlay play;
+        play.playId = manager.newPlayId();
+        manager.recordLevelStart(play, run == 1);
+        manager.shutdown();
+    }
+
+    // 第一次运行写槽位 0，第二次运行从槽位 1 开始，索引记下最后写的槽位
+    std::vector<TelemetryEvent> first;
+    std::vector<TelemetryEvent> second;
+    CHECK(decodeFile(slotPath(0), first));
+    CHECK(decodeFile(slotPath(1), second));
+    REQUIRE(first.size() == 1);
+    REQUIRE(second.size() == 1);
+    CHECK(first[0].detail == 0);
+    CHECK(second[0].detail == 1);
+
+    std::vector<uint8_t> index = readBytes(indexPath());
+    CHECK(std::string(index.begin(), index.end()) == "1\n");
+}
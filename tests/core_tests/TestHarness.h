@@ -0,0 +1,49 @@
+/**
+ * @file TestHarness.h
+ * @brief 核心库测试的最小框架 - 不依赖引擎和第三方测试库
+ *
+ * @details
+ * - CORE_TEST(suite, name) 定义并注册一个测试，同一 suite 的测试作为一个 ctest 条目运行
+ * - CHECK 失败时记录并继续；REQUIRE 失败时记录并结束当前测试（只能在测试函数体中使用）
+ * - 并发测试的检查在测试线程汇总后进行，工作线程中只做计数，避免检查本身引入同步
+ */
+#ifndef CORE_TEST_HARNESS_H
+#define CORE_TEST_HARNESS_H
+
+#include <string>
+
+typedef void (*CoreTestFunc)();
+
+class CoreTest {
+public:
+    // 注册测试（静态初始化时调用）
+    static void add(const char* suite, const char* name, CoreTestFunc func);
+
+    // 运行 suite 为 filter 的测试（filter 为空时运行全部），返回失败的测试数；没有匹配的测试时返回 -1
+    static int run(const std::string& filter);
+
+    // 记录当前测试的一次失败
+    static void fail(const char* file, int line, const char* expression);
+
+    // 测试用的临时目录（以 / 结尾，首次调用时在当前目录下创建）
+    static const std::string& tempDir();
+};
+
+struct CoreTestRegistrar {
+    CoreTestRegistrar(const char* suite, const char* name, CoreTestFunc func) {
+        CoreTest::add(suite, name, func);
+    }
+};
+
+#define CORE_TEST(suite, name) \
+    static void coreTest_##suite##_##name(); \
+    static CoreTestRegistrar coreTestRegistrar_##suite##_##name(#suite, #name, &coreTest_##suite##_##name); \
+    static void coreTest_##suite##_##name()
+
+#define CHECK(expression) \
+    do { if (!(expression)) CoreTest::fail(__FILE__, __LINE__, #expression); } while (0)
+
+#define REQUIRE(expression) \
+    do { if (!(expression)) { CoreTest::fail(__FILE__, __LINE__, #expression); return; } } while (0)
+
+#endif // CORE_TEST_HARNESS_H
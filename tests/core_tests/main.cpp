@@ -0,0 +1,85 @@
+/**
+ * @file main.cpp
+ * @brief 核心库测试入口，不依赖引擎
+ *
+ * @details
+ * - 用法：core_tests [suite]，不带参数时运行全部测试；ctest 为每个 suite 单独登记一个条目
+ * - 无锁结构的压力测试在普通构建下检查结果，顺序错误（内存序、发布顺序）需要在 ThreadSanitizer 下运行才能稳定暴露：
+ *   cmake -DCMAKE_CXX_FLAGS=-fsanitize=thread -DCMAKE_EXE_LINKER_FLAGS=-fsanitize=thread ...
+ *
+ * 返回值：全部通过为 0，存在失败为 1，没有匹配的测试为 2
+ */
+#include "TestHarness.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+    struct TestEntry {
+        const char* suite;
+        const char* name;
+        CoreTestFunc func;
+    };
+
+    // 函数内静态变量：注册发生在静态初始化阶段，不依赖各翻译单元的初始化顺序
+    std::vector<TestEntry>& registry() {
+        static std::vector<TestEntry> entries;
+        return entries;
+    }
+
+    int s_failures = 0;
+}
+
+void CoreTest::add(const char* suite, const char* name, CoreTestFunc func) {
+    TestEntry entry = { suite, name, func };
+    registry().push_back(entry);
+}
+
+int CoreTest::run(const std::string& filter) {
+    int failedTests = 0;
+    int matched = 0;
+    for (const auto& entry : registry()) {
+        if (!filter.empty() && filter != entry.suite) continue;
+        ++matched;
+        s_failures = 0;
+        entry.func();
+        printf("[%s] %s.%s\n", s_failures ? "FAIL" : " OK ", entry.suite, entry.name);
+        fflush(stdout);
+        if (s_failures) ++failedTests;
+    }
+    return matched ? failedTests : -1;
+}
+
+void CoreTest::fail(const char* file, int line, const char* expression) {
+    ++s_failures;
+    printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+}
+
+const std::string& CoreTest::tempDir() {
+    static std::string dir;
+    if (dir.empty()) {
+        dir = "core_tests_tmp/";
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
+    }
+    return dir;
+}
+
+int main(int argc, char** argv) {
+    std::string filter = argc > 1 ? argv[1] : "";
+    int failed = CoreTest::run(filter);
+    if (failed < 0) {
+        fprintf(stderr, "core_tests: no tests in suite '%s'\n", filter.c_str());
+        return 2;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file main.cpp
+ * @brief 核心库微基准（Google Benchmark），不依赖引擎
+ *
+ * @details 覆盖的热点路径：
+ * - GameLogicService::canMatch
+ * - GameModel::getCardById：不同牌数下的两种情况——ID 与下标一致（直接命中）和不一致（线性查找）
+ * - 关卡加载：LevelConfigParser 解析小关卡（level_1.json）和生成的大关卡，以及读文件 + 解析
+ *   （需要 RapidJSON，对应客户端 LevelConfigLoader::loadLevelConfig 中不依赖引擎的部分）
+ * - GameModelFromLevelGenerator::generateGameModel
+ * - UndoManager 压栈 / 出栈
+ *
+ * 可重复：所有输入由固定种子的随机数生成，构造在计时循环之外完成
+ * 机器可读：cmake --build . --target run_benchmarks 以 5 次重复运行，结果（含均值、中位数、标准差）写入 benchmark_results.json；
+ *           也可以直接运行 core_benchmark --benchmark_out=out.json --benchmark_out_format=json
+ */
+#include "configs/models/LevelConfig.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "services/GameLogicService.h"
+#include "services/GameModelFromLevelGenerator.h"
+
+#ifdef CARDGAME_BENCH_LEVEL_PARSER
+#include "configs/loaders/LevelConfigParser.h"
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#endif
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // 所有输入使用同一个固定种子，保证每次运行测的是相同的数据
+    const uint32_t kSeed = 20240601;
+
+    CardFaceType randomFace(std::mt19937& rng) {
+        return (CardFaceType)(rng() % (uint32_t)CardFaceType::CFT_NUM_CARD_FACE_TYPES);
+    }
+
+    CardSuitType randomSuit(std::mt19937& rng) {
+        return (CardSuitType)(rng() % (uint32_t)CardSuitType::CST_NUM_CARD_SUIT_TYPES);
+    }
+
+    // 生成 playFieldCount + stackCount 张牌的关卡配置
+    LevelConfig makeLevelConfig(size_t playFieldCount, size_t stackCount) {
+        std::mt19937 rng(kSeed);
+        LevelConfig config;
+        for (size_t i = 0; i < playFieldCount; ++i) {
+            CardConfigData card;
+            card.face = randomFace(rng);
+            card.suit = randomSuit(rng);
+            card.position = Vector2((float)(rng() % 1080), (float)(rng() % 2080));
+            config.playFieldCards.push_back(card);
+        }
+        for (size_t i = 0; i < stackCount; ++i) {
+            CardConfigData card;
+            card.face = randomFace(rng);
+            card.suit = randomSuit(rng);
+            card.position = Vector2(300.0f, 300.0f);
+            config.stackCards.push_back(card);
+        }
+        return config;
+    }
+
+    // 生成 count 张牌的模型；scattered 为 true 时打乱顺序，ID 与下标不再一致
+    GameModel makeGameModel(size_t count, bool scattered) {
+        std::mt19937 rng(kSeed);
+        GameModel model;
+        for (size_t i = 0; i < count; ++i) {
+            auto card = std::make_shared<CardModel>();
+            card->init((int)i, randomFace(rng), randomSuit(rng), Vector2::ZERO);
+            model.addCard(card);
+        }
+        if (scattered) std::shuffle(model.allCards.begin(), model.allCards.end(), rng);
+        return model;
+    }
+
+    // 固定序列的随机 ID（长度为 2 的幂，循环取用）
+    std::vector<int> makeLookupIds(size_t cardCount) {
+        std::mt19937 rng(kSeed + 1);
+        std::vector<int> ids(1024);
+        for (auto& id : ids) id = (int)(rng() % cardCount);
+        return ids;
+    }
+}
+
+// ========== GameLogicService::canMatch ==========
+static void BM_CanMatch(benchmark::State& state) {
+    std::mt19937 rng(kSeed);
+    std::vector<CardModel> cards(1024);
+    for (size_t i = 0; i < cards.size(); ++i) {
+        cards[i].init((int)i, randomFace(rng), randomSuit(rng), Vector2::ZERO);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const CardModel& hand = cards[i & 1023];
+        const CardModel& field = cards[(i + 1) & 1023];
+        benchmark::DoNotOptimize(GameLogicService::canMatch(&hand, &field));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CanMatch);
+
+// ========== GameModel::getCardById ==========
+static void getCardById(benchmark::State& state, bool scattered) {
+    size_t count = (size_t)state.range(0);
+    GameModel model = makeGameModel(count, scattered);
+    std::vector<int> ids = makeLookupIds(count);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.getCardById(ids[i & 1023]));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_GetCardById_Indexed(benchmark::State& state) { getCardById(state, false); }
+static void BM_GetCardById_Scattered(benchmark::State& state) { getCardById(state, true); }
+BENCHMARK(BM_GetCardById_Indexed)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_GetCardById_Scattered)->RangeMultiplier(4)->Range(16, 1024);
+
+// ========== GameModelFromLevelGenerator::generateGameModel ==========
+static void BM_GenerateGameModel(benchmark::State& state) {
+    size_t count = (size_t)state.range(0);
+    LevelConfig config = makeLevelConfig(count * 3 / 4, count - count * 3 / 4);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GameModelFromLevelGenerator::generateGameModel(config));
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)count);
+}
+BENCHMARK(BM_GenerateGameModel)->Arg(32)->Arg(512);
+
+// ========== UndoManager 压栈 / 出栈 ==========
+static void BM_UndoPushPop(benchmark::State& state) {
+    size_t depth = (size_t)state.range(0);
+    UndoManager undoManager;
+    UndoCommand cmd;
+    cmd.cardId = 1;
+    cmd.prevTopCardId = 0;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < depth; ++i) {
+            cmd.prevZIndex = (int)i;
+            undoManager.pushCommand(cmd);
+        }
+        while (undoManager.canUndo()) {
+            benchmark::DoNotOptimize(undoManager.popCommand());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)depth * 2);
+}
+BENCHMARK(BM_UndoPushPop)->Arg(1)->Arg(64)->Arg(1024);
+
+#ifdef CARDGAME_BENCH_LEVEL_PARSER
+namespace {
+    std::string readLevelFile(const std::string& name) {
+        std::ifstream in((std::string(CARDGAME_LEVELS_DIR) + "/" + name).c_str(), std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // 按关卡文件的格式生成 count 张牌的 JSON（3/4 在主牌区，其余在备用堆）
+    std::string makeLevelJson(size_t count) {
+        LevelConfig config = makeLevelConfig(count * 3 / 4, count - count * 3 / 4);
+        std::ostringstream out;
+        auto writeCards = [&out](const std::vector<CardConfigData>& cards) {
+            for (size_t i = 0; i < cards.size(); ++i) {
+                out << (i ? ",\n" : "\n") << "        {\"CardFace\": " << (int)cards[i].face
+                    << ", \"CardSuit\": " << (int)cards[i].suit
+                    << ", \"Position\": {\"x\": " << cards[i].position.x << ", \"y\": " << cards[i].position.y << "}}";
+            }
+        };
+        out << "{\n    \"Playfield\": [";
+        writeCards(config.playFieldCards);
+        out << "\n    ],\n    \"Stack\": [";
+        writeCards(config.stackCards);
+        out << "\n    ]\n}\n";
+        return out.str();
+    }
+}
+
+// ========== 关卡解析：小关卡（level_1.json）/ 生成的大关卡 ==========
+static void parseLevel(benchmark::State& state, const std::string& json) {
+    if (json.empty()) {
+        state.SkipWithError("level json not found");
+        return;
+    }
+    LevelConfig config;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LevelConfigParser::parse(json, config));
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)json.size());
+    state.counters["cards"] = (double)(config.playFieldCards.size() + config.stackCards.size());
+}
+
+static void BM_ParseLevel_Small(benchmark::State& state) { parseLevel(state, readLevelFile("level_1.json")); }
+static void BM_ParseLevel_Large(benchmark::State& state) { parseLevel(state, makeLevelJson((size_t)state.range(0))); }
+BENCHMARK(BM_ParseLevel_Small);
+BENCHMARK(BM_ParseLevel_Large)->Arg(512);
+
+// ========== 读文件 + 解析（对应 LevelConfigLoader::loadLevelConfig，文件读取换成标准库） ==========
+static void BM_LoadLevelFile_Small(benchmark::State& state) {
+    for (auto _ : state) {
+        LevelConfig config;
+        benchmark::DoNotOptimize(LevelConfigParser::parse(readLevelFile("level_1.json"), config));
+    }
+}
+BENCHMARK(BM_LoadLevelFile_Small);
+#endif
+
+int main(int argc, char** argv) {
+    // 写入 JSON 结果的 context，便于对比不同提交的数据时确认输入一致
+    benchmark::AddCustomContext("seed", std::to_string(kSeed));
+    benchmark::AddCustomContext("rule_set", std::to_string(GameLogicService::RULE_SET_VERSION));
+#ifdef NDEBUG
+    benchmark::AddCustomContext("cardgame_build", "release");
+#else
+    benchmark::AddCustomContext("cardgame_build", "debug");
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+生成分辨率档位贴图 (Resolution Tiers)
+
+原始美术资源按 1080x2080 设计分辨率制作，直接放在 Resources/ 根目录（large 档）。
+本脚本在构建时把其中的 PNG 按比例缩小，输出到 Resources/tiers/<tier>/ 下，
+目录结构与原始资源保持一致，AppDelegate 启动时根据实际帧尺寸通过搜索路径选择档位。
+
+用法：
+    python tools/gen_resolution_tiers.py [--resources Resources] [--force]
+
+依赖：Pillow (pip install Pillow)
+"""
+import argparse
+import os
+import sys
+
+# 档位名 -> 相对设计分辨率的缩放比例，需与 AppDelegate.cpp 中的档位定义保持一致
+TIERS = {
+    "medium": 0.75,
+    "small": 0.5,
+}
+
+# 只缩放贴图；字体、关卡 JSON 等资源通过搜索路径回退到根目录
+IMAGE_EXTS = (".png", ".jpg")
+
+# 不参与缩放的目录：已生成的档位目录本身，以及由 gen_ui_font.py 按档位字号重新光栅化的字体
+SKIP_DIRS = ("tiers", "fonts")
+
+
+def iter_images(root):
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel = os.path.relpath(dirpath, root)
+        if rel.split(os.sep)[0] in SKIP_DIRS:
+            dirnames[:] = []
+            continue
+        for name in filenames:
+            if name.lower().endswith(IMAGE_EXTS):
+                yield os.path.join(dirpath, name)
+
+
+def is_up_to_date(src, dst):
+    return os.path.exists(dst) and os.path.getmtime(dst) >= os.path.getmtime(src)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate downscaled resolution tiers")
+    parser.add_argument("--resources", default=os.path.join(os.path.dirname(__file__), "..", "Resources"))
+    parser.add_argument("--force", action="store_true", help="regenerate even if outputs are newer")
+    args = parser.parse_args()
+
+    try:
+        from PIL import Image
+    except ImportError:
+        print("gen_resolution_tiers: Pillow not installed, skipping tier generation", file=sys.stderr)
+        return 0
+
+    root = os.path.abspath(args.resources)
+    generated = 0
+    for src in iter_images(root):
+        rel = os.path.relpath(src, root)
+        for tier, scale in TIERS.items():
+            dst = os.path.join(root, "tiers", tier, rel)
+            if not args.force and is_up_to_date(src, dst):
+                continue
+            os.makedirs(os.path.dirname(dst), exist_ok=True)
+            with Image.open(src) as img:
+                # 至少保留 1 像素，避免极小的贴图被缩没
+                size = (max(1, round(img.width * scale)), max(1, round(img.height * scale)))
+                img.resize(size, Image.LANCZOS).save(dst, optimize=True)
+            generated += 1
+
+    print("gen_resolution_tiers: %d image(s) written under %s" % (generated, os.path.join(root, "tiers")))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+生成 UI 位图字体 (BMFont)
+
+把 Resources/fonts/arial.ttf 中 UI 用到的字符集预先光栅化到一张贴图上，
+输出 AngelCode BMFont 文本格式（.fnt + .png），运行时 Label::createWithBMFont 直接读取，
+不再经过平台字体栈逐字光栅化。
+
+输出：
+    Resources/fonts/ui.fnt, ui.png                 原始设计分辨率（large 档）
+    Resources/tiers/<tier>/fonts/ui.fnt, ui.png    按档位缩放后的字号重新光栅化
+
+用法：
+    python tools/gen_ui_font.py [--resources Resources] [--force]
+
+依赖：Pillow (pip install Pillow)
+"""
+import argparse
+import os
+import sys
+
+from gen_resolution_tiers import TIERS
+
+# UI 字符集：可打印 ASCII（关卡标题、按钮文字、角标数字）
+CHARSET = [chr(c) for c in range(32, 127)]
+
+# 设计分辨率下的光栅化字号，取 UI 中最大的字号，小字号由 Label 缩小显示
+FONT_SIZE = 64
+
+# 字形之间的间距，防止线性过滤时相邻字形互相渗色
+PADDING = 2
+
+FONT_NAME = "ui"
+
+
+def pack_glyphs(sizes, width):
+    """简单的行式装箱，返回每个字形的左上角坐标和所需的贴图高度"""
+    positions = []
+    x, y, row_height = PADDING, PADDING, 0
+    for w, h in sizes:
+        if x + w + PADDING > width:
+            x, y = PADDING, y + row_height + PADDING
+            row_height = 0
+        positions.append((x, y))
+        x += w + PADDING
+        row_height = max(row_height, h)
+    return positions, y + row_height + PADDING
+
+
+def next_pow2(value):
+    result = 1
+    while result < value:
+        result *= 2
+    return result
+
+
+def build_font(ttf_path, size, out_dir):
+    from PIL import Image, ImageDraw, ImageFont
+
+    font = ImageFont.truetype(ttf_path, size)
+    ascent, descent = font.getmetrics()
+
+    # 逐字光栅化到草稿图上，按实际像素裁出最小包围盒（getbbox 只给出排版框，两侧带有空白）
+    margin = size
+    glyphs = []
+    for ch in CHARSET:
+        scratch = Image.new("L", (size * 3, size * 3), 0)
+        ImageDraw.Draw(scratch).text((margin, margin), ch, font=font, fill=255)
+        ink = scratch.getbbox()
+        if ink is None:
+            # 空格等不可见字符只有前进宽度
+            glyphs.append({"ch": ch, "image": None, "left": 0, "top": ascent, "width": 0, "height": 0,
+                           "advance": int(round(font.getlength(ch)))})
+            continue
+        glyphs.append({
+            "ch": ch,
+            "image": scratch.crop(ink),
+            "left": ink[0] - margin,
+            "top": ink[1] - margin,
+            "width": ink[2] - ink[0],
+            "height": ink[3] - ink[1],
+            "advance": int(round(font.getlength(ch))),
+        })
+
+    # 先按字形面积估算贴图宽度，再装箱得出高度，两边都取 2 的幂
+    area = sum((g["width"] + PADDING) * (g["height"] + PADDING) for g in glyphs)
+    atlas_width = next_pow2(int(area ** 0.5) + 1)
+    positions, used_height = pack_glyphs([(g["width"], g["height"]) for g in glyphs], atlas_width)
+    atlas_height = next_pow2(used_height)
+
+    # 白色字形 + Alpha 通道，颜色由 Label::setColor 决定
+    alpha = Image.new("L", (atlas_width, atlas_height), 0)
+    for glyph, (x, y) in zip(glyphs, positions):
+        glyph["x"], glyph["y"] = x, y
+        if glyph["image"] is not None:
+            alpha.paste(glyph["image"], (x, y))
+
+    atlas = Image.new("RGBA", (atlas_width, atlas_height), (255, 255, 255, 0))
+    atlas.putalpha(alpha)
+
+    os.makedirs(out_dir, exist_ok=True)
+    png_name = FONT_NAME + ".png"
+    atlas.save(os.path.join(out_dir, png_name), optimize=True)
+
+    lines = [
+        'info face="Arial" size=%d bold=0 italic=0 charset="" unicode=1 stretchH=100 smooth=1 aa=1 '
+        'padding=0,0,0,0 spacing=%d,%d' % (size, PADDING, PADDING),
+        "common lineHeight=%d base=%d scaleW=%d scaleH=%d pages=1 packed=0"
+        % (ascent + descent, ascent, atlas_width, atlas_height),
+        'page id=0 file="%s"' % png_name,
+        "chars count=%d" % len(glyphs),
+    ]
+    for g in glyphs:
+        lines.append(
+            "char id=%d x=%d y=%d width=%d height=%d xoffset=%d yoffset=%d xadvance=%d page=0 chnl=15"
+            % (ord(g["ch"]), g["x"], g["y"], g["width"], g["height"], g["left"], g["top"], g["advance"]))
+    with open(os.path.join(out_dir, FONT_NAME + ".fnt"), "w", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def is_up_to_date(sources, out_dir):
+    fnt = os.path.join(out_dir, FONT_NAME + ".fnt")
+    png = os.path.join(out_dir, FONT_NAME + ".png")
+    if not (os.path.exists(fnt) and os.path.exists(png)):
+        return False
+    newest_source = max(os.path.getmtime(s) for s in sources)
+    return min(os.path.getmtime(fnt), os.path.getmtime(png)) >= newest_source
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the UI bitmap font")
+    parser.add_argument("--resources", default=os.path.join(os.path.dirname(__file__), "..", "Resources"))
+    parser.add_argument("--force", action="store_true", help="regenerate even if outputs are newer")
+    args = parser.parse_args()
+
+    try:
+        import PIL  # noqa: F401
+    except ImportError:
+        print("gen_ui_font: Pillow not installed, skipping UI font generation", file=sys.stderr)
+        return 0
+
+    root = os.path.abspath(args.resources)
+    ttf_path = os.path.join(root, "fonts", "arial.ttf")
+    if not os.path.exists(ttf_path):
+        print("gen_ui_font: %s not found, skipping" % ttf_path, file=sys.stderr)
+        return 0
+
+    sources = [ttf_path, os.path.abspath(__file__)]
+    targets = [(os.path.join(root, "fonts"), FONT_SIZE)]
+    for tier, scale in TIERS.items():
+        targets.append((os.path.join(root, "tiers", tier, "fonts"), max(1, int(round(FONT_SIZE * scale)))))
+
+    generated = 0
+    for out_dir, size in targets:
+        if not args.force and is_up_to_date(sources, out_dir):
+            continue
+        build_font(ttf_path, size, out_dir)
+        generated += 1
+
+    print("gen_ui_font: %d font(s) written" % generated)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,245 @@
+/**
+ * @file main.cpp
+ * @brief 遥测离线汇总命令行工具 - 数据分析使用，不依赖引擎
+ *
+ * @details 流程（map-reduce）：
+ * 1. 把所有遥测文件（TelemetryManager 写出的 telemetry_<n>.bin）映射到内存，只读批次头，
+ *    把事件切成不超过 --chunk 条的连续块；文件末尾不完整或损坏的数据跳过并计数
+ * 2. map：--threads 个线程（含主线程）以原子计数器领取块，用 TelemetryAggregator 累加到各自的汇总，线程之间不共享写入
+ * 3. reduce：主线程合并各线程的汇总，写出 levels.csv（每个关卡的漏斗、撤销率、平均值）
+ *    和 dropoff.csv（按结束时操作数的流失点）
+ * 4. 最后输出一行 JSON（文件数、字节数、事件数、线程数、耗时、吞吐）
+ *
+ * 用法：telemetry_aggregator [--out .] [--threads 0] [--chunk 262144] [--repeat 1] telemetry_0.bin...
+ * 返回值：成功为 0，参数或文件错误为 2
+ */
+#include "models/TelemetrySummary.h"
+#include "services/TelemetryAggregator.h"
+#include "services/TelemetryCodec.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string outDir = ".";
+        size_t threads = 0;
+        size_t chunk = 262144;
+        int repeat = 1;
+        std::vector<std::string> files;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--out") == 0 && hasValue) options.outDir = argv[++i];
+            else if (strcmp(argv[i], "--threads") == 0 && hasValue) options.threads = (size_t)atoi(argv[++i]);
+            else if (strcmp(argv[i], "--chunk") == 0 && hasValue) options.chunk = std::max(1, atoi(argv[++i]));
+            else if (strcmp(argv[i], "--repeat") == 0 && hasValue) options.repeat = std::max(1, atoi(argv[++i]));
+            else if (strncmp(argv[i], "--", 2) == 0) return false;
+            else options.files.push_back(argv[i]);
+        }
+        return !options.files.empty();
+    }
+
+    /**
+     * @brief 只读的文件内存映射
+     * @details 页面在第一次访问时才读入，各线程直接在映射上解码，不拷贝文件内容
+     */
+    class MappedFile {
+    public:
+        MappedFile() : _data(nullptr), _size(0) {
+#ifdef _WIN32
+            _file = INVALID_HANDLE_VALUE;
+            _mapping = nullptr;
+#endif
+        }
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (_data) UnmapViewOfFile(_data);
+            if (_mapping) CloseHandle(_mapping);
+            if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+#else
+            if (_data) munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+        }
+
+        // 空文件也算成功（size 为 0）
+        bool open(const std::string& path) {
+#ifdef _WIN32
+            _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (_file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(_file, &size)) return false;
+            _size = (size_t)size.QuadPart;
+            if (_size == 0) return true;
+            _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!_mapping) return false;
+            _data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+            return _data != nullptr;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                close(fd);
+                return false;
+            }
+            _size = (size_t)info.st_size;
+            if (_size == 0) {
+                close(fd);
+                return true;
+            }
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data == MAP_FAILED) return false;
+            madvise(data, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const uint8_t*>(data);
+            return true;
+#endif
+        }
+
+        const uint8_t* data() const { return _data; }
+        size_t size() const { return _size; }
+
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const uint8_t* _data;
+        size_t _size;
+#ifdef _WIN32
+        HANDLE _file;
+        HANDLE _mapping;
+#endif
+    };
+
+    // 一块连续的编码事件（map 阶段的任务单位）
+    struct EventChunk {
+        const uint8_t* data;
+        size_t count;
+    };
+
+    /**
+     * @brief 按批次头把一个文件切成事件块
+     * @return 有效批次之后被跳过的字节数（写入中途退出留下的不完整批次）
+     */
+    size_t splitFile(const MappedFile& file, size_t chunkEvents, std::vector<EventChunk>& chunks) {
+        size_t offset = 0;
+        uint32_t count = 0;
+        while (TelemetryCodec::readBatchHeader(file.data() + offset, file.size() - offset, count)) {
+            const uint8_t* events = file.data() + offset + TelemetryCodec::HEADER_SIZE;
+            for (size_t begin = 0; begin < count; begin += chunkEvents) {
+                EventChunk chunk = { events + begin * TelemetryCodec::EVENT_SIZE, std::min(chunkEvents, count - begin) };
+                chunks.push_back(chunk);
+            }
+            offset += TelemetryCodec::HEADER_SIZE + (size_t)count * TelemetryCodec::EVENT_SIZE;
+        }
+        return file.size() - offset;
+    }
+
+    bool writeText(const std::string& path, const std::string& text) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+        return fclose(file) == 0 && ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: telemetry_aggregator [--out dir] [--threads n] [--chunk events] [--repeat n] telemetry.bin...\n");
+        return 2;
+    }
+    size_t threadCount = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+
+    // ========== 映射文件，切分事件块 ==========
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<EventChunk> chunks;
+    uint64_t totalBytes = 0;
+    uint64_t skippedBytes = 0;
+    for (const auto& path : options.files) {
+        std::unique_ptr<MappedFile> file(new MappedFile());
+        if (!file->open(path)) {
+            fprintf(stderr, "telemetry_aggregator: cannot map %s\n", path.c_str());
+            return 2;
+        }
+        size_t skipped = splitFile(*file, options.chunk, chunks);
+        if (skipped) fprintf(stderr, "telemetry_aggregator: %s: skipped %zu trailing bytes\n", path.c_str(), skipped);
+        totalBytes += file->size();
+        skippedBytes += skipped;
+        files.push_back(std::move(file));
+    }
+
+    // --repeat 把输入重复多遍，用于测量吞吐
+    // 按下标拷贝：insert 的源区间不能来自 chunks 本身
+    size_t uniqueChunks = chunks.size();
+    chunks.reserve(uniqueChunks * options.repeat);
+    for (int r = 1; r < options.repeat; ++r) {
+        for (size_t i = 0; i < uniqueChunks; ++i) chunks.push_back(chunks[i]);
+    }
+    // 输出中的字节数都按处理量计算（含重复）
+    totalBytes *= (uint64_t)options.repeat;
+    skippedBytes *= (uint64_t)options.repeat;
+
+    // ========== map：各线程领取事件块，累加到自己的汇总 ==========
+    std::vector<TelemetrySummary> partials(threadCount);
+    std::atomic<size_t> nextChunk(0);
+    auto mapWorker = [&chunks, &nextChunk, &partials](size_t index) {
+        TelemetrySummary& summary = partials[index];
+        for (size_t i = nextChunk.fetch_add(1); i < chunks.size(); i = nextChunk.fetch_add(1)) {
+            TelemetryAggregator::accumulateEvents(chunks[i].data, chunks[i].count, summary);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) workers.push_back(std::thread(mapWorker, i));
+    mapWorker(0);
+    for (auto& worker : workers) worker.join();
+
+    // ========== reduce：合并各线程的汇总 ==========
+    TelemetrySummary summary;
+    for (const auto& partial : partials) TelemetryAggregator::merge(partial, summary);
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // ========== 输出 ==========
+    std::string levelsPath = options.outDir + "/levels.csv";
+    std::string dropoffPath = options.outDir + "/dropoff.csv";
+    if (!writeText(levelsPath, TelemetryAggregator::levelsCsv(summary))
+        || !writeText(dropoffPath, TelemetryAggregator::dropoffCsv(summary))) {
+        fprintf(stderr, "telemetry_aggregator: cannot write %s or %s\n", levelsPath.c_str(), dropoffPath.c_str());
+        return 2;
+    }
+
+    printf("{\"files\":%u,\"bytes\":%llu,\"skipped_bytes\":%llu,\"events\":%llu,\"unknown_events\":%llu,\"levels\":%u,\"threads\":%u",
+        (unsigned)files.size(), (unsigned long long)totalBytes, (unsigned long long)skippedBytes,
+        (unsigned long long)summary.events, (unsigned long long)summary.unknownEvents,
+        (unsigned)summary.levels.size(), (unsigned)threadCount);
+    printf(",\"ms\":%.3f,\"mb_per_sec\":%.1f,\"events_per_sec\":%.0f}\n", elapsedMs,
+        elapsedMs > 0.0 ? totalBytes / 1048576.0 * 1000.0 / elapsedMs : 0.0,
+        elapsedMs > 0.0 ? summary.events * 1000.0 / elapsedMs : 0.0);
+
+    return 0;
+}